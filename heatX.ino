@@ -7,6 +7,33 @@
  *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Sensor handling moved to `SensorSupervisor`, heater off without valid data
+ * - **2026-10-19**: Two BME280 sensors fused by `SensorFusion`
+ * - **2026-10-19**: Sensor sampling profile follows the control phase
+ * - **2026-10-19**: Fixed-point measurement path, rounding only for the LCD
+ * - **2026-10-19**: Material presets read from the flash table, no name copy at startup
+ * - **2026-10-19**: User presets loaded by `PresetStore` from the FAT partition
+ * - **2026-10-19**: Settings and run state kept in NVS, interrupted runs resume; serial console
+ * - **2026-10-19**: Run history recorded in PSRAM, exported by the `history` command
+ * - **2026-10-19**: Every run logged in full resolution by `RunLogger`
+ * - **2026-10-19**: Binary telemetry replaces the text output of the control loop
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ * - **2026-10-19**: Trace spans and `trace` command replace the logic analyzer pins
+ * - **2026-10-19**: Loop, PID and I2C latency histograms, `latency` command and telemetry
+ * - **2026-10-19**: Memory monitor and `memory` command, loop stack size from the configuration
+ * - **2026-10-19**: Heater control moved to `HeatingController`, shared with the host simulation
+ * - **2026-10-19**: Inputs recorded by `InputCapture` for the host replayer, run timing in `RunTimer`
+ * - **2026-10-19**: I2C bus started by `I2cBus` before the LCD, `i2c` command
+ * - **2026-10-19**: I2C error counters in the telemetry
+ * - **2026-10-19**: Status colors on the backlight by `BacklightAnimator`, no blocking delays in the loop
+ * - **2026-10-19**: LED and buzzer alerts by `Notifier` for a finished run, an open door and faults
+ * - **2026-10-19**: Icons cached by `LcdGlyphManager` without setup delays, graph pages with sparklines and bargraphs
+ * - **2026-10-19**: Material menu names served by `PresetNameList` in the index space of `PresetStore`
+ * - **2026-10-19**: PID input taken from the filter state in °C
+ * - **2026-10-19**: Control telemetry at the fixed rate `_TELEMETRY_CONTROL_INTERVAL` instead of per sample
+ * - **2026-10-19**: Heater PWM on the fixed LEDC channel `_PWM_CHANNEL`
+ * - **2026-10-19**: `history` export streamed one chunk per loop pass by `exportHistory()`
+ * - **2026-10-19**: `trace` dump streamed from the loop by `Tracer::update()`
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -18,28 +45,51 @@
  * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
  */
 
+#include <FFat.h>
+#include <SD.h>
 #include <SimpleRotary.h>
 // #include "src/Waveshare_LCD1602_RGB.h"
 #include "src/LiquidCrystal_AIP31068_I2C.h"
 
 
+#include "src/backlight_hx.h"
+#include "src/capture_hx.h"
+#include "src/console_hx.h"
 #include "src/globals_hx.h"
 #include "src/gpio_hx.h"
 #include "src/heating_hx.h"
+#include "src/history_hx.h"
+#include "src/i2c_bus_hx.h"
+#include "src/latency_hx.h"
 #include "src/lcd_hx.h"
+#include "src/log_hx.h"
+#include "src/memory_hx.h"
+#include "src/notify_hx.h"
 #include "src/pid_hx.h"
+#include "src/preset_hx.h"
+#include "src/runlog_hx.h"
 #include "src/sensor_hx.h"
+#include "src/settings_hx.h"
+#include "src/telemetry_hx.h"
+#include "src/trace_hx.h"
 
-SET_LOOP_TASK_STACK_SIZE(16 * 1024);  ///< Set loop task stack size to 16 KB
+SET_LOOP_TASK_STACK_SIZE(_LOOP_TASK_STACK);  ///< Set loop task stack size, see `Memory_Config`
 
 
+/* ============================================================================================= */
+// I2C
+/* ============================================================================================= */
+void setupI2c();
+
 /* ============================================================================================= */
 // LCD
 /* ============================================================================================= */
 void setupLcd();
-void createLcdSymbol();
 void setStaticHomeContent();
 void updateHomeContent();
+void updateGraphContent();
+void updateLcdPage();
+void updateBacklight();
 
 void callbackMaterialPreset(uint8_t pos);
 void callbackTargetHeatTemp(int pos);
@@ -60,9 +110,66 @@ void checkHeatSensorStatus();
 // HEATING
 /* ============================================================================================= */
 void setupHeating();
-void controlHeating();
+bool controlHeating();
 void controlFan(bool powerOn);
 void setCountdownHeatTime();
+void updateRunState();
+
+/* ============================================================================================= */
+// HISTORY
+/* ============================================================================================= */
+void setupHistory();
+void recordHistory();
+void exportHistory();
+int32_t heatingDuty();
+
+/* ============================================================================================= */
+// RUN LOG
+/* ============================================================================================= */
+void setupRunLog();
+void recordRunLog();
+
+/* ============================================================================================= */
+// TELEMETRY
+/* ============================================================================================= */
+void setupTelemetry();
+void sendTelemetry();
+
+/* ============================================================================================= */
+// SETTINGS
+/* ============================================================================================= */
+void setupSettings();
+Settings collectSettings();
+void applySettings(const Settings &settings);
+
+/* ============================================================================================= */
+// LOGGER
+/* ============================================================================================= */
+void setupLog();
+
+/* ============================================================================================= */
+// INPUT CAPTURE
+/* ============================================================================================= */
+void setupCapture();
+
+/* ============================================================================================= */
+// NOTIFICATIONS
+/* ============================================================================================= */
+void setupNotify();
+void updateNotifications();
+
+/* ============================================================================================= */
+// CONSOLE
+/* ============================================================================================= */
+void commandSettings(const char *args);
+void commandHistory(const char *args);
+void commandRunLog(const char *args);
+void commandCapture(const char *args);
+void commandTelemetry(const char *args);
+void commandTrace(const char *args);
+void commandLatency(const char *args);
+void commandMemory(const char *args);
+void commandI2c(const char *args);
 
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~-~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 //
@@ -75,6 +182,10 @@ void setCountdownHeatTime();
 /* ============================================================================================= */
 // Waveshare_LCD1602_RGB lcd(_LCD_COLS, _LCD_ROWS);
 LiquidCrystal_AIP31068_I2C lcd(_LCD_ADDRESS, _LCD_COLS, _LCD_ROWS);
+LcdGlyphManager glyphs(lcd);
+enumLcdPage lcdPage = LCD_PAGE_HOME;
+unsigned long lcdPageMillis = 0;
+BacklightAnimator backlight(lcd);
 
 /* ============================================================================================= */
 // BUTTON
@@ -90,13 +201,82 @@ SimpleRotary encoder(_PIN_ENC_CLK, _PIN_ENC_DT, _PIN_ENC_BUTTON);
 /* ============================================================================================= */
 // TEMPERATURE SENSOR (BME280)
 /* ============================================================================================= */
-CustomBME280 bme;
+CustomBME280 bmeSpool;
+CustomBME280 bmeOutlet;
+const uint8_t spoolSensorAddress[] = { _TEMPSENSOR_I2C_ADDRESS_1 };
+const uint8_t outletSensorAddress[] = { _TEMPSENSOR_I2C_ADDRESS_2 };
+SensorSupervisor spoolSensor(bmeSpool, spoolSensorAddress, sizeof(spoolSensorAddress));
+SensorSupervisor outletSensor(bmeOutlet, outletSensorAddress, sizeof(outletSensorAddress));
+SensorSupervisor *const sensorSupervisors[] = { &spoolSensor, &outletSensor };
+const float sensorVariances[] = { _SENSOR_1_VARIANCE, _SENSOR_2_VARIANCE };
+SensorFusion sensorFusion(sensorSupervisors, sensorVariances, 2, _KALMAN_PROCESS_NOISE);
+SensorProfileManager sensorProfileManager(sensorFusion);
 
 /* ============================================================================================= */
 // HEATING
 /* ============================================================================================= */
 GpioOffDelay fan(_PIN_FAN, _FAN_OFFDELAY);
 GpioOffDelay fanHeat(_PIN_FAN_HEAT, _FAN_HEAT_OFFDELAY);
+RunTimer runTimer;
+bool runFinished = false;  ///< The last run reached its target time, shown until the next start
+
+/* ============================================================================================= */
+// MATERIAL PRESETS
+/* ============================================================================================= */
+PresetStore presetStore;
+PresetNameList materialNames{ presetStore };  ///< Menu item list, same index as `callbackMaterialPreset()`
+
+/* ============================================================================================= */
+// SETTINGS
+/* ============================================================================================= */
+SettingsStore settingsStore;
+
+/* ============================================================================================= */
+// HISTORY
+/* ============================================================================================= */
+HistoryStore history;
+enumHistoryTier historyExportTier = HISTORY_1S;  ///< Tier of the running `history` export
+uint32_t historyExportFrom = 0;                  ///< Time of the next point to export (s)
+bool historyExporting = false;                   ///< A `history` export is streamed by `exportHistory()`
+
+/* ============================================================================================= */
+// RUN LOG
+/* ============================================================================================= */
+RunLogger runLog;
+
+/* ============================================================================================= */
+// TELEMETRY
+/* ============================================================================================= */
+Telemetry telemetry;
+
+/* ============================================================================================= */
+// MEMORY
+/* ============================================================================================= */
+MemoryMonitor memoryMonitor;
+
+/* ============================================================================================= */
+// NOTIFICATIONS
+/* ============================================================================================= */
+Notifier notifier(_PIN_RGB_LED, _PIN_BUZZER);
+bool faultNotified = false;  ///< The current fault was announced
+bool doorArmed = false;      ///< The run reached the hold phase, a large drop means an open door
+bool doorNotified = false;   ///< The current drop was announced
+
+/* ============================================================================================= */
+// CONSOLE
+/* ============================================================================================= */
+const ConsoleCommand consoleCommands[] = {
+  { "settings", commandSettings, "Prints the settings as JSON, \"settings set {...}\" imports them" },
+  { "history", commandHistory, "Prints the history as CSV: history <1s|1m|15m> [minutes]" },
+  { "runlog", commandRunLog, "Prints the state of the run log" },
+  { "capture", commandCapture, "Prints the state of the input capture" },
+  { "telemetry", commandTelemetry, "Switches the binary telemetry: telemetry [on|off]" },
+  { "trace", commandTrace, "Prints the recorded trace events and clears them" },
+  { "latency", commandLatency, "Prints the latency percentiles, \"latency reset\" clears them" },
+  { "memory", commandMemory, "Prints the stack high-water marks, the heaps and the allocations after setup" },
+  { "i2c", commandI2c, "Prints the bus utilization per I2C device, \"i2c reset\" clears it" },
+};
+SerialConsole console(consoleCommands, sizeof(consoleCommands) / sizeof(consoleCommands[0]));
 
 /* ============================================================================================= */
 // PID CONTROLLER
@@ -119,139 +299,49 @@ PID_heatX pidFan(
   _PID_FAN_KD_PRESET,  // Derivative gain for fan speed PID
   0);                  // 0 = Direct control
 
+HeatingController heatingController(pidHeating, fan, fanHeat, _PIN_HEAT);
+
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~-~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 //
 //                                    🔧 SETUP FUNCTIONS 🔧
 //
 /* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
-void createLcdSymbol() {
-  // Note: Symbols 0 and 1 are reserved for LcdMenu.
-
-  // Degree Symbol
-  uint8_t degreeSymbol[8] = {
-    0b00111,
-    0b00101,
-    0b00111,
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000
-  };
-  lcd.createChar(2, degreeSymbol);
-  delay(_SETUP_DELAY);
-
-  // Temperature Symbol (Thermometer)
-  uint8_t tempSymbol[8] = {
-    0b00100,
-    0b01010,
-    0b01010,
-    0b01010,
-    0b01110,
-    0b11111,
-    0b01110,
-    0b00000
-  };
-  lcd.createChar(3, tempSymbol);
-  delay(_SETUP_DELAY);
-
-  // Humidity Symbol (Droplet)
-  uint8_t humiditySymbol[8] = {
-    0b00100,
-    0b00100,
-    0b01110,
-    0b11111,
-    0b11111,
-    0b01110,
-    0b00000,
-    0b00000
-  };
-  lcd.createChar(4, humiditySymbol);
-  delay(_SETUP_DELAY);
-
-  // Time Symbol (Clock)
-  uint8_t timeSymbol[8] = {
-    0b01110,
-    0b10001,
-    0b10101,
-    0b10101,
-    0b10001,
-    0b01110,
-    0b00000,
-    0b00000
-  };
-  lcd.createChar(5, timeSymbol);
-  delay(_SETUP_DELAY);
-
-  // Mode Symbol (Alternative Design)
-  uint8_t modeSymbol[8] = {
-    0b00100,
-    0b01010,
-    0b11111,
-    0b01110,
-    0b01110,
-    0b11111,
-    0b01010,
-    0b00100
-  };
-  lcd.createChar(6, modeSymbol);
-  delay(_SETUP_DELAY);
-
-  // Free Slot Placeholder (Empty)
-  uint8_t freeSymbol[8] = {
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000,
-    0b00000
-  };
-  lcd.createChar(7, freeSymbol);
-  delay(_SETUP_DELAY);
+void setupI2c() {
+  // Display writes are queued from here on, sensor reads take the bus ahead of them
+  i2cBus.begin();
 }
 
 void setupLcd() {
-  // Copy material names to the array
-  for (size_t i = 0; i < _MATERIAL_COUNT; ++i) {
-    materialNames[i] = materialPresets[i].name;
-  }
-
   lcd.init();
+  backlight.begin();
 
-  createLcdSymbol();
   setStaticHomeContent();
   updateHomeContent();
 }
 
-void setupHeatSensor() {
-  int attempts = 0;
-  int allowedAttempts = 3;
+void setupLog() {
+  // Records logged before this point are kept in the ring and printed now
+  logger.begin(Serial);
+}
 
-  while (!bme.begin(_TEMPSENSOR_I2C_ADDRESS_1, &Wire) && attempts < allowedAttempts) {
-    Serial.println("Not find BMx280");
-    delay(1000);
-    attempts++;
-  }
-  if (attempts >= allowedAttempts) {
-    Serial.println("BMx280 error");
-    delay(5000);
-    return;
-  }
-  delay(_SETUP_DELAY);
-  bme.setSampling(Adafruit_BME280::MODE_NORMAL,
-                  Adafruit_BME280::SAMPLING_X4,  // temperature
-                  Adafruit_BME280::SAMPLING_X4,  // pressure
-                  Adafruit_BME280::SAMPLING_X4,  // humidity
-                  Adafruit_BME280::FILTER_X16,
-                  Adafruit_BME280::STANDBY_MS_125);
+void setupCapture() {
+  // FFat is mounted by the preset store; the sensors are probed in the boot pass started here
+  inputCapture.begin(FFat);
+}
 
+void setupNotify() {
+  // Alerts are played by their own task, the loop only queues them
+  notifier.begin();
+}
+
+void setupHeatSensor() {
+  // Missing sensors are picked up later by their supervisors in the background
+  sensorFusion.begin();
   delay(_SETUP_DELAY);
 }
 
 void setupHeating() {
-  ledcAttach(_PIN_HEAT, _PWM_FREQUENCY, _PWM_RESOLUTION);
+  ledcAttachChannel(_PIN_HEAT, _PWM_FREQUENCY, _PWM_RESOLUTION, _PWM_CHANNEL);  // Timer 0, see Notify_Config
 
   pidHeating.SetOutputLimits(0, _PWM_MAX_VALUE);
   pidHeating.SetSetpoint(_TEMP_PRESET);
@@ -259,54 +349,110 @@ void setupHeating() {
   // pidHeating.SetProportionalMode(0.0);  // Enable proportional on measurement
 }
 
+void setupSettings() {
+  // Tunings are applied after the sample time is set, SetTunings() scales them with it
+  settingsStore.begin();
+  applySettings(settingsStore.get());
+  if (runState.running) {
+    HX_LOG_INFO("Resuming run after %u s", (unsigned)runState.elapsedSeconds);
+  }
+}
+
+void setupHistory() {
+  if (!history.begin()) {
+    HX_LOG_WARN("History: disabled");
+  }
+}
+
+void setupRunLog() {
+#ifdef _RUNLOG_SD
+  SPI.begin(_PIN_SPI2_CLK, _PIN_SPI2_MISO, _PIN_SPI2_MOSI, _PIN_SPI2_CS);
+  if (!SD.begin(_PIN_SPI2_CS, SPI)) {
+    HX_LOG_ERROR("Run log: no SD card");
+    return;
+  }
+  runLog.begin(SD);
+#else
+  // FFat is mounted by the preset store
+  runLog.begin(FFat);
+#endif
+}
+
+void setupTelemetry() {
+  telemetry.begin(Serial);
+#ifdef _TELEMETRY_AUTOSTART
+  telemetry.setEnabled(true);
+#endif
+}
+
 void setup() {
+  setupI2c();
   setupLcd();
   setupSerial();
-  setupDebug();
+  setupLog();
+  setupNotify();
+  presetStore.begin();
+  setupCapture();
   setupHeatSensor();
   setupHeating();
+  setupSettings();
+  setupHistory();
+  setupRunLog();
+  setupTelemetry();
+  memoryMonitor.markSetupDone();  // No allocations from here on
 }
 
 void setStaticHomeContent() {
+  // Icons are uploaded before the cursor is set; the cached ones cost no bus traffic
+  glyphs.beginFrame();
+  uint8_t temperatureSymbol = glyphs.acquire(lcdIconTemperature);
+  uint8_t degreeSymbol = glyphs.acquire(lcdIconDegree);
+  uint8_t humiditySymbol = glyphs.acquire(lcdIconHumidity);
+  uint8_t timeSymbol = glyphs.acquire(lcdIconTime);
 
   // Temp actuel / target
   lcd.setCursor(0, 0);
-  lcd.write(byte(3));  // Temperature Symbol
+  lcd.write(temperatureSymbol);
   lcd.print("   /   C");
-  lcd.write(byte(2));  // Degree Symbol
+  lcd.write(degreeSymbol);
 
   // Hum actuel / target
   lcd.setCursor((_LCD_COLS - 4), 0);
-  lcd.write(byte(4));  // Humidity Symbol
+  lcd.write(humiditySymbol);
   lcd.print("  %");
 
   // Heating mode
   lcd.setCursor(0, 1);
-  // lcd.write(byte(6));  // Mode Symbol
+  // lcd.write(glyphs.acquire(lcdIconMode));  // Mode Symbol
   lcd.print("Box Heat");
 
   // Countdown time actual
   lcd.setCursor((_LCD_COLS - 7), 1);
-  lcd.write(byte(5));  // Time Symbol
+  lcd.write(timeSymbol);
   lcd.print("  :  s");
 }
 
 void updateHomeContent() {
+  if (lcdPage != LCD_PAGE_HOME) {
+    return;
+  }
+  HX_TRACE_SCOPE(TRACE_LCD);
+
   // Temp actual
   lcd.setCursor(1, 0);
-  lcd.printf("%3d", actualHeatingValue.temperature);
+  lcd.printf("%3d", centiToInt(actualHeatingValue.temperature));
 
   // Temp target
   lcd.setCursor(5, 0);
-  lcd.printf("%3d", targetHeatingValue.temperature);
+  lcd.printf("%3d", centiToInt(targetHeatingValue.temperature));
 
   // Hum actual
   lcd.setCursor((_LCD_COLS - 3), 0);
-  lcd.printf("%2d", actualHeatingValue.humidity);
+  lcd.printf("%2d", centiToInt(actualHeatingValue.humidity));
 
   // Hum target
   // lcd.setCursor(13, 0);
-  // lcd.printf("%2d", targetHeatingValue.humidity);
+  // lcd.printf("%2d", centiToInt(targetHeatingValue.humidity));
 
   // Countdown heat time actual
   setCountdownHeatTime();
@@ -316,94 +462,401 @@ void updateHomeContent() {
   lcd.printf("%2d", actualCountdown.minutes);
 }
 
+void updateGraphContent() {
+  if (lcdPage == LCD_PAGE_HOME) {
+    return;
+  }
+  HX_TRACE_SCOPE(TRACE_LCD);
+  enumHistoryChannel channel = lcdPage == LCD_PAGE_TEMPERATURE ? HISTORY_TEMPERATURE : HISTORY_HUMIDITY;
+
+  // The last closed 1 min points, five per character
+  HistoryPoint points[_LCD_SPARKLINE_CELLS * 5];
+  uint32_t now = millis() / 1000;
+  uint32_t span = history.getResolution(HISTORY_1MIN) * (_LCD_SPARKLINE_CELLS * 5);
+  size_t count = history.query(HISTORY_1MIN, now > span ? now - span : 0, UINT32_MAX, points, _LCD_SPARKLINE_CELLS * 5);
+  int16_t values[_LCD_SPARKLINE_CELLS * 5];
+  int16_t low = INT16_MAX;
+  int16_t high = INT16_MIN;
+  for (size_t i = 0; i < count; i++) {
+    values[i] = points[i].values[channel].mean;
+    low = values[i] < low ? values[i] : low;
+    high = values[i] > high ? values[i] : high;
+  }
+  int32_t fanDuty = count ? points[count - 1].values[HISTORY_FAN].mean : (fanHeat.isOn() ? 100 * _CENTI : 0);
+
+  // Every custom cell is redrawn, so the glyphs of the last frame may be replaced
+  glyphs.beginFrame();
+  lcd.setCursor(0, 0);
+  lcd.write(channel == HISTORY_TEMPERATURE ? 'T' : 'H');
+  glyphs.drawSparkline(1, 0, _LCD_SPARKLINE_CELLS, values, count, low, high);
+  lcd.setCursor(1 + _LCD_SPARKLINE_CELLS, 0);
+  if (count) {
+    lcd.printf(" %3d..%-3d%c", centiToInt(low), centiToInt(high), channel == HISTORY_TEMPERATURE ? 'C' : '%');
+  }
+
+  lcd.setCursor(0, 1);
+  lcd.write('P');
+  glyphs.drawBar(1, 1, _LCD_BAR_CELLS, heatingDuty(), 100 * _CENTI);
+  lcd.setCursor(1 + _LCD_BAR_CELLS, 1);
+  lcd.print(" F");
+  glyphs.drawBar(3 + _LCD_BAR_CELLS, 1, _LCD_BAR_CELLS, fanDuty, 100 * _CENTI);
+}
+
+void updateLcdPage() {
+  unsigned long now = loopMillis();
+  if (now - lcdPageMillis < _LCD_PAGE_TIME) {
+    return;
+  }
+  lcdPageMillis = now;
+  lcdPage = (enumLcdPage)((lcdPage + 1) % LCD_PAGE_COUNT);
+  lcd.clear();
+  if (lcdPage == LCD_PAGE_HOME) {
+    setStaticHomeContent();
+    updateHomeContent();
+  } else {
+    updateGraphContent();
+  }
+}
+
 void setCountdownHeatTime() {
-  actualCountdown.hours = targetCountdown.hours;
-  actualCountdown.minutes = 0;
+  uint32_t targetSeconds = (targetCountdown.hours * 60UL + targetCountdown.minutes) * 60UL;
+  uint32_t remainingSeconds = targetSeconds;
+  if (runState.running) {
+    remainingSeconds = (runState.elapsedSeconds < targetSeconds) ? targetSeconds - runState.elapsedSeconds : 0;
+  }
+  actualCountdown.hours = remainingSeconds / 3600;
+  actualCountdown.minutes = (remainingSeconds / 60) % 60;
+}
+
+void updateRunState() {
+  uint32_t targetSeconds = (targetCountdown.hours * 60UL + targetCountdown.minutes) * 60UL;
+  bool start = buttonStart.isPressed();
+  bool stop = buttonStop.isPressed();
+  if (runTimer.update(runState, start, stop, sensorFusion.isActive(), targetSeconds)) {
+    HX_LOG_INFO("Run finished");
+    runFinished = true;
+    notifier.notify(NOTIFY_RUN_FINISHED);
+  } else if (runState.running) {
+    runFinished = false;
+  }
+}
+
+void updateBacklight() {
+  if (!sensorFusion.isActive() || i2cBus.isFaulted()) {
+    backlight.setState(BACKLIGHT_FAULT);
+  } else if (runState.running) {
+    backlight.setState(sensorProfileManager.getProfile() == PROFILE_HOLD ? BACKLIGHT_HOLDING : BACKLIGHT_HEATING);
+  } else {
+    backlight.setState(runFinished ? BACKLIGHT_DONE : BACKLIGHT_IDLE);
+  }
+  backlight.update();
+}
+
+void updateNotifications() {
+  bool fault = !sensorFusion.isActive() || i2cBus.isFaulted();
+  if (fault && !faultNotified) {
+    notifier.notify(NOTIFY_FAULT);
+  }
+  faultNotified = fault;
+
+  // There is no door switch: a drop far below the setpoint after the hold phase was reached
+  if (!runState.running) {
+    doorArmed = false;
+  } else if (sensorProfileManager.getProfile() == PROFILE_HOLD) {
+    doorArmed = true;
+  }
+  int32_t drop = targetHeatingValue.temperature - actualHeatingValue.temperature;
+  if (doorArmed && !fault && drop > _NOTIFY_DOOR_DROP && !doorNotified) {
+    notifier.notify(NOTIFY_DOOR_OPEN);
+    doorNotified = true;
+  } else if (drop <= _PROFILE_HOLD_BAND) {
+    doorNotified = false;
+  }
 }
 
 void checkHeatSensorStatus() {
-  static unsigned long lastMillis;
-  unsigned long currentMillis;
-  static int sensorIsMeasuring;
-  static int lastSensorMeasuringState;
-  uint8_t status;
-
-  currentMillis = millis();
-  if (currentMillis - lastMillis >= 5) {
-    lastMillis = currentMillis;
-
-    uint8_t status = bme.readRegister(BME280_REGISTER_STATUS);
-    sensorIsMeasuring = status & 0x08;  // Bit 3: Measuring
-    digitalWrite(_PIN_DEBUG_CH4, sensorIsMeasuring);
-    if (sensorIsMeasuring == !lastSensorMeasuringState) {
-
-      digitalWrite(_PIN_DEBUG_CH5, HIGH);
-
-      actualHeatingValue.temperature = bme.readTemperature();
-      actualHeatingValue.humidity = bme.readHumidity();
-      updateHomeContent();
-
-      pidHeating.SetInput(actualHeatingValue.temperature);
-      pidHeating.SetInput(map(analogRead(_PIN_DEBUG_POTI), 0, 4095, _TEMP_MIN, _TEMP_MAX));
-      pidHeating.SetSetpoint(targetHeatingValue.temperature);
-      // Serial.printf("Poti: %d\n", (analogRead(_PIN_DEBUG_POTI)));
-      controlHeating();
-
-      digitalWrite(_PIN_DEBUG_CH5, LOW);
+  uint32_t sampleMicros = micros();
+  bool updated;
+  {
+    HX_TRACE_SCOPE(TRACE_FUSION);
+    updated = sensorFusion.update();
+  }
+  if (updated) {
+    HX_TRACE_SCOPE(TRACE_CONTROL);
+
+    actualHeatingValue.temperature = sensorFusion.getData().temperature;
+    actualHeatingValue.humidity = sensorFusion.getData().humidity;
+    updateHomeContent();
+    updateGraphContent();
+
+    sensorProfileManager.update(targetHeatingValue.temperature, sensorFusion.getData().temperature);
+
+    heatingController.setInput(sensorFusion.getTemperature(), sensorFusion.getTemperatureRate(),
+                               targetHeatingValue.temperature);
+#ifdef _DEBUG_POTI_INPUT
+    pidHeating.SetInput(map(readInputAnalog(_PIN_DEBUG_POTI), 0, 4095, _TEMP_MIN, _TEMP_MAX));
+#endif
+    // Serial.printf("Poti: %d\n", (analogRead(_PIN_DEBUG_POTI)));
+    if (controlHeating()) {
+      latency.record(LATENCY_OUTPUT, micros() - sampleMicros);
     }
-    lastSensorMeasuringState = sensorIsMeasuring;
+    recordHistory();
+    recordRunLog();
+  } else if (!sensorFusion.isActive()) {
+    controlHeating();  // No valid data: keep the heater in its safe state
+  }
+}
+
+bool controlHeating() {
+  bool written;
+  {
+    HX_TRACE_SCOPE(TRACE_PID);
+    written = heatingController.control(runState.running && sensorFusion.isActive());
+  }
+
+  if (written) {
+    // The PID runs on the first sample after its sample time, one sensor period later is still on time
+    uint32_t deadline = (pidHeating.GetSampleTime() + sensorProfiles[sensorProfileManager.getProfile()].samplePeriod) * 1000UL;
+    latency.recordPeriod(LATENCY_PID, micros(), deadline);
+  } else if (!heatingController.isEnabled()) {
+    latency.restart(LATENCY_PID);
+  }
+  return written;
+}
+
+int32_t heatingDuty() {
+  return heatingController.getDuty();
+}
+
+void recordHistory() {
+  int16_t sample[HISTORY_CHANNEL_COUNT];
+  sample[HISTORY_TEMPERATURE] = actualHeatingValue.temperature;
+  sample[HISTORY_HUMIDITY] = actualHeatingValue.humidity;
+  sample[HISTORY_DUTY] = heatingDuty();
+  sample[HISTORY_SETPOINT] = targetHeatingValue.temperature;
+  sample[HISTORY_FAN] = fanHeat.isOn() ? 100 * _CENTI : 0;
+  history.add(millis() / 1000, sample);
+}
+
+void recordRunLog() {
+  if (runState.running && !runLog.isRunning()) {
+    runLog.startRun();
+  } else if (!runState.running && runLog.isRunning()) {
+    runLog.stopRun();
   }
+  runLog.add({ (uint32_t)millis(),
+               (int16_t)actualHeatingValue.temperature,
+               (int16_t)actualHeatingValue.humidity,
+               (uint16_t)heatingDuty(),
+               (uint8_t)sensorProfileManager.getProfile() });
 }
 
-void controlHeating() {
-  static int iHeaderCounter;
-  static int HeatingRunning;
-  bool HeatingIsOn;
+void sendTelemetry() {
+  // The control message runs on a fixed grid independent of the sensor profile; between two
+  // samples it repeats the last estimate with its time, a late pass catches up on the grid
+  static unsigned long lastControlMillis = 0;
+  unsigned long now = millis();
+  if (!telemetry.isEnabled() || now - lastControlMillis < _TELEMETRY_CONTROL_INTERVAL) {
+    return;
+  }
+  lastControlMillis = now - lastControlMillis < 2 * _TELEMETRY_CONTROL_INTERVAL
+                        ? lastControlMillis + _TELEMETRY_CONTROL_INTERVAL
+                        : now;
+
+  uint8_t flags = 0;
+  if (runState.running) flags |= TELEMETRY_FLAG_RUNNING;
+  if (runState.running && sensorFusion.isActive()) flags |= TELEMETRY_FLAG_HEATING;
+  if (fanHeat.isOn()) flags |= TELEMETRY_FLAG_FAN;
+  if (sensorFusion.isActive()) flags |= TELEMETRY_FLAG_SENSOR;
+
+  TelemetryControl message = {
+    (uint32_t)now,
+    (int16_t)targetHeatingValue.temperature,
+    (int16_t)actualHeatingValue.temperature,
+    (int16_t)sensorFusion.getRate(),
+    (int16_t)actualHeatingValue.humidity,
+    (uint16_t)heatingDuty(),
+    flags,
+    (uint8_t)sensorProfileManager.getProfile()
+  };
+  telemetry.send(TELEMETRY_CONTROL, &message, sizeof(message));
+
+  // One latency channel per interval keeps the telemetry load constant
+  static unsigned long lastLatencyMillis = 0;
+  static uint8_t latencyChannel = 0;
+  if (millis() - lastLatencyMillis >= _LATENCY_TELEMETRY_INTERVAL) {
+    lastLatencyMillis = millis();
+    TelemetryLatency statistics;
+    latency.fill((enumLatencyChannel)latencyChannel, statistics);
+    telemetry.send(TELEMETRY_LATENCY, &statistics, sizeof(statistics));
+    latencyChannel = (latencyChannel + 1) % LATENCY_COUNT;
+  }
 
-  HeatingIsOn = (pidHeating.GetOutput() > 0.0);
-  if (buttonStart.isPressed()) {
-    HeatingRunning = 1;
+  static unsigned long lastI2cMillis = 0;
+  static uint8_t i2cDevice = 0;
+  if (millis() - lastI2cMillis >= _I2C_TELEMETRY_INTERVAL) {
+    lastI2cMillis = millis();
+    TelemetryI2c statistics;
+    i2cBus.fill(i2cDevice, statistics);
+    telemetry.send(TELEMETRY_I2C, &statistics, sizeof(statistics));
+    i2cDevice = (i2cDevice + 1) % i2cBus.getDeviceCount();
   }
-  if (buttonStop.isPressed()) {
-    HeatingRunning = 0;
+}
+
+Settings collectSettings() {
+  return {
+    targetHeatingValue,
+    targetCountdown,
+    pidHeating.GetKp(),
+    pidHeating.GetKi(),
+    pidHeating.GetKd(),
+    runState
+  };
+}
+
+void applySettings(const Settings &settings) {
+  targetHeatingValue = settings.target;
+  targetCountdown = settings.countdown;
+  pidHeating.SetTunings(settings.kp, settings.ki, settings.kd);
+  runState = settings.run;
+  updateHomeContent();
+}
+
+// Console commands
+void commandSettings(const char *args) {
+  if (args[0] == '\0') {
+    settingsStore.exportJson(Serial);
+  } else if (strncmp(args, "set ", 4) == 0) {
+    Settings settings = collectSettings();
+    if (SettingsStore::importJson(args + 4, settings)) {
+      applySettings(settings);
+      Serial.println("Settings applied");
+    }
+  } else {
+    Serial.println("Usage: settings [set {json}]");
   }
-  if (HeatingRunning) {
-    pidHeating.SetMode(1);  // 1 = Automatic --> On
+}
 
-    if (pidHeating.Compute()) {
-      digitalWrite(_PIN_DEBUG_CH6, HIGH);
-      ledcWrite(_PIN_HEAT, pidHeating.GetOutput());
+void commandHistory(const char *args) {
+  enumHistoryTier tier;
+  if (strncmp(args, "15m", 3) == 0) tier = HISTORY_15MIN;
+  else if (strncmp(args, "1m", 2) == 0) tier = HISTORY_1MIN;
+  else if (strncmp(args, "1s", 2) == 0) tier = HISTORY_1S;
+  else {
+    Serial.println("Usage: history <1s|1m|15m> [minutes]");
+    return;
+  }
 
-      Serial.printf("Set:%.2f In:%.2f Out:%.2f\n",
-                    pidHeating.GetSetpoint(), pidHeating.GetInput(), mapFloat(pidHeating.GetOutput(), 0.0, 4095.0, 0.0, 100.0));
+  // Without a window the whole tier is printed
+  const char *minutes = strchr(args, ' ');
+  uint32_t now = millis() / 1000;
+  uint32_t window = minutes ? strtoul(minutes, nullptr, 10) * 60 : now;
+  uint32_t from = (window < now) ? now - window : 0;
+
+  // The points follow from exportHistory() in the next loop passes; a new export replaces a running one
+  Serial.println("time,temp_min,temp_max,temp_mean,hum_min,hum_max,hum_mean,"
+                 "duty_min,duty_max,duty_mean,set_min,set_max,set_mean,fan_min,fan_max,fan_mean");
+  historyExportTier = tier;
+  historyExportFrom = from;
+  historyExporting = true;
+}
 
-      digitalWrite(_PIN_DEBUG_CH6, LOW);
+void exportHistory() {
+  if (!historyExporting) {
+    return;
+  }
+  HistoryPoint points[_HISTORY_EXPORT_CHUNK];
+  size_t count = history.query(historyExportTier, historyExportFrom, UINT32_MAX, points, _HISTORY_EXPORT_CHUNK);
+  size_t printed = 0;
+  while (printed < count && Serial.availableForWrite() >= _HISTORY_EXPORT_LINE) {
+    const HistoryPoint &point = points[printed++];
+    Serial.printf("%u", (unsigned)point.time);
+    for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+      const HistoryStat &stat = point.values[c];
+      Serial.printf(",%d,%d,%d", stat.min, stat.max, stat.mean);
     }
+    Serial.println();
+    historyExportFrom = point.time + 1;
+  }
+  // A short chunk printed in full reached the newest point
+  if (printed == count && count < _HISTORY_EXPORT_CHUNK) {
+    historyExporting = false;
+  }
+}
+
+void commandRunLog(const char *args) {
+  Serial.printf("Run %u %s, %u bytes written, %u records dropped, %u write errors\n",
+                (unsigned)runLog.getRunId(), runLog.isRunning() ? "running" : "stopped",
+                (unsigned)runLog.getWritten(), (unsigned)runLog.getDropped(), (unsigned)runLog.getWriteErrors());
+  Serial.printf("Log size %u of %u bytes, %u runs deleted\n", (unsigned)runLog.getSize(), (unsigned)_RUNLOG_MAX_SIZE,
+                (unsigned)runLog.getEvicted());
+}
+
+void commandCapture(const char *args) {
+  Serial.printf("Capture %s, segment %u, %u bytes written, %u events dropped, %u write errors\n",
+                inputCapture.isRecording() ? "recording" : "stopped", (unsigned)inputCapture.getSegment(),
+                (unsigned)inputCapture.getWritten(), (unsigned)inputCapture.getDropped(),
+                (unsigned)inputCapture.getWriteErrors());
+}
+
+void commandTelemetry(const char *args) {
+  if (strcmp(args, "on") == 0) {
+    telemetry.setEnabled(true);
+  } else if (strcmp(args, "off") == 0) {
+    telemetry.setEnabled(false);
   } else {
-    ledcWrite(_PIN_HEAT, 0);
-    HeatingIsOn = 0;
-    pidHeating.SetMode(0);  // 0 = Manual --> Off
+    Serial.printf("Telemetry %s, %u frames sent, %u dropped\n", telemetry.isEnabled() ? "on" : "off",
+                  (unsigned)telemetry.getSent(), (unsigned)telemetry.getDropped());
   }
-  fan.control(HeatingIsOn);
-  fanHeat.control(HeatingIsOn);
+}
+
+void commandLatency(const char *args) {
+  if (strcmp(args, "reset") == 0) {
+    latency.reset();
+  } else {
+    latency.print(Serial);
+  }
+}
+
+void commandMemory(const char *args) {
+  memoryMonitor.print(Serial);
+}
+
+void commandI2c(const char *args) {
+  if (strcmp(args, "reset") == 0) {
+    i2cBus.reset();
+  } else {
+    i2cBus.print(Serial);
+  }
+}
+
+void commandTrace(const char *args) {
+#ifdef _TRACE_ENABLED
+  // The events follow from tracer.update() in the next loop passes
+  if (!tracer.startDump(Serial)) {
+    Serial.println("Trace dump running");
+  }
+#else
+  Serial.println("Trace not compiled in, define _TRACE_ENABLED");
+#endif
 }
 
 // LCD callbacks
 void callbackToggle(bool isOn) {
-  Serial.println(isOn);
+  HX_LOG_DEBUG("Toggle: %d", isOn);
 }
 
 void callbackIntRange(int pos) {
-  Serial.println(pos);
+  HX_LOG_DEBUG("Int range: %d", pos);
 }
 
 void callbackTargetHeatTemp(int pos) {
-  targetHeatingValue.temperature = pos;
+  targetHeatingValue.temperature = pos * _CENTI;
   updateHomeContent();
 }
 
 void callbackTargetHeatHum(int pos) {
-  targetHeatingValue.humidity = pos;
+  targetHeatingValue.humidity = pos * _CENTI;
   updateHomeContent();
 }
 
@@ -413,29 +866,44 @@ void callbackTargetHeatTime(int pos) {
 }
 
 void callbackTargetHeatMode(int pos) {
-  Serial.println(pos);
+  HX_LOG_DEBUG("Heat mode: %d", pos);
 }
 
 void callbackMaterialPreset(uint8_t pos) {
   // Check if the index is within the valid range
-  if (pos < (_MATERIAL_COUNT)) {
-    targetHeatingValue.temperature = materialPresets[pos].value;
+  if (pos < presetStore.size()) {
+    MaterialPreset preset = presetStore.get(pos);
+    targetHeatingValue.temperature = preset.temperature * _CENTI;
+    targetHeatingValue.humidity = preset.humidity * _CENTI;
+    targetCountdown.hours = preset.hours;
     updateHomeContent();
-    Serial.printf("New preset temp is: %d\n", materialPresets[pos].value);
+    HX_LOG_INFO("New preset %s temp is: %d", preset.name, preset.temperature);
   } else {
-    Serial.printf("Error: Invalid material preset index: %d\n", pos);
+    HX_LOG_ERROR("Invalid material preset index: %d", pos);
   }
 }
 
 void loop() {
+  inputCapture.beginPass();
+  inputCapture.recordSettings(collectSettings());  // Changed by the console or the menu in the last pass
+  latency.recordPeriod(LATENCY_LOOP, micros());
   buttonStart.update();
   buttonStop.update();
   fan.update();
   fanHeat.update();
+  updateRunState();
   checkHeatSensorStatus();
-
-  delay(5000);
-  lcd.noDisplay();
-  delay(3000);
-  lcd.display();
+  sendTelemetry();
+  settingsStore.update(collectSettings());
+  runLog.update();
+  inputCapture.update();
+  console.update();
+  exportHistory();
+#ifdef _TRACE_ENABLED
+  tracer.update();
+#endif
+  memoryMonitor.update();
+  updateBacklight();
+  updateNotifications();
+  updateLcdPage();
 }
\ No newline at end of file
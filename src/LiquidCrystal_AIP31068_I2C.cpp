@@ -3,21 +3,33 @@
 #include "LiquidCrystal_AIP31068_I2C.h"
 #include <inttypes.h>
 #include <Wire.h>
+#include "i2c_bus_hx.h"
 
 #if defined(ARDUINO) && ARDUINO >= 100
 
 #include "Arduino.h"
 
-#define printIIC(args) Wire.write(args)
 inline size_t LiquidCrystal_AIP31068_I2C::write(uint8_t value) {
   send(value, 1);
   return 1;
 }
 
+// Rs with Co = 0 announces a data stream, so a string costs one transaction per batch instead of one per character
+size_t LiquidCrystal_AIP31068_I2C::write(const uint8_t *buffer, size_t size) {
+  uint8_t batch[_I2C_BATCH_MAX];
+  batch[0] = Rs;
+  for (size_t sent = 0; sent < size;) {
+    uint8_t length = size - sent < _I2C_BATCH_MAX - 1 ? size - sent : _I2C_BATCH_MAX - 1;
+    memcpy(batch + 1, buffer + sent, length);
+    i2cBus.post(_Addr, batch, length + 1);
+    sent += length;
+  }
+  return size;
+}
+
 #else
 #include "WProgram.h"
 
-#define printIIC(args) Wire.send(args)
 inline void LiquidCrystal_AIP31068_I2C::write(uint8_t value) {
   send(value, 1);
 }
@@ -59,7 +71,7 @@ void LiquidCrystal_AIP31068_I2C::init() {
 }
 
 void LiquidCrystal_AIP31068_I2C::init_priv() {
-  Wire.begin();
+  // The bus is started by I2cBus::begin()
   _displayfunction = LCD_1LINE | LCD_5x8DOTS | LCD_8BITMODE;
   begin(_cols, _rows);
 }
@@ -83,13 +95,11 @@ void LiquidCrystal_AIP31068_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dots
   // this is according to the hitachi HD44780 datasheet
   // page 45 figure 23
 
-  // Send function set command sequence
-  command(LCD_FUNCTIONSET | _displayfunction);
-  delayMicroseconds(4500);  // wait more than 4.1ms
+  // Send function set command sequence, the waits are kept by the bus manager
+  send(LCD_FUNCTIONSET | _displayfunction, 0, 4500);  // wait more than 4.1ms
 
   // second try
-  command(LCD_FUNCTIONSET | _displayfunction);
-  delayMicroseconds(150);
+  send(LCD_FUNCTIONSET | _displayfunction, 0, 150);
 
   // third go
   command(LCD_FUNCTIONSET | _displayfunction);
@@ -125,14 +135,12 @@ void LiquidCrystal_AIP31068_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dots
 
 /********** high level commands, for the user! */
 void LiquidCrystal_AIP31068_I2C::clear() {
-  command(LCD_CLEARDISPLAY);  // clear display, set cursor position to zero
-  delayMicroseconds(2000);    // this command takes a long time!
+  send(LCD_CLEARDISPLAY, 0, 2000);  // clear display, set cursor position to zero; takes a long time!
   if (_oled) setCursor(0, 0);
 }
 
 void LiquidCrystal_AIP31068_I2C::home() {
-  command(LCD_RETURNHOME);  // set cursor position to zero
-  delayMicroseconds(2000);  // this command takes a long time!
+  send(LCD_RETURNHOME, 0, 2000);  // set cursor position to zero; takes a long time!
 }
 
 void LiquidCrystal_AIP31068_I2C::setCursor(uint8_t col, uint8_t row) {
@@ -210,18 +218,18 @@ void LiquidCrystal_AIP31068_I2C::noAutoscroll(void) {
 void LiquidCrystal_AIP31068_I2C::createChar(uint8_t location, uint8_t charmap[]) {
   location &= 0x7;  // we only have 8 locations 0-7
   command(LCD_SETCGRAMADDR | (location << 3));
-  for (int i = 0; i < 8; i++) {
-    write(charmap[i]);
-  }
+  write(charmap, 8);
 }
 
 // createChar with PROGMEM input
 void LiquidCrystal_AIP31068_I2C::createChar(uint8_t location, const char *charmap) {
   location &= 0x7;  // we only have 8 locations 0-7
   command(LCD_SETCGRAMADDR | (location << 3));
+  uint8_t rows[8];
   for (int i = 0; i < 8; i++) {
-    write(pgm_read_byte_near(charmap++));
+    rows[i] = pgm_read_byte_near(charmap++);
   }
+  write(rows, 8);
 }
 
 
@@ -235,24 +243,23 @@ void LiquidCrystal_AIP31068_I2C::command(uint8_t value) {
 /************ low level data pushing commands **********/
 
 // write either command or data
-void LiquidCrystal_AIP31068_I2C::send(uint8_t value, uint8_t mode) {
+void LiquidCrystal_AIP31068_I2C::send(uint8_t value, uint8_t mode, uint16_t holdMicros) {
   uint16_t rs = mode != 0 ? Rs << 8 : 0;
-  write8bits(rs | value);
+  write8bits(rs | value, holdMicros);
 }
 
 void LiquidCrystal_AIP31068_I2C::write4bits(uint16_t value) {
   controllerWrite((value & 0xFF00) | (value & 0x00FF) << 4);
 }
 
-void LiquidCrystal_AIP31068_I2C::write8bits(uint16_t value) {
-  controllerWrite(value);
+void LiquidCrystal_AIP31068_I2C::write8bits(uint16_t value, uint16_t holdMicros) {
+  controllerWrite(value, holdMicros);
 }
 
-void LiquidCrystal_AIP31068_I2C::controllerWrite(uint16_t _data) {
-  Wire.beginTransmission(_Addr);
-  printIIC((_data >> 8) & 0xFF);
-  printIIC((_data >> 0) & 0xFF);
-  Wire.endTransmission();
+// Queued with display priority, sensor reads on the same bus go first
+void LiquidCrystal_AIP31068_I2C::controllerWrite(uint16_t _data, uint16_t holdMicros) {
+  uint8_t bytes[2] = { (uint8_t)((_data >> 8) & 0xFF), (uint8_t)((_data >> 0) & 0xFF) };
+  i2cBus.post(_Addr, bytes, sizeof(bytes), holdMicros);
 }
 
 // Alias functions
@@ -284,16 +291,14 @@ void LiquidCrystal_AIP31068_I2C::printstr(const char c[]) {
 }
 
 void LiquidCrystal_AIP31068_I2C::setReg(uint8_t addr, uint8_t data) {
-  Wire.beginTransmission(RGB_ADDRESS);  // transmit to device #4
-  Wire.write(addr);
-  Wire.write(data);
-  Wire.endTransmission();  // stop transmitting
+  uint8_t bytes[2] = { addr, data };
+  i2cBus.post(RGB_ADDRESS, bytes, sizeof(bytes));
 }
 
+// One burst from pwm0 to pwm2, so a color change is a single transaction without a mixed intermediate color
 void LiquidCrystal_AIP31068_I2C::setRGB(uint8_t r, uint8_t g, uint8_t b) {
-  setReg(REG_RED, r);
-  setReg(REG_GREEN, g);
-  setReg(REG_BLUE, b);
+  uint8_t bytes[4] = { REG_AUTO_INCREMENT_PWM | REG_BLUE, b, g, r };
+  i2cBus.post(RGB_ADDRESS, bytes, sizeof(bytes));
 }
 
 
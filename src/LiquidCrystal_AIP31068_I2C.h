@@ -23,6 +23,7 @@
 #define REG_MODE1 0x00
 #define REG_MODE2 0x01
 #define REG_OUTPUT 0x08
+#define REG_AUTO_INCREMENT_PWM 0xA0  // AI2..0 = 101: increment over the brightness registers only
 
 // commands
 #define LCD_CLEARDISPLAY 0x01
@@ -99,7 +100,9 @@ public:
 
   void setCursor(uint8_t, uint8_t);
 #if defined(ARDUINO) && ARDUINO >= 100
+  using Print::write;
   virtual size_t write(uint8_t);
+  virtual size_t write(const uint8_t *buffer, size_t size);  // one I2C data stream per batch
 #else
   virtual void write(uint8_t);
 #endif
@@ -129,10 +132,10 @@ public:
 
 private:
   void init_priv();
-  void send(uint8_t, uint8_t);
+  void send(uint8_t, uint8_t, uint16_t holdMicros = 0);
   void write4bits(uint16_t);
-  void write8bits(uint16_t);
-  void controllerWrite(uint16_t);
+  void write8bits(uint16_t, uint16_t holdMicros = 0);
+  void controllerWrite(uint16_t, uint16_t holdMicros = 0);
   //  void pulseEnable(uint8_t);
   uint8_t _Addr;
   uint8_t _displayfunction;
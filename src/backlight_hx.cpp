@@ -0,0 +1,116 @@
+/**
+ * @file backlight_hx.cpp
+ * @brief Implementation of the backlight animations.
+ * @details Contains the keyframe tables of the device states and the interpolation of
+ *          `BacklightAnimator`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "backlight_hx.h"
+
+// Steady white, the color after the display initialization
+static const BacklightKeyframe idleFrames[] = {
+  { { 255, 255, 255 }, 1000 },
+};
+// Orange pulse with a period of two seconds
+static const BacklightKeyframe heatingFrames[] = {
+  { { 255, 96, 0 }, 1000 },
+  { { 96, 24, 0 }, 1000 },
+};
+// Steady green
+static const BacklightKeyframe holdingFrames[] = {
+  { { 0, 255, 64 }, 1000 },
+};
+// Slow blue breathing with a period of four seconds
+static const BacklightKeyframe doneFrames[] = {
+  { { 0, 128, 255 }, 2000 },
+  { { 0, 32, 64 }, 2000 },
+};
+// Red blinking at 1 Hz with hard edges
+static const BacklightKeyframe faultFrames[] = {
+  { { 255, 0, 0 }, 1 },
+  { { 255, 0, 0 }, 500 },
+  { { 0, 0, 0 }, 1 },
+  { { 0, 0, 0 }, 500 },
+};
+
+#define ANIMATION(frames) { frames, sizeof(frames) / sizeof(frames[0]) }
+
+const BacklightAnimation backlightAnimations[BACKLIGHT_COUNT] = {
+  ANIMATION(idleFrames),
+  ANIMATION(heatingFrames),
+  ANIMATION(holdingFrames),
+  ANIMATION(doneFrames),
+  ANIMATION(faultFrames),
+};
+
+static uint8_t mix(uint8_t from, uint8_t to, uint32_t elapsed, uint32_t duration) {
+  return from + ((int32_t)to - from) * (int32_t)elapsed / (int32_t)duration;
+}
+
+BacklightAnimator::BacklightAnimator(LiquidCrystal_AIP31068_I2C &display)
+  : lcd(display), state(BACKLIGHT_IDLE), from({ 255, 255, 255 }), shown({ 255, 255, 255 }), frame(0),
+    segmentTime(_BACKLIGHT_FADE_TIME), segmentMillis(0), frameMillis(0), written(0) {
+}
+
+void BacklightAnimator::begin() {
+  segmentMillis = loopMillis();
+  frameMillis = segmentMillis;
+}
+
+void BacklightAnimator::setState(enumBacklightState newState) {
+  if (newState == state) {
+    return;
+  }
+  // Fade from the color on display, wherever the old animation was
+  state = newState;
+  from = shown;
+  frame = 0;
+  segmentTime = _BACKLIGHT_FADE_TIME;
+  segmentMillis = loopMillis();
+}
+
+void BacklightAnimator::update() {
+  unsigned long now = loopMillis();
+  if (now - frameMillis < _BACKLIGHT_FRAME_INTERVAL) {
+    return;
+  }
+  frameMillis = now;
+
+  // Advance over the completed segments; after a long stall the animation restarts at its position
+  const BacklightAnimation &animation = backlightAnimations[state];
+  for (uint8_t skipped = 0; now - segmentMillis >= segmentTime; skipped++) {
+    if (skipped > animation.count) {
+      segmentMillis = now - segmentTime;
+    }
+    segmentMillis += segmentTime;
+    from = animation.frames[frame].color;
+    frame = (frame + 1) % animation.count;
+    segmentTime = animation.frames[frame].time;
+  }
+
+  const BacklightColor &to = animation.frames[frame].color;
+  uint32_t elapsed = now - segmentMillis;
+  BacklightColor color = {
+    mix(from.red, to.red, elapsed, segmentTime),
+    mix(from.green, to.green, elapsed, segmentTime),
+    mix(from.blue, to.blue, elapsed, segmentTime)
+  };
+  if (color.red == shown.red && color.green == shown.green && color.blue == shown.blue) {
+    return;  // A steady color costs no bus traffic
+  }
+  lcd.setRGB(color.red, color.green, color.blue);
+  shown = color;
+  written++;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file backlight_hx.h
+ * @brief Status colors of the LCD backlight.
+ * @details This file contains the `BacklightAnimator` class, which plays a keyframe animation
+ *          per device state on the RGB backlight of the LCD without blocking the loop.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef BACKLIGHT_HX_H
+#define BACKLIGHT_HX_H
+
+#include <Arduino.h>
+#include "LiquidCrystal_AIP31068_I2C.h"
+#include "globals_hx.h"
+#include "input_hx.h"
+
+/** Device states shown by the backlight. */
+enum enumBacklightState {
+  BACKLIGHT_IDLE,     ///< No run active.
+  BACKLIGHT_HEATING,  ///< Run active, ramping to the setpoint.
+  BACKLIGHT_HOLDING,  ///< Run active, holding the setpoint.
+  BACKLIGHT_DONE,     ///< The last run reached its target time.
+  BACKLIGHT_FAULT,    ///< No valid sensor data or a stuck I2C bus.
+  BACKLIGHT_COUNT     ///< Number of states.
+};
+
+/**
+ * @brief Color of the backlight.
+ */
+typedef struct {
+  uint8_t red;    ///< Red PWM duty (0..255).
+  uint8_t green;  ///< Green PWM duty (0..255).
+  uint8_t blue;   ///< Blue PWM duty (0..255).
+} BacklightColor;
+
+/**
+ * @brief Point of an animation.
+ */
+typedef struct {
+  BacklightColor color;  ///< Color at the keyframe.
+  uint16_t time;         ///< Time in milliseconds to reach the color from the previous keyframe, at least 1.
+} BacklightKeyframe;
+
+/**
+ * @brief Looping animation of one state.
+ */
+typedef struct {
+  const BacklightKeyframe *frames;  ///< Keyframes, the last one leads back to the first.
+  uint8_t count;                    ///< Number of keyframes; one keyframe is a steady color.
+} BacklightAnimation;
+
+/**
+ * @brief Table of the animations, indexed by `enumBacklightState`.
+ */
+extern const BacklightAnimation backlightAnimations[BACKLIGHT_COUNT];
+
+/**
+ * @brief Plays the animation of the device state on the RGB backlight.
+ * @details The colors between two keyframes are interpolated linearly, so fades and pulses
+ *          need only their end points; a hard step is two keyframes of the same color. A state
+ *          change fades from the color on display to the first keyframe of the new animation
+ *          within `_BACKLIGHT_FADE_TIME`.
+ *
+ *          `update()` computes at most one frame per `_BACKLIGHT_FRAME_INTERVAL` and writes it
+ *          only if the color changed, as one burst of the three PWM registers through the
+ *          display queue of `I2cBus`. A steady color costs no bus traffic, a fade about
+ *          0.15 ms of bus time per frame.
+ *
+ * ### Example Usage
+ * ```cpp
+ * BacklightAnimator backlight(lcd);
+ *
+ * void setup() {
+ *   lcd.init();
+ *   backlight.begin();
+ * }
+ *
+ * void loop() {
+ *   backlight.setState(running ? BACKLIGHT_HEATING : BACKLIGHT_IDLE);
+ *   backlight.update();
+ * }
+ * ```
+ */
+class BacklightAnimator {
+private:
+  LiquidCrystal_AIP31068_I2C &lcd; /**< Display with the backlight. */
+  enumBacklightState state;        /**< State of the animation being played. */
+  BacklightColor from;             /**< Color at the start of the current segment. */
+  BacklightColor shown;            /**< Color last written to the backlight. */
+  uint8_t frame;                   /**< Keyframe the current segment leads to. */
+  uint16_t segmentTime;            /**< Duration of the current segment in milliseconds. */
+  unsigned long segmentMillis;     /**< Start of the current segment. */
+  unsigned long frameMillis;       /**< Time of the last computed frame. */
+  uint32_t written;                /**< Frames written to the backlight. */
+
+public:
+  /**
+   * @brief Constructor: Initializes the animator in the idle state.
+   * @param display Display whose backlight is animated.
+   */
+  explicit BacklightAnimator(LiquidCrystal_AIP31068_I2C &display);
+
+  /**
+   * @brief Starts the idle animation from the white of `LiquidCrystal_AIP31068_I2C::init()`.
+   */
+  void begin();
+
+  /**
+   * @brief Switches to the animation of a state; a repeated state is ignored.
+   * @param newState State to show.
+   */
+  void setState(enumBacklightState newState);
+
+  /**
+   * @brief Computes and writes the next frame when it is due. Call cyclically from the loop.
+   */
+  void update();
+
+  /**
+   * @brief Gets the state being shown.
+   * @return Current state.
+   */
+  enumBacklightState getState() const {
+    return state;
+  }
+
+  /**
+   * @brief Gets the number of frames written to the backlight.
+   * @return Bus writes since boot.
+   */
+  uint32_t getWritten() const {
+    return written;
+  }
+};
+
+
+#endif  // BACKLIGHT_HX_H
@@ -0,0 +1,264 @@
+/**
+ * @file capture_format_hx.h
+ * @brief File format of the input capture, shared by the firmware and the host replayer.
+ * @details This file defines the block layout, the event encoding and the CRC32 of the capture
+ *          file written by `InputCapture`. It depends only on the C++ standard headers, so the
+ *          replayer in `tools/replay` uses it unchanged.
+ *
+ * ### File Layout
+ * The file is a sequence of blocks, each a `CaptureBlockHeader` followed by `length` bytes of
+ * events. Every event starts with the varint `(dt << 3) | type`, `dt` being the milliseconds
+ * since the previous event of the block or, for the first event, since the `time` of the
+ * header. The payload depends on the type:
+ * - `CAPTURE_GAP`: varint gap length in ms
+ * - `CAPTURE_PIN`: pin, level
+ * - `CAPTURE_ANALOG`: pin, varint value
+ * - `CAPTURE_I2C`: address, first register, length, bytes; length 0 marks a failed read
+ * - `CAPTURE_PRESENCE`: address, 1 if the device acknowledged
+ * - `CAPTURE_CALIBRATION`: address, length, calibration bytes
+ * - `CAPTURE_SETTINGS`: length, `CaptureSettings`
+ * - `CAPTURE_BOOT`: no payload
+ *
+ * All event times are loop pass times, see `loopMillis()`. Pins, analog values and registers
+ * are recorded only when they differ from the last recorded value, so an event describes the
+ * input from its time on.
+ *
+ * ### Segments
+ * The firmware writes the capture as a ring of segment files. Every segment starts with a
+ * block flagged `CAPTURE_FLAG_KEYFRAME`: its events restate the presence and calibration of the
+ * sensors, and from its first loop pass on every input and the settings with the run state are
+ * recorded again. A replay can therefore start at any segment. The first segment of a boot
+ * starts with `CAPTURE_BOOT`; block numbers continue across the segments of one boot.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Keyframe blocks at the start of every segment
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef CAPTURE_FORMAT_HX_H
+#define CAPTURE_FORMAT_HX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CAPTURE_MAGIC 0x50435848  ///< "HXCP" in little endian
+#define CAPTURE_VERSION 1         ///< Layout version of the blocks and events
+#define CAPTURE_DATA_MAX 36       ///< Maximum payload bytes of one event
+#define CAPTURE_EVENT_MAX 48      ///< Maximum size of one encoded event in bytes
+
+/**
+ * @brief Event types.
+ */
+enum enumCaptureEvent {
+  CAPTURE_GAP = 0,          ///< A loop pass that follows the previous pass after more than 1 ms.
+  CAPTURE_PIN = 1,          ///< Level of a digital input.
+  CAPTURE_ANALOG = 2,       ///< Value of an analog input.
+  CAPTURE_I2C = 3,          ///< Bytes of a register read from an I2C device.
+  CAPTURE_PRESENCE = 4,     ///< Acknowledge of an I2C device when probed.
+  CAPTURE_CALIBRATION = 5,  ///< Calibration data of a BME280.
+  CAPTURE_SETTINGS = 6,     ///< Settings that the user or the NVS changed.
+  CAPTURE_BOOT = 7,         ///< Pass of `setup()` that initializes the sensors, first event of a capture.
+  CAPTURE_EVENT_COUNT       ///< Number of event types.
+};
+
+/**
+ * @brief Bits of `CaptureBlockHeader::flags`.
+ */
+enum enumCaptureFlags {
+  CAPTURE_FLAG_LOST = 0x01,      ///< Events were dropped before this block, the replay is no longer exact.
+  CAPTURE_FLAG_KEYFRAME = 0x02,  ///< First block of a segment, all inputs are recorded again from here.
+};
+
+/**
+ * @brief Header of one block of the capture file.
+ */
+typedef struct {
+  uint32_t magic;     ///< Block identifier `CAPTURE_MAGIC`.
+  uint32_t sequence;  ///< Block number since boot, a gap shows a lost block.
+  uint32_t time;      ///< Base time of the first event (ms since boot).
+  uint8_t version;    ///< Layout version `CAPTURE_VERSION`.
+  uint8_t flags;      ///< State bits, see `enumCaptureFlags`.
+  uint16_t count;     ///< Number of events.
+  uint16_t length;    ///< Size of the events following the header in bytes.
+  uint16_t reserved;  ///< Zero.
+  uint32_t crc;       ///< CRC32 of the header up to this field and of the events.
+} CaptureBlockHeader;
+
+/**
+ * @brief Settings as recorded in a `CAPTURE_SETTINGS` event, little endian.
+ */
+typedef struct {
+  int32_t targetTemperature;  ///< Target temperature (0.01 °C).
+  int32_t targetHumidity;     ///< Target humidity (0.01 %).
+  int16_t hours;              ///< Countdown hours.
+  int16_t minutes;            ///< Countdown minutes.
+  float kp;                   ///< Proportional gain of the heating PID.
+  float ki;                   ///< Integral gain of the heating PID.
+  float kd;                   ///< Derivative gain of the heating PID.
+  uint32_t elapsedSeconds;    ///< Heating time of the run, used from the first event only.
+  uint8_t running;            ///< Run active, used from the first event only.
+  uint8_t reserved[3];        ///< Zero.
+} CaptureSettings;
+
+/**
+ * @brief One decoded event.
+ */
+typedef struct {
+  uint32_t time;                   ///< Loop pass time (ms since boot).
+  uint8_t type;                    ///< Event type, see `enumCaptureEvent`.
+  uint8_t channel;                 ///< Pin or I2C address.
+  uint8_t reg;                     ///< First register of an I2C read.
+  uint8_t length;                  ///< Bytes in `data`.
+  uint32_t value;                  ///< Gap length, pin level, analog value or presence.
+  uint8_t data[CAPTURE_DATA_MAX];  ///< Register bytes, calibration or `CaptureSettings`.
+} CaptureEvent;
+
+static_assert(sizeof(CaptureBlockHeader) == 24, "CaptureBlockHeader is part of the file format");
+static_assert(sizeof(CaptureSettings) == 32, "CaptureSettings is part of the file format");
+
+/**
+ * @brief Computes the CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320).
+ * @param data Bytes to check.
+ * @param length Number of bytes.
+ * @param crc Running CRC, for checksums over several blocks.
+ * @return CRC of the bytes.
+ */
+inline uint32_t captureCrc32(const uint8_t *data, size_t length, uint32_t crc = 0) {
+  crc = ~crc;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Encodes an event.
+ * @param out Destination, at least `CAPTURE_EVENT_MAX` bytes.
+ * @param event Event to encode; `time` must not be before `previousTime`.
+ * @param previousTime Time of the previous event or the base time of the block.
+ * @return Number of bytes written.
+ */
+inline size_t captureEncodeEvent(uint8_t *out, const CaptureEvent &event, uint32_t previousTime) {
+  uint8_t *start = out;
+  auto putVarint = [&out](uint32_t value) {
+    while (value >= 0x80) {
+      *out++ = (uint8_t)value | 0x80;
+      value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+  };
+  auto putBytes = [&out, &event]() {
+    *out++ = event.length;
+    memcpy(out, event.data, event.length);
+    out += event.length;
+  };
+  putVarint(((event.time - previousTime) << 3) | event.type);
+  switch (event.type) {
+    case CAPTURE_GAP:
+      putVarint(event.value);
+      break;
+    case CAPTURE_PIN:
+    case CAPTURE_PRESENCE:
+      *out++ = event.channel;
+      *out++ = (uint8_t)event.value;
+      break;
+    case CAPTURE_ANALOG:
+      *out++ = event.channel;
+      putVarint(event.value);
+      break;
+    case CAPTURE_I2C:
+      *out++ = event.channel;
+      *out++ = event.reg;
+      putBytes();
+      break;
+    case CAPTURE_CALIBRATION:
+      *out++ = event.channel;
+      putBytes();
+      break;
+    case CAPTURE_SETTINGS:
+      putBytes();
+      break;
+    default:
+      break;
+  }
+  return out - start;
+}
+
+/**
+ * @brief Decodes the next event of a block.
+ * @param in Read position, advanced past the event.
+ * @param end End of the events of the block.
+ * @param event Receives the event.
+ * @param previousTime Time of the previous event or the base time of the block.
+ * @return false if the event is truncated or malformed.
+ */
+inline bool captureDecodeEvent(const uint8_t *&in, const uint8_t *end, CaptureEvent &event, uint32_t previousTime) {
+  auto getVarint = [&in, end](uint32_t &value) {
+    value = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+      if (in >= end) return false;
+      uint8_t byte = *in++;
+      value |= (uint32_t)(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return true;
+    }
+    return false;
+  };
+  auto getByte = [&in, end](uint8_t &value) {
+    if (in >= end) return false;
+    value = *in++;
+    return true;
+  };
+
+  uint32_t head;
+  if (!getVarint(head)) return false;
+  event.time = previousTime + (head >> 3);
+  event.type = head & 0x07;
+  event.channel = 0;
+  event.reg = 0;
+  event.length = 0;
+  event.value = 0;
+  uint8_t byte;
+  switch (event.type) {
+    case CAPTURE_GAP:
+      return getVarint(event.value);
+    case CAPTURE_PIN:
+    case CAPTURE_PRESENCE:
+      if (!getByte(event.channel) || !getByte(byte)) return false;
+      event.value = byte;
+      return true;
+    case CAPTURE_ANALOG:
+      return getByte(event.channel) && getVarint(event.value);
+    case CAPTURE_I2C:
+      if (!getByte(event.channel) || !getByte(event.reg)) return false;
+      break;
+    case CAPTURE_CALIBRATION:
+      if (!getByte(event.channel)) return false;
+      break;
+    case CAPTURE_SETTINGS:
+      break;
+    case CAPTURE_BOOT:
+      return true;
+    default:
+      return false;
+  }
+  if (!getByte(event.length) || event.length > CAPTURE_DATA_MAX || end - in < event.length) return false;
+  memcpy(event.data, in, event.length);
+  in += event.length;
+  return true;
+}
+
+
+#endif  // CAPTURE_FORMAT_HX_H
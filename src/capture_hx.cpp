@@ -0,0 +1,415 @@
+/**
+ * @file capture_hx.cpp
+ * @brief Implementation of the input capture and of the input port on the board.
+ * @details Contains the change detection, the buffer handover and the writer task of
+ *          `InputCapture` and the functions of `input_hx.h`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Free space of the file system checked before an append
+ * - **2026-10-19**: Ring of keyframed segments in `_CAPTURE_DIR`
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "capture_hx.h"
+#include "log_hx.h"
+#include "storage_hx.h"
+
+#include <stdlib.h>
+
+InputCapture inputCapture;
+
+// Path of a segment file of the ring, e.g. "/capture/00000012.hxc"
+static void segmentPath(char *path, size_t size, uint32_t number) {
+  snprintf(path, size, _CAPTURE_DIR "/%08u.hxc", (unsigned)number);
+}
+
+uint32_t loopMillis() {
+  return inputCapture.getPassMillis();
+}
+
+int readInputPin(uint8_t pin) {
+  int level = digitalRead(pin);
+  inputCapture.recordPin(pin, level);
+  return level;
+}
+
+uint16_t readInputAnalog(uint8_t pin) {
+  uint16_t value = analogRead(pin);
+  inputCapture.recordAnalog(pin, value);
+  return value;
+}
+
+void captureI2cPresence(uint8_t address, bool present) {
+  inputCapture.recordPresence(address, present);
+}
+
+void captureI2cRead(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length) {
+  inputCapture.recordI2c(address, reg, data, length);
+}
+
+void captureCalibration(uint8_t address, const void *calibration, size_t size) {
+  inputCapture.recordCalibration(address, calibration, size);
+}
+
+InputCapture::InputCapture()
+  : active(0), length(sizeof(CaptureBlockHeader)), count(0), lastTime(0), blockStart(0), sequence(0),
+    segmentLength(0), lost(false), keyframe(false), recording(false), passMillis(0), settings({}),
+    hasSettings(false), fs(nullptr), queue(nullptr), dropped(0), writeErrors(0), written(0), segment(0),
+    oldestSegment(1) {
+  busy[0] = false;
+  busy[1] = false;
+  memset(devices, 0, sizeof(devices));
+  forget();
+}
+
+bool InputCapture::begin(fs::FS &fileSystem) {
+  passMillis = millis();
+#ifdef _CAPTURE_ENABLED
+  fs = &fileSystem;
+
+  // The segments of the previous boots are kept, they may hold the fault that caused the reset
+  fs->mkdir(_CAPTURE_DIR);
+  char path[32];
+  if (fs->exists(_CAPTURE_LEGACY_FILE_OLD)) {
+    segmentPath(path, sizeof(path), 0);
+    fs->rename(_CAPTURE_LEGACY_FILE_OLD, path);
+  }
+  if (fs->exists(_CAPTURE_LEGACY_FILE)) {
+    segmentPath(path, sizeof(path), 1);
+    fs->rename(_CAPTURE_LEGACY_FILE, path);
+  }
+  scanSegments();
+
+  queue = xQueueCreate(2, sizeof(uint8_t));
+  if (queue == nullptr
+      || xTaskCreatePinnedToCore(writerTask, "capture", _CAPTURE_TASK_STACK, this,
+                                 _CAPTURE_TASK_PRIORITY, nullptr, 0) != pdPASS) {
+    HX_LOG_ERROR("Capture: cannot start writer task");
+    fs = nullptr;
+    return false;
+  }
+  recording = true;
+  keyframe = true;  // Every boot opens a new segment
+  add({ passMillis, CAPTURE_BOOT });
+  HX_LOG_INFO("Capture: recording to %s from segment %u", _CAPTURE_DIR, (unsigned)(segment + 1));
+  return true;
+#else
+  return false;
+#endif
+}
+
+void InputCapture::beginPass() {
+  uint32_t now = millis();
+  // The segment is full after the next block; the keyframe starts with a pass, so the new
+  // segment holds every input this pass reads. A busy buffer postpones it to the next pass.
+  if (recording && segmentLength + length + _CAPTURE_BLOCK_SIZE > _CAPTURE_SEGMENT_SIZE && submit()) {
+    startKeyframe(now);
+  }
+  // Consecutive milliseconds are implied, only longer steps are recorded
+  if (now - passMillis > 1) {
+    CaptureEvent event = { now, CAPTURE_GAP };
+    event.value = now - passMillis;
+    add(event);
+  }
+  passMillis = now;
+}
+
+void InputCapture::update() {
+  if (count > 0 && millis() - blockStart >= _CAPTURE_FLUSH_INTERVAL) {
+    submit();
+  }
+}
+
+void InputCapture::recordPin(uint8_t pin, int level) {
+  uint8_t value = level ? HIGH : LOW;
+  if (!recording || pin >= _CAPTURE_PIN_COUNT || pins[pin] == value) {
+    return;
+  }
+  pins[pin] = value;
+  CaptureEvent event = { passMillis, CAPTURE_PIN, pin };
+  event.value = value;
+  add(event);
+}
+
+void InputCapture::recordAnalog(uint8_t pin, uint16_t value) {
+  if (!recording || pin >= _CAPTURE_PIN_COUNT || analogs[pin] == value) {
+    return;
+  }
+  analogs[pin] = value;
+  CaptureEvent event = { passMillis, CAPTURE_ANALOG, pin };
+  event.value = value;
+  add(event);
+}
+
+void InputCapture::recordI2c(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t size) {
+  if (!recording) {
+    return;
+  }
+  static const uint8_t failed[1] = { 0 };
+  uint8_t bytes = data == nullptr ? 0 : (size < CAPTURE_DATA_MAX ? size : CAPTURE_DATA_MAX);
+  if (data == nullptr) {
+    data = failed;
+  }
+
+  CaptureI2cSlot *slot = nullptr;
+  for (uint8_t i = 0; i < _CAPTURE_I2C_SLOTS; i++) {
+    if (slots[i].address == address && slots[i].reg == reg) {
+      slot = &slots[i];
+      break;
+    }
+    if (slot == nullptr && slots[i].address == 0) {
+      slot = &slots[i];
+    }
+  }
+  if (slot != nullptr) {
+    if (slot->address == address && slot->reg == reg && slot->length == bytes && memcmp(slot->data, data, bytes) == 0) {
+      return;
+    }
+    slot->address = address;
+    slot->reg = reg;
+    slot->length = bytes;
+    memcpy(slot->data, data, bytes);
+  }
+  // Without a free slot every read is recorded
+
+  CaptureEvent event = { passMillis, CAPTURE_I2C, address, reg, bytes };
+  memcpy(event.data, data, bytes);
+  add(event);
+}
+
+void InputCapture::recordPresence(uint8_t address, bool present) {
+  if (!recording) {
+    return;
+  }
+  for (uint8_t i = 0; i < _CAPTURE_I2C_SLOTS; i++) {
+    if (slots[i].address == address) {
+      slots[i].address = 0;
+    }
+  }
+  CaptureDevice *entry = device(address);
+  if (entry != nullptr) {
+    entry->present = present;
+  }
+  CaptureEvent event = { passMillis, CAPTURE_PRESENCE, address };
+  event.value = present;
+  add(event);
+}
+
+void InputCapture::recordCalibration(uint8_t address, const void *calibration, size_t size) {
+  if (!recording) {
+    return;
+  }
+  uint8_t bytes = size < CAPTURE_DATA_MAX ? size : CAPTURE_DATA_MAX;
+  CaptureDevice *entry = device(address);
+  if (entry != nullptr) {
+    entry->length = bytes;
+    memcpy(entry->calibration, calibration, bytes);
+  }
+  CaptureEvent event = { passMillis, CAPTURE_CALIBRATION, address, 0, bytes };
+  memcpy(event.data, calibration, bytes);
+  add(event);
+}
+
+void InputCapture::recordSettings(const Settings &current) {
+  if (!recording) {
+    return;
+  }
+  CaptureSettings next = {
+    current.target.temperature,
+    current.target.humidity,
+    (int16_t)current.countdown.hours,
+    (int16_t)current.countdown.minutes,
+    current.kp,
+    current.ki,
+    current.kd
+  };
+  if (hasSettings && memcmp(&next, &settings, sizeof(next)) == 0) {
+    return;
+  }
+  settings = next;
+
+  // The replayer takes the run state from the first settings, later it follows from the inputs
+  if (!hasSettings) {
+    next.elapsedSeconds = current.run.elapsedSeconds;
+    next.running = current.run.running;
+    hasSettings = true;
+  }
+  CaptureEvent event = { passMillis, CAPTURE_SETTINGS, 0, 0, sizeof(next) };
+  memcpy(event.data, &next, sizeof(next));
+  add(event);
+}
+
+CaptureDevice *InputCapture::device(uint8_t address) {
+  CaptureDevice *free = nullptr;
+  for (uint8_t i = 0; i < _CAPTURE_DEVICES; i++) {
+    if (devices[i].address == address) {
+      return &devices[i];
+    }
+    if (free == nullptr && devices[i].address == 0) {
+      free = &devices[i];
+    }
+  }
+  if (free != nullptr) {
+    free->address = address;
+  }
+  return free;
+}
+
+void InputCapture::add(const CaptureEvent &event) {
+  if (!recording) {
+    return;
+  }
+  if (length + CAPTURE_EVENT_MAX > _CAPTURE_BLOCK_SIZE && !submit()) {
+    // The inputs are recorded in full again once a buffer is free
+    dropped++;
+    lost = true;
+    forget();
+    return;
+  }
+
+  uint8_t *buffer = buffers[active];
+  if (count == 0) {
+    ((CaptureBlockHeader *)buffer)->time = event.time;
+    lastTime = event.time;
+    blockStart = millis();
+  }
+  length += captureEncodeEvent(buffer + length, event, lastTime);
+  lastTime = event.time;
+  count++;
+}
+
+void InputCapture::forget() {
+  memset(pins, 0xFF, sizeof(pins));
+  memset(analogs, 0xFF, sizeof(analogs));
+  memset(slots, 0, sizeof(slots));
+  hasSettings = false;
+}
+
+void InputCapture::startKeyframe(uint32_t time) {
+  segmentLength = 0;
+  keyframe = true;
+  for (const CaptureDevice &entry : devices) {
+    if (entry.address == 0) {
+      continue;
+    }
+    CaptureEvent event = { time, CAPTURE_PRESENCE, entry.address };
+    event.value = entry.present;
+    add(event);
+    if (entry.length > 0) {
+      event = { time, CAPTURE_CALIBRATION, entry.address, 0, entry.length };
+      memcpy(event.data, entry.calibration, entry.length);
+      add(event);
+    }
+  }
+  // Everything the pass reads is recorded again, the settings with the run state
+  forget();
+}
+
+bool InputCapture::submit() {
+  uint8_t next = active ^ 1;
+  if (busy[next]) {
+    return false;
+  }
+
+  CaptureBlockHeader *header = (CaptureBlockHeader *)buffers[active];
+  header->magic = CAPTURE_MAGIC;
+  header->sequence = sequence++;
+  header->version = CAPTURE_VERSION;
+  header->flags = (lost ? CAPTURE_FLAG_LOST : 0) | (keyframe ? CAPTURE_FLAG_KEYFRAME : 0);
+  header->count = count;
+  header->length = length - sizeof(CaptureBlockHeader);
+  header->reserved = 0;
+  uint32_t crc = captureCrc32(buffers[active], offsetof(CaptureBlockHeader, crc));
+  header->crc = captureCrc32(buffers[active] + sizeof(CaptureBlockHeader), header->length, crc);
+
+  busy[active] = true;
+  xQueueSend(queue, &active, 0);  // Never full, at most two buffers are in flight
+  segmentLength += length;
+
+  active = next;
+  length = sizeof(CaptureBlockHeader);
+  count = 0;
+  lost = false;
+  keyframe = false;
+  return true;
+}
+
+void InputCapture::scanSegments() {
+  bool found = false;
+  File dir = fs->open(_CAPTURE_DIR, FILE_READ);
+  if (dir && dir.isDirectory()) {
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+      const char *name = strrchr(file.name(), '/');
+      name = name ? name + 1 : file.name();
+      char *end;
+      uint32_t number = strtoul(name, &end, 10);
+      if (end != name && *end == '.') {
+        oldestSegment = !found || number < oldestSegment ? number : oldestSegment;
+        segment = !found || number > segment ? number : segment.load();
+        found = true;
+      }
+      file.close();
+    }
+  }
+  if (dir) dir.close();
+}
+
+void InputCapture::removeSegment(uint32_t number) {
+  char path[32];
+  segmentPath(path, sizeof(path), number);
+  if (fs->exists(path) && fs->remove(path)) {
+    HX_LOG_DEBUG("Capture: segment %u deleted", (unsigned)number);
+  }
+}
+
+void InputCapture::writeBlock(uint8_t buffer) {
+  const CaptureBlockHeader *header = (const CaptureBlockHeader *)buffers[buffer];
+  size_t size = sizeof(CaptureBlockHeader) + header->length;
+
+  // A keyframe opens the next segment, the ring keeps the newest ones
+  if (header->flags & CAPTURE_FLAG_KEYFRAME) {
+    segment++;
+    while (segment - oldestSegment >= _CAPTURE_SEGMENTS) {
+      removeSegment(oldestSegment++);
+    }
+  }
+
+  // The run log shares the file system; the capture gives way with its own oldest segments
+  while (storageFree(*fs) < size && oldestSegment < segment) {
+    removeSegment(oldestSegment++);
+  }
+  if (storageFree(*fs) < size) {
+    dropped += header->count;
+    return;
+  }
+
+  char path[32];
+  segmentPath(path, sizeof(path), segment);
+  File file = fs->open(path, FILE_APPEND);
+  if (file && file.write(buffers[buffer], size) == size) {
+    written += size;
+  } else {
+    writeErrors++;
+  }
+  if (file) file.close();
+}
+
+void InputCapture::writerTask(void *parameter) {
+  InputCapture *capture = (InputCapture *)parameter;
+  uint8_t buffer;
+  for (;;) {
+    if (xQueueReceive(capture->queue, &buffer, portMAX_DELAY) == pdTRUE) {
+      capture->writeBlock(buffer);
+      capture->busy[buffer] = false;
+    }
+  }
+}
@@ -0,0 +1,267 @@
+/**
+ * @file capture_hx.h
+ * @brief Recorder of the external inputs for a deterministic replay on the host.
+ * @details This file contains the `InputCapture` class, which implements the input port of
+ *          `input_hx.h` on the board: every digital and analog input, every register read from
+ *          the sensors, the sensor probes, the settings and the loop pass times are recorded with
+ *          their time and written from a background task to the FAT partition. The replayer in
+ *          `tools/replay` feeds the capture through the same control sources on the host.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Recording stopped when the shared storage budget is used up
+ * - **2026-10-19**: Ring of keyframed segments that keeps the most recent window
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef CAPTURE_HX_H
+#define CAPTURE_HX_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "capture_format_hx.h"
+#include "globals_hx.h"
+#include "input_hx.h"
+#include "settings_hx.h"
+
+/**
+ * @brief Last recorded bytes of one I2C register read.
+ */
+typedef struct {
+  uint8_t address;                 ///< Device address, 0 if the slot is free.
+  uint8_t reg;                     ///< First register.
+  uint8_t length;                  ///< Bytes read, 0 for a failed read.
+  uint8_t data[CAPTURE_DATA_MAX];  ///< Bytes read.
+} CaptureI2cSlot;
+
+/**
+ * @brief Last recorded probe and calibration of one I2C device, restated by every keyframe.
+ */
+typedef struct {
+  uint8_t address;                        ///< Device address, 0 if the entry is free.
+  bool present;                           ///< Result of the last probe.
+  uint8_t length;                         ///< Bytes in `calibration`, 0 if none was recorded.
+  uint8_t calibration[CAPTURE_DATA_MAX];  ///< Calibration data.
+} CaptureDevice;
+
+/**
+ * @brief Input recorder with double-buffered writes from a background task.
+ * @details The loop task calls `beginPass()` first in every `loop()`; the time sampled there is
+ *          returned by `loopMillis()` for the whole pass. A pass that follows the previous one
+ *          after more than 1 ms is recorded as a gap, so the replayer runs the passes at the
+ *          same times. Passes within the same millisecond see the same inputs and count as one.
+ *
+ *          Inputs are recorded only when they differ from the last recorded value of the same
+ *          pin or register, which keeps a multi-hour run in a few hundred kilobytes. A probe of a
+ *          sensor forgets the registers of its address, so the first reads after a reconnect are
+ *          recorded in full.
+ *
+ *          Events are encoded into one of two block buffers like in `RunLogger`. The loop task
+ *          never waits for the file system: if both buffers are busy, events are dropped, counted
+ *          and the next block is flagged with `CAPTURE_FLAG_LOST`.
+ *
+ *          The blocks are written to a ring of `_CAPTURE_SEGMENTS` files in `_CAPTURE_DIR`. When
+ *          a segment reaches `_CAPTURE_SEGMENT_SIZE`, the next loop pass starts a keyframe: the
+ *          devices are restated and the inputs are forgotten, so the new segment replays on its
+ *          own, and the writer task deletes the oldest segment. The ring survives a reset, so
+ *          the most recent `_CAPTURE_MAX_SIZE` bytes before a fault can be replayed. If
+ *          `storageFree()` has no room for a block, older segments are deleted first and the
+ *          block is dropped when none is left, so the run log keeps its share of the partition.
+ *          The capture is off unless `_CAPTURE_ENABLED` is defined.
+ *
+ * ### Example Usage
+ * ```cpp
+ * InputCapture inputCapture;
+ *
+ * void setup() {
+ *   FFat.begin();
+ *   inputCapture.begin(FFat);  // Boot pass, the sensors are probed with this time
+ *   sensorFusion.begin();
+ * }
+ *
+ * void loop() {
+ *   inputCapture.beginPass();
+ *   inputCapture.recordSettings(collectSettings());
+ *   // ... control code reading its inputs through input_hx.h ...
+ *   inputCapture.update();
+ * }
+ * ```
+ */
+class InputCapture {
+private:
+  uint8_t buffers[2][_CAPTURE_BLOCK_SIZE];  /**< Block buffers, header followed by the events. */
+  std::atomic<bool> busy[2];                /**< True while a buffer is owned by the writer task. */
+  uint8_t active;                           /**< Buffer being filled. */
+  size_t length;                            /**< Bytes used in the active buffer. */
+  uint16_t count;                           /**< Events in the active buffer. */
+  uint32_t lastTime;                        /**< Time of the previous event of the block, base of the deltas. */
+  unsigned long blockStart;                 /**< Time the active block was started (ms). */
+  uint32_t sequence;                        /**< Number of the next block. */
+  uint32_t segmentLength;                   /**< Bytes handed to the writer task for the current segment. */
+  bool lost;                                /**< True if events were dropped since the last block. */
+  bool keyframe;                            /**< True if the active block starts a segment. */
+  bool recording;                           /**< True while events are recorded. */
+  uint32_t passMillis;                      /**< Time of the current loop pass (ms). */
+  uint8_t pins[_CAPTURE_PIN_COUNT];         /**< Last recorded level per pin, 0xFF if unknown. */
+  uint16_t analogs[_CAPTURE_PIN_COUNT];     /**< Last recorded analog value per pin, 0xFFFF if unknown. */
+  CaptureI2cSlot slots[_CAPTURE_I2C_SLOTS]; /**< Last recorded register reads. */
+  CaptureDevice devices[_CAPTURE_DEVICES];  /**< Probed devices, restated by every keyframe. */
+  CaptureSettings settings;                 /**< Last recorded settings without the run state. */
+  bool hasSettings;                         /**< True after the first settings event. */
+  fs::FS *fs;                               /**< File system of the capture. */
+  QueueHandle_t queue;                      /**< Buffers waiting for the writer task. */
+  std::atomic<uint32_t> dropped;            /**< Events dropped because both buffers were busy. */
+  std::atomic<uint32_t> writeErrors;        /**< Blocks that could not be written. */
+  std::atomic<uint32_t> written;            /**< Bytes written since boot. */
+  std::atomic<uint32_t> segment;            /**< Segment being written, owned by the writer task. */
+  uint32_t oldestSegment;                   /**< Oldest segment that may exist, owned by the writer task. */
+
+  CaptureDevice *device(uint8_t address);
+  void add(const CaptureEvent &event);
+  void forget();
+  void startKeyframe(uint32_t time);
+  bool submit();
+  void scanSegments();
+  void removeSegment(uint32_t number);
+  void writeBlock(uint8_t buffer);
+  static void writerTask(void *parameter);
+
+public:
+  /**
+   * @brief Constructor: Initializes an idle recorder.
+   */
+  InputCapture();
+
+  /**
+   * @brief Starts the capture with the boot pass and the writer task.
+   * @details Must be called before the sensors are initialized. Without `_CAPTURE_ENABLED` only
+   *          the pass time is set.
+   * @param fs Mounted file system, e.g. `FFat`.
+   * @return true if the capture is recording.
+   */
+  bool begin(fs::FS &fs);
+
+  /**
+   * @brief Starts a loop pass; call it first in `loop()`.
+   */
+  void beginPass();
+
+  /**
+   * @brief Hands over due blocks to the writer task; call it regularly from the main loop.
+   */
+  void update();
+
+  /**
+   * @brief Records a digital input if it changed.
+   * @param pin GPIO number.
+   * @param level Level read.
+   */
+  void recordPin(uint8_t pin, int level);
+
+  /**
+   * @brief Records an analog input if it changed.
+   * @param pin GPIO number.
+   * @param value Value read.
+   */
+  void recordAnalog(uint8_t pin, uint16_t value);
+
+  /**
+   * @brief Records a register read if its bytes changed.
+   * @param address Device address.
+   * @param reg First register.
+   * @param data Bytes read, nullptr for a failed read.
+   * @param size Number of bytes.
+   */
+  void recordI2c(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t size);
+
+  /**
+   * @brief Records the result of a probe and forgets the registers of the address.
+   * @param address Device address.
+   * @param present True if the device acknowledged.
+   */
+  void recordPresence(uint8_t address, bool present);
+
+  /**
+   * @brief Records the calibration data of a sensor.
+   * @param address Device address.
+   * @param calibration Calibration data.
+   * @param size Size in bytes.
+   */
+  void recordCalibration(uint8_t address, const void *calibration, size_t size);
+
+  /**
+   * @brief Records the settings if the targets, the countdown or the tunings changed.
+   * @details The run state is recorded with the first settings only; the replayer derives it
+   *          from the inputs afterwards.
+   * @param current Current settings.
+   */
+  void recordSettings(const Settings &current);
+
+  /**
+   * @brief Gets the time of the current loop pass.
+   * @return Milliseconds since boot at the start of the pass.
+   */
+  uint32_t getPassMillis() const {
+    return passMillis;
+  }
+
+  /**
+   * @brief Checks if events are recorded.
+   * @return true after `begin()` with `_CAPTURE_ENABLED`.
+   */
+  bool isRecording() const {
+    return recording;
+  }
+
+  /**
+   * @brief Gets the number of the segment being written.
+   * @return Segment number, the file name in `_CAPTURE_DIR`.
+   */
+  uint32_t getSegment() const {
+    return segment;
+  }
+
+  /**
+   * @brief Gets the number of dropped events.
+   * @return Events dropped since boot, for busy buffers or a full file system.
+   */
+  uint32_t getDropped() const {
+    return dropped;
+  }
+
+  /**
+   * @brief Gets the number of failed block writes.
+   * @return Failed writes since boot.
+   */
+  uint32_t getWriteErrors() const {
+    return writeErrors;
+  }
+
+  /**
+   * @brief Gets the number of bytes written.
+   * @return Bytes written to the capture since boot.
+   */
+  uint32_t getWritten() const {
+    return written;
+  }
+};
+
+/**
+ * @brief Recorder behind the input port, defined in `capture_hx.cpp`.
+ */
+extern InputCapture inputCapture;
+
+
+#endif  // CAPTURE_HX_H
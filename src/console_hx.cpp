@@ -0,0 +1,77 @@
+/**
+ * @file console_hx.cpp
+ * @brief Implementation of the serial command console.
+ * @details Contains the line handling and the command dispatch of `SerialConsole`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "console_hx.h"
+
+SerialConsole::SerialConsole(const ConsoleCommand *commands, size_t count, Stream &stream)
+  : commands(commands), commandCount(count), stream(stream), length(0), overflow(false) {
+  line[0] = '\0';
+}
+
+void SerialConsole::update() {
+  while (stream.available() > 0) {
+    char c = stream.read();
+    if (c == '\r' || c == '\n') {
+      if (overflow) {
+        stream.println("Console: line too long");
+      } else if (length > 0) {
+        line[length] = '\0';
+        execute();
+      }
+      length = 0;
+      overflow = false;
+    } else if (length < sizeof(line) - 1) {
+      line[length++] = c;
+    } else {
+      overflow = true;
+    }
+  }
+}
+
+void SerialConsole::execute() {
+  char *name = line;
+  while (*name == ' ') name++;
+  char *args = name;
+  while (*args != '\0' && *args != ' ') args++;
+  if (*args != '\0') {
+    *args++ = '\0';
+    while (*args == ' ') args++;
+  }
+
+  if (*name == '\0') {
+    return;
+  }
+  if (strcmp(name, "help") == 0) {
+    printHelp();
+    return;
+  }
+  for (size_t i = 0; i < commandCount; i++) {
+    if (strcmp(name, commands[i].name) == 0) {
+      commands[i].handler(args);
+      return;
+    }
+  }
+  stream.printf("Console: unknown command \"%s\", try \"help\"\n", name);
+}
+
+void SerialConsole::printHelp() {
+  for (size_t i = 0; i < commandCount; i++) {
+    stream.printf("%-12s %s\n", commands[i].name, commands[i].help);
+  }
+  stream.printf("%-12s %s\n", "help", "Lists the commands");
+}
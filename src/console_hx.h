@@ -0,0 +1,92 @@
+/**
+ * @file console_hx.h
+ * @brief Line-based command console on the serial port.
+ * @details This file contains the `SerialConsole` class, which reads commands from `Serial`
+ *          without blocking the main loop and dispatches them to registered handlers.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef CONSOLE_HX_H
+#define CONSOLE_HX_H
+
+#include <Arduino.h>
+#include "globals_hx.h"
+
+/**
+ * @brief Handler of a console command.
+ * @param args Rest of the line after the command name, never `nullptr`.
+ */
+typedef void (*ConsoleHandler)(const char *args);
+
+/**
+ * @brief One entry of the command table.
+ */
+typedef struct {
+  const char *name;        ///< Command name, the first word of the line.
+  ConsoleHandler handler;  ///< Function called with the arguments.
+  const char *help;        ///< One-line description for `help`.
+} ConsoleCommand;
+
+/**
+ * @brief Non-blocking serial command console.
+ * @details `update()` consumes only the bytes already received and returns at once, so it can
+ *          be called from the main loop. A complete line is split into the command name and
+ *          its arguments and passed to the matching handler of the command table. The command
+ *          `help` lists all commands.
+ *
+ * ### Example Usage
+ * ```cpp
+ * void commandHello(const char *args) {
+ *   Serial.printf("Hello %s\n", args);
+ * }
+ *
+ * const ConsoleCommand commands[] = {
+ *   { "hello", commandHello, "Greets the argument" },
+ * };
+ * SerialConsole console(commands, sizeof(commands) / sizeof(commands[0]));
+ *
+ * void loop() {
+ *   console.update();
+ * }
+ * ```
+ */
+class SerialConsole {
+private:
+  const ConsoleCommand *commands;  /**< Command table. */
+  size_t commandCount;             /**< Number of entries in the command table. */
+  Stream &stream;                  /**< Port the commands are read from. */
+  char line[_CONSOLE_LINE_LENGTH]; /**< Line being received. */
+  size_t length;                   /**< Number of characters in `line`. */
+  bool overflow;                   /**< True if the current line is too long. */
+
+  void execute();
+  void printHelp();
+
+public:
+  /**
+   * @brief Constructor: Initializes the console.
+   * @param commands Command table, must stay valid.
+   * @param count Number of entries in the command table.
+   * @param stream Port to read from (default: `Serial`).
+   */
+  SerialConsole(const ConsoleCommand *commands, size_t count, Stream &stream = Serial);
+
+  /**
+   * @brief Reads the received bytes and executes a completed line.
+   */
+  void update();
+};
+
+
+#endif  // CONSOLE_HX_H
@@ -0,0 +1,154 @@
+/**
+ * @file filter_hx.h
+ * @brief Kalman filter for temperature and temperature rate estimation.
+ * @details This file contains a small, constant-size Kalman filter (`Kalman_heatX`)
+ *          used to fuse the readings of several temperature sensors.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef FILTER_HX_H
+#define FILTER_HX_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Two-state Kalman filter estimating temperature and its rate of change.
+ * @details The filter uses a constant-rate model with the state `[temperature, rate]`.
+ *          The rate is driven by white noise with the spectral density `q`, which sets
+ *          how fast the filter follows real changes. Measurements are scalar temperature
+ *          readings, each with its own variance, so samples of different sensors can be
+ *          fused one after another in the order they arrive.
+ *
+ *          Compared to a heavy IIR filter in the sensor, the filter keeps the phase lag low
+ *          and provides the rate estimate directly, so the controller does not have to
+ *          differentiate a noisy signal.
+ *
+ * ### Example Usage
+ * ```cpp
+ * #include "filter_hx.h"
+ *
+ * Kalman_heatX filter(0.01);  // Process noise density in °C²/s³
+ *
+ * void loop() {
+ *   if (NewSampleAvailable()) {
+ *     if (!filter.IsInitialized()) {
+ *       filter.Reset(ReadTemperature());
+ *     } else {
+ *       filter.Predict(0.1);                     // 100 ms since the last sample
+ *       filter.Update(ReadTemperature(), 0.01);  // Measurement variance in °C²
+ *     }
+ *     ApplyTemperature(filter.GetTemperature(), filter.GetRate());
+ *   }
+ * }
+ * ```
+ */
+class Kalman_heatX {
+private:
+  float temperature;   /**< Estimated temperature. */
+  float rate;          /**< Estimated rate of change per second. */
+  float p00, p01, p11; /**< Symmetric error covariance matrix. */
+  float processNoise;  /**< Spectral density of the rate noise. */
+  bool initialized;    /**< True after the first measurement. */
+
+public:
+  /**
+   * @brief Constructor: Initializes the filter.
+   * @param q Spectral density of the rate noise in °C²/s³.
+   */
+  Kalman_heatX(float q)
+    : temperature(0), rate(0), p00(0), p01(0), p11(0), processNoise(q), initialized(false) {}
+
+  /**
+   * @brief Starts the filter at a measured temperature with unknown rate.
+   * @param measurement First temperature reading.
+   */
+  void Reset(float measurement) {
+    temperature = measurement;
+    rate = 0;
+    p00 = 1.0f;
+    p01 = 0;
+    p11 = 1.0f;
+    initialized = true;
+  }
+
+  /**
+   * @brief Marks the filter as uninitialized, e.g. when all sensors are lost.
+   */
+  void Invalidate() {
+    initialized = false;
+  }
+
+  /**
+   * @brief Propagates the state by a time step.
+   * @param dt Time step in seconds.
+   */
+  void Predict(float dt) {
+    if (dt <= 0) return;
+
+    temperature += rate * dt;
+
+    // P = F * P * F^T + Q with F = [1 dt; 0 1]
+    float dt2 = dt * dt;
+    p00 += dt * (2.0f * p01 + dt * p11) + processNoise * dt2 * dt / 3.0f;
+    p01 += dt * p11 + processNoise * dt2 / 2.0f;
+    p11 += processNoise * dt;
+  }
+
+  /**
+   * @brief Corrects the state with a temperature measurement.
+   * @param measurement Temperature reading.
+   * @param variance Measurement noise variance of the sensor.
+   */
+  void Update(float measurement, float variance) {
+    float innovation = measurement - temperature;
+    float s = p00 + variance;
+    float k0 = p00 / s;
+    float k1 = p01 / s;
+
+    temperature += k0 * innovation;
+    rate += k1 * innovation;
+
+    // P = (I - K * H) * P with H = [1 0]
+    p11 -= k1 * p01;
+    p01 -= k0 * p01;
+    p00 -= k0 * p00;
+  }
+
+  /**
+   * @brief Checks if the filter has been started.
+   * @return true after `Reset()`, false initially or after `Invalidate()`.
+   */
+  bool IsInitialized() const {
+    return initialized;
+  }
+
+  /**
+   * @brief Gets the estimated temperature.
+   * @return Filtered temperature.
+   */
+  float GetTemperature() const {
+    return temperature;
+  }
+
+  /**
+   * @brief Gets the estimated rate of change.
+   * @return Temperature rate per second.
+   */
+  float GetRate() const {
+    return rate;
+  }
+};
+
+
+#endif  // FILTER_HX_H
@@ -2,11 +2,13 @@
  * @file globals_hx.cpp
  * @brief Implementation of global variables for the heatX project.
  * @details This file contains the definitions of global variables 
- * used across the heatX project, such as heating values, countdown timers, 
- * and material presets.
+ * used across the heatX project, such as heating values, countdown timers and the run state.
  * 
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Heating values in fixed-point centi-units
+ * - **2026-10-19**: Material presets moved to a constexpr table in `globals_hx.h`
+ * - **2026-10-19**: Added run state
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -25,8 +27,8 @@ HeatingValues actualHeatingValue = { 0, 0 };
 Countdown actualCountdown = { 0, 0 };
 
 HeatingValues targetHeatingValue = {
-  _TEMP_PRESET, /**< Default target temperature. */
-  _HUM_PRESET   /**< Default target humidity. */
+  _TEMP_PRESET * _CENTI, /**< Default target temperature. */
+  _HUM_PRESET * _CENTI   /**< Default target humidity. */
 };
 
 Countdown targetCountdown = {
@@ -34,19 +36,12 @@ Countdown targetCountdown = {
   0             /**< Default target minutes. */
 };
 
-MaterialPreset materialPresets[_MATERIAL_COUNT] = {
-  { "PLA", _PLA_PRESET },   /**< Index 0: PLA preset. */
-  { "PETG", _PETG_PRESET }, /**< Index 1: PETG preset. */
-  { "ASA", _ASA_PRESET },   /**< Index 2: ASA preset. */
-  { "ABS", _ABS_PRESET },   /**< Index 3: ABS preset. */
-  { "PP", _PP_PRESET },     /**< Index 4: PP preset. */
-  { "PA", _PA_PRESET },     /**< Index 5: PA preset. */
-  { "PC", _PC_PRESET },     /**< Index 6: PC preset. */
-  { "TPU", _TPU_PRESET }    /**< Index 7: TPU preset. */
-};
-
-String materialNames[_MATERIAL_COUNT];
+RunState runState = { false, 0 };
 
 float mapFloat(float x, float in_min, float in_max, float out_min, float out_max) {
   return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+int32_t centiToInt(int32_t value) {
+  return (value >= 0) ? (value + _CENTI / 2) / _CENTI : (value - _CENTI / 2) / _CENTI;
 }
\ No newline at end of file
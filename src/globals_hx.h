@@ -5,6 +5,32 @@
  *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Measurements carried as fixed-point centi-units
+ * - **2026-10-19**: Material presets as a constexpr table in flash
+ * - **2026-10-19**: Preset store configuration
+ * - **2026-10-19**: Run state, settings store and serial console configuration
+ * - **2026-10-19**: History store configuration
+ * - **2026-10-19**: Run log configuration
+ * - **2026-10-19**: Telemetry configuration
+ * - **2026-10-19**: Logger configuration
+ * - **2026-10-19**: Trace configuration replaces the logic analyzer pins
+ * - **2026-10-19**: Latency monitor configuration
+ * - **2026-10-19**: Memory monitor configuration, loop task stack size
+ * - **2026-10-19**: Input capture configuration
+ * - **2026-10-19**: I2C bus configuration
+ * - **2026-10-19**: I2C timeouts and bus recovery
+ * - **2026-10-19**: Backlight animation configuration
+ * - **2026-10-19**: Notification configuration
+ * - **2026-10-19**: LCD glyph cache and page configuration
+ * - **2026-10-19**: Material name list moved to `PresetNameList`, one index space with `PresetStore`
+ * - **2026-10-19**: Run log stored as one segment per run
+ * - **2026-10-19**: Shared storage budget of the run log and the capture, capture disabled by default
+ * - **2026-10-19**: Offset tracking of the fallback sensors in the fusion
+ * - **2026-10-19**: Fixed control telemetry interval
+ * - **2026-10-19**: Fixed LEDC channels of the heater and the buzzer on separate timers
+ * - **2026-10-19**: Capture stored as a ring of segments
+ * - **2026-10-19**: History export streamed in chunks
+ * - **2026-10-19**: Trace task table and streamed trace dump
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -32,10 +58,8 @@
  * @{
  */
 #define _PIN_DEBUG_POTI 1  ///< GPIO pin for simulate actual temp
-#define _PIN_DEBUG_CH4 4   ///< GPIO pin for debug with logic analyzer
-#define _PIN_DEBUG_CH5 5   ///< GPIO pin for debug with logic analyzer
-#define _PIN_DEBUG_CH6 6   ///< GPIO pin for debug with logic analyzer
-#define _PIN_DEBUG_CH7 7   ///< GPIO pin for debug with logic analyzer
+
+// #define _DEBUG_POTI_INPUT  ///< Uncomment to feed the PID from the debug poti instead of the sensors
 /** @} */
 
 /** @defgroup PIN_I2C I²C Communication Pins
@@ -98,6 +122,71 @@
 #define _LCD_ADDRESS (0x7c >> 1)
 #define _LCD_ROWS 2   ///< Number of rows on the LCD
 #define _LCD_COLS 16  ///< Number of columns on the LCD
+
+#define _LCD_GLYPH_FIRST 2      ///< First CGRAM slot of the glyph cache, slots 0 and 1 belong to LcdMenu
+#define _LCD_GLYPH_SLOTS 6      ///< Number of CGRAM slots of the glyph cache
+#define _LCD_PAGE_TIME 5000     ///< Time in milliseconds each page is shown
+#define _LCD_SPARKLINE_CELLS 4  ///< Width of the sparklines in characters, five 1 min points each
+#define _LCD_BAR_CELLS 6        ///< Width of the duty bargraphs in characters
+/** @} */
+
+/**
+ * @defgroup I2C_Config I2C Bus Configuration
+ * @brief Clocks and display queue of the I2C bus manager.
+ * @details The ESP32-S3 controller runs SCL at up to 800 kHz, the 1 MHz Fast-mode Plus of the
+ *          backlight controller is out of reach. At 100 kHz a byte takes 90 µs on the bus, longer than
+ *          the AIP31068 needs to write a character, so text is sent as one data stream without pauses.
+ * @{
+ */
+#define _I2C_CLOCK_SENSOR 400000   ///< SCL frequency for the BME280 sensors in Hz
+#define _I2C_CLOCK_LCD 100000      ///< SCL frequency for the AIP31068 text controller in Hz
+#define _I2C_CLOCK_RGB 400000      ///< SCL frequency for the PCA9633 backlight controller in Hz
+#define _I2C_CLOCK_DEFAULT 100000  ///< SCL frequency for devices without an entry in Hz
+#define _I2C_DEVICE_MAX 8          ///< Devices with own statistics, including one slot for all unknown ones
+#define _I2C_BATCH_MAX 16          ///< Maximum size of one display write in bytes, fits the 32 byte FIFO
+#define _I2C_QUEUE_LENGTH 32       ///< Number of display writes waiting for the bus
+#define _I2C_TASK_STACK 2048       ///< Stack size of the worker task in bytes
+#define _I2C_TASK_PRIORITY 1       ///< Priority of the worker task
+
+#define _I2C_TIMEOUT 5                ///< Driver timeout of one transaction in milliseconds
+#define _I2C_LOCK_TIMEOUT 10          ///< Longest wait of a sensor transaction for the bus in milliseconds
+#define _I2C_POST_TIMEOUT 10          ///< Longest wait of a display write for a queue slot in milliseconds
+#define _I2C_RECOVERY_INTERVAL 1000   ///< Interval in milliseconds between recoveries of a stuck bus
+#define _I2C_RECOVERY_HALF_PERIOD 5   ///< Half period of the recovery clock pulses in microseconds
+#define _I2C_TELEMETRY_INTERVAL 1000  ///< Interval in milliseconds between I2C telemetry messages
+/** @} */
+
+/**
+ * @defgroup Backlight_Config Backlight Configuration
+ * @brief Frame rate and transitions of the status colors on the LCD backlight.
+ * @{
+ */
+#define _BACKLIGHT_FRAME_INTERVAL 40  ///< Minimum interval in milliseconds between two backlight frames
+#define _BACKLIGHT_FADE_TIME 500      ///< Duration in milliseconds of the fade to the color of a new state
+/** @} */
+
+/**
+ * @defgroup Notify_Config Notification Configuration
+ * @brief Onboard WS2812 LED and buzzer alerts of the notifier.
+ * @details LEDC channels: the ESP32-S3 has eight channels on four timers, channels 2n and 2n+1
+ *          share timer n and with it the frequency and resolution. `ledcWriteTone()` retunes the
+ *          timer of its channel, so the buzzer must not share a timer with the heater:
+ *          - channel 0, timer 0: heater PWM `_PWM_CHANNEL`, `_PWM_FREQUENCY` at `_PWM_RESOLUTION`
+ *          - channel 1: unused, it would run at the heater frequency
+ *          - channel 2, timer 1: buzzer `_NOTIFY_BUZZER_CHANNEL`, frequency set per tone
+ *          - channel 3: unused, it would follow the buzzer tones
+ *
+ *          Both channels are attached with `ledcAttachChannel()`, independent of the setup order.
+ * @{
+ */
+#define _NOTIFY_RMT_FREQUENCY 10000000  ///< RMT tick frequency in Hz, 100 ns resolution for the WS2812 timing
+#define _NOTIFY_BUZZER_CHANNEL 2        ///< LEDC channel of the buzzer, timer 1 (see `LEDC channels`)
+#define _NOTIFY_BUZZER_FREQUENCY 2000   ///< Initial LEDC frequency of the buzzer in Hz
+#define _NOTIFY_BUZZER_RESOLUTION 10    ///< LEDC resolution of the buzzer in bits
+#define _NOTIFY_QUEUE_LENGTH 4          ///< Number of alerts waiting to be played
+#define _NOTIFY_TASK_STACK 2048         ///< Stack size of the notifier task in bytes
+#define _NOTIFY_TASK_PRIORITY 1         ///< Priority of the notifier task
+#define _NOTIFY_DOOR_DROP 500           ///< Temperature drop below the setpoint in 0.01 °C that counts as an open door
 /** @} */
 
 /**
@@ -132,6 +221,26 @@
 #define _TEMPSENSOR_I2C_ADDRESS_1 0x76   ///< I2C first address for the BME280 sensor
 #define _TEMPSENSOR_I2C_ADDRESS_2 0x77   ///< I2C sec address for the BME280 sensor
 #define _SEALEVELPRESSURE_HPA (1013.25)  ///< Standard sea level pressure in hPa
+
+#define _SENSOR_POLL_INTERVAL 5         ///< Status register polling interval in milliseconds
+#define _SENSOR_TEMP_VALID_MIN (-4000)  ///< Lowest plausible temperature reading in 0.01 °C (BME280 range)
+#define _SENSOR_TEMP_VALID_MAX 8500     ///< Highest plausible temperature reading in 0.01 °C (BME280 range)
+#define _SENSOR_HUM_VALID_MIN 0         ///< Lowest plausible humidity reading in 0.01 %
+#define _SENSOR_HUM_VALID_MAX 10000     ///< Highest plausible humidity reading in 0.01 %
+#define _SENSOR_TEMP_MAX_RATE 500       ///< Highest plausible temperature change in 0.01 °C per second
+#define _SENSOR_SAMPLE_TIMEOUT 500      ///< Time in milliseconds beyond the expected sample period that counts as one missed sample
+#define _SENSOR_MAX_BAD_SAMPLES 3       ///< Consecutive bad or missed samples before the sensor is dropped
+#define _SENSOR_RECONNECT_MIN 500       ///< First reconnect backoff in milliseconds
+#define _SENSOR_RECONNECT_MAX 30000     ///< Upper limit of the reconnect backoff in milliseconds
+
+#define _SENSOR_1_VARIANCE 0.01f     ///< Measurement variance of the spool sensor (address 1) in °C²
+#define _SENSOR_2_VARIANCE 0.04f     ///< Measurement variance of the outlet sensor (address 2) in °C²
+#define _KALMAN_PROCESS_NOISE 0.01f  ///< Spectral density of the temperature rate noise in °C²/s³
+#define _SENSOR_FUSION_MAX 4         ///< Highest number of sensors in one fusion
+#define _SENSOR_OFFSET_GAIN 0.01f    ///< Share of the deviation taken into the offset of a fallback sensor per sample
+
+#define _PROFILE_HOLD_BAND 100    ///< Control error band in 0.01 °C in which the control phase counts as hold
+#define _PROFILE_HOLD_DELAY 60000  ///< Time in milliseconds inside the hold band before switching to the hold profile
 /** @} */
 
 /**
@@ -139,6 +248,7 @@
  * @brief Macros for temperature, humidity, and fan control settings.
  * @{
  */
+#define _PWM_CHANNEL 0                               ///< LEDC channel of the heater, timer 0 (see `LEDC channels`)
 #define _PWM_FREQUENCY 5000                          ///< PWM frequency in Hz
 #define _PWM_RESOLUTION 12                           ///< PWM resolution in bits
 #define _PWM_MAX_VALUE ((1 << _PWM_RESOLUTION) - 1)  ///< Maximum PWM value
@@ -189,22 +299,193 @@
  * @{
  */
 #define _SETUP_DELAY 70  ///< Delay during setup in milliseconds
+
+#define _CENTI 100  ///< Scale of the fixed-point measurement values (0.01 units)
 /** @} */
 
 /**
  * @defgroup Material_Config Material Preset Configuration
  * @brief Temperature presets for different materials.
+ * @details The built-in presets are defined in the `materialPresets` table. At runtime
+ *          `PresetStore` serves the user presets from `_PRESET_FILE_JSON`, if available.
+ * @{
+ */
+#define _PLA_PRESET 50   ///< Preset temperature for PLA (°C)
+#define _PETG_PRESET 60  ///< Preset temperature for PETG (°C)
+#define _ASA_PRESET 65   ///< Preset temperature for ASA (°C)
+#define _ABS_PRESET 70   ///< Preset temperature for ABS (°C)
+#define _PP_PRESET 70    ///< Preset temperature for PP (°C)
+#define _PA_PRESET 70    ///< Preset temperature for PA (°C)
+#define _PC_PRESET 70    ///< Preset temperature for PC (°C)
+#define _TPU_PRESET 50   ///< Preset temperature for TPU (°C)
+
+#define _PRESET_FILE_JSON "/presets.json"  ///< User editable preset file on the FAT partition
+#define _PRESET_FILE_INDEX "/presets.idx"  ///< Binary preset index compiled from the JSON file
+#define _PRESET_MAX_COUNT 32               ///< Maximum number of presets in the preset store
+#define _PRESET_NAME_LENGTH 12             ///< Maximum material name length including the terminator
+/** @} */
+
+/**
+ * @defgroup Settings_Config Settings Configuration
+ * @brief Configuration for the persistent settings and run state.
  * @{
  */
-#define _PLA_PRESET 50     ///< Preset temperature for PLA (°C)
-#define _PETG_PRESET 60    ///< Preset temperature for PETG (°C)
-#define _ASA_PRESET 65     ///< Preset temperature for ASA (°C)
-#define _ABS_PRESET 70     ///< Preset temperature for ABS (°C)
-#define _PP_PRESET 70      ///< Preset temperature for PP (°C)
-#define _PA_PRESET 70      ///< Preset temperature for PA (°C)
-#define _PC_PRESET 70      ///< Preset temperature for PC (°C)
-#define _TPU_PRESET 50     ///< Preset temperature for TPU (°C)
-#define _MATERIAL_COUNT 8  ///< Total number of material presets.
+#define _SETTINGS_NAMESPACE "heatx"         ///< NVS namespace of the settings store
+#define _SETTINGS_SLOTS 4                   ///< Number of NVS slots written round-robin
+#define _SETTINGS_SAVE_DELAY 10000          ///< Minimum time in milliseconds between saves of changed settings
+#define _SETTINGS_RUN_SAVE_INTERVAL 300000  ///< Minimum time in milliseconds between saves of the run progress
+/** @} */
+
+/**
+ * @defgroup Console_Config Serial Console Configuration
+ * @brief Configuration for the serial command console.
+ * @{
+ */
+#define _CONSOLE_LINE_LENGTH 256  ///< Maximum length of a command line including the terminator
+/** @} */
+
+/**
+ * @defgroup History_Config History Configuration
+ * @brief Sizes of the history tiers in PSRAM.
+ * @details The `history` command streams one chunk per loop pass and prints a line only while
+ *          the serial port has `_HISTORY_EXPORT_LINE` bytes free, so the loop never waits for it.
+ * @{
+ */
+#define _HISTORY_1S_POINTS 3600    ///< Points of the 1 s tier (1 hour)
+#define _HISTORY_1MIN_POINTS 4320  ///< Points of the 1 min tier (72 hours)
+#define _HISTORY_15MIN_POINTS 672  ///< Points of the 15 min tier (7 days)
+#define _HISTORY_EXPORT_CHUNK 8    ///< Points per query of the serial export, one query per loop pass
+#define _HISTORY_EXPORT_LINE 128   ///< Free serial transmit space in bytes needed to print a line
+/** @} */
+
+/**
+ * @defgroup Storage_Config Storage Configuration
+ * @brief Space of the recorders on the FAT partition.
+ * @details The partition table app3M_fat9M_16MB leaves about 9.8 MB for the FAT partition. The
+ *          run log and the capture ring must fit into `_STORAGE_BUDGET` together; in addition every
+ *          append checks the free space with `storageFree()`.
+ * @{
+ */
+#define _STORAGE_BUDGET 8000000  ///< Bytes of the FAT partition for the run log and the capture ring
+#define _STORAGE_RESERVE 262144  ///< Free bytes never used by the recorders
+/** @} */
+
+/**
+ * @defgroup RunLog_Config Run Log Configuration
+ * @brief Configuration of the binary run log.
+ * @{
+ */
+// #define _RUNLOG_SD  ///< Uncomment to log to an SD card on SPI2 instead of the FAT partition
+
+#define _RUNLOG_DIR "/runlog"                 ///< Directory with one log file and one index file per run
+#define _RUNLOG_LEGACY_DATA "/runlog.bin"     ///< Log file of the single-file layout, kept as the oldest segment
+#define _RUNLOG_LEGACY_INDEX "/runlog.idx"    ///< Index file of the single-file layout
+#define _RUNLOG_BLOCK_SIZE 4096               ///< Size of one block buffer in bytes
+#define _RUNLOG_FLUSH_INTERVAL 60000          ///< Maximum age of an unwritten block in milliseconds
+#define _RUNLOG_MAX_SIZE 5000000              ///< Size of all runs in bytes, the oldest runs are deleted beyond
+#define _RUNLOG_TASK_STACK 4096               ///< Stack size of the writer task in bytes
+#define _RUNLOG_TASK_PRIORITY 1               ///< Priority of the writer task
+/** @} */
+
+/**
+ * @defgroup Capture_Config Input Capture Configuration
+ * @brief Configuration of the input capture for the host replayer.
+ * @details Without `_CAPTURE_ENABLED` the inputs are read without recording. To record a
+ *          failing run, uncomment `_CAPTURE_ENABLED`, flash the firmware and run the dryer
+ *          until the fault. The capture is a ring of segments in `_CAPTURE_DIR` that keeps the
+ *          most recent `_CAPTURE_MAX_SIZE` bytes across resets, about 1.5 hours in the fast
+ *          profile and 20 hours in the hold profile. Copy the segments from the FAT partition
+ *          and pass them in order to `tools/replay/hx_replay`.
+ * @{
+ */
+// #define _CAPTURE_ENABLED  ///< Uncomment to record the inputs for the host replayer
+
+#define _CAPTURE_DIR "/capture"                      ///< Directory with the segments of the ring
+#define _CAPTURE_LEGACY_FILE "/capture.hxc"          ///< Capture of the former single-file layout
+#define _CAPTURE_LEGACY_FILE_OLD "/capture.old.hxc"  ///< Previous capture of the single-file layout
+#define _CAPTURE_BLOCK_SIZE 2048                     ///< Size of one block buffer in bytes
+#define _CAPTURE_FLUSH_INTERVAL 10000                ///< Maximum age of an unwritten block in ms
+#define _CAPTURE_SEGMENT_SIZE 262144                 ///< Size of a segment in bytes, starts with a keyframe
+#define _CAPTURE_SEGMENTS 11                         ///< Number of segments in the ring
+#define _CAPTURE_MAX_SIZE 2883584                    ///< Size of the ring in bytes, all segments
+#define _CAPTURE_DEVICES 4                           ///< Number of I2C devices kept for keyframes
+#define _CAPTURE_PIN_COUNT 49                        ///< Number of GPIOs tracked for changes
+#define _CAPTURE_I2C_SLOTS 8                         ///< Number of I2C reads tracked for changes
+#define _CAPTURE_TASK_STACK 3072                     ///< Stack size of the writer task in bytes
+#define _CAPTURE_TASK_PRIORITY 1                     ///< Priority of the writer task
+/** @} */
+
+static_assert(_CAPTURE_MAX_SIZE == _CAPTURE_SEGMENTS * _CAPTURE_SEGMENT_SIZE, "Capture ring size mismatch");
+#if !defined(_RUNLOG_SD)
+static_assert(_RUNLOG_MAX_SIZE + _CAPTURE_MAX_SIZE <= _STORAGE_BUDGET, "Recorders exceed the storage budget");
+#endif
+
+/**
+ * @defgroup Telemetry_Config Telemetry Configuration
+ * @brief Configuration of the binary telemetry stream.
+ * @{
+ */
+// #define _TELEMETRY_AUTOSTART  ///< Uncomment to send telemetry from boot instead of after "telemetry on"
+
+#define _TELEMETRY_CONTROL_INTERVAL 20  ///< Interval in milliseconds between control messages (50 Hz)
+#define _TELEMETRY_QUEUE_LENGTH 16      ///< Number of frames waiting for transmission
+#define _TELEMETRY_TASK_STACK 2048      ///< Stack size of the transmit task in bytes
+#define _TELEMETRY_TASK_PRIORITY 1      ///< Priority of the transmit task
+/** @} */
+
+/**
+ * @defgroup Log_Config Logger Configuration
+ * @brief Configuration of the asynchronous logger.
+ * @details Log calls above `_LOG_LEVEL` are removed at compile time.
+ * @{
+ */
+#define _LOG_LEVEL_NONE 0   ///< No log output
+#define _LOG_LEVEL_ERROR 1  ///< Errors only
+#define _LOG_LEVEL_WARN 2   ///< Errors and warnings
+#define _LOG_LEVEL_INFO 3   ///< Errors, warnings and information
+#define _LOG_LEVEL_DEBUG 4  ///< All messages
+
+#define _LOG_LEVEL _LOG_LEVEL_INFO  ///< Highest level compiled in
+
+#define _LOG_MAX_ARGS 4       ///< Maximum number of arguments of a log call
+#define _LOG_RING_SIZE 64     ///< Number of records in the ring buffer, a power of two
+#define _LOG_LINE_LENGTH 128  ///< Maximum length of a formatted line
+#define _LOG_TASK_PERIOD 20   ///< Period of the formatting task in milliseconds
+#define _LOG_TASK_STACK 3072  ///< Stack size of the formatting task in bytes
+#define _LOG_TASK_PRIORITY 1  ///< Priority of the formatting task
+/** @} */
+
+/**
+ * @defgroup Trace_Config Trace Configuration
+ * @brief Configuration of the cycle trace recorder.
+ * @details Without `_TRACE_ENABLED` the `HX_TRACE_*` macros compile to nothing.
+ * @{
+ */
+// #define _TRACE_ENABLED  ///< Uncomment to record trace events
+
+#define _TRACE_RING_SIZE 512  ///< Number of events per core, a power of two
+#define _TRACE_TASKS 8        ///< Tasks told apart in the events, later tasks share one number
+#define _TRACE_DUMP_CHUNK 16  ///< Lines of a trace dump printed per loop pass
+#define _TRACE_DUMP_LINE 48   ///< Free serial transmit space in bytes needed to print a line
+/** @} */
+
+/**
+ * @defgroup Latency_Config Latency Monitor Configuration
+ * @brief Configuration of the latency histograms.
+ * @{
+ */
+#define _LATENCY_SUB_BUCKET_BITS 3        ///< Linear buckets per power of two as bits, sets the resolution
+#define _LATENCY_TELEMETRY_INTERVAL 1000  ///< Interval in milliseconds between latency telemetry messages
+/** @} */
+
+/**
+ * @defgroup Memory_Config Memory Monitor Configuration
+ * @brief Stack budget of the loop task and configuration of the memory monitor.
+ * @{
+ */
+#define _LOOP_TASK_STACK (16 * 1024)  ///< Stack size of the Arduino loop task in bytes
+#define _MEMORY_CHECK_INTERVAL 10000  ///< Interval in milliseconds between allocation and stack checks
+#define _MEMORY_STACK_MARGIN 512      ///< Stack headroom in bytes below which a task is reported
 /** @} */
 
 /**
@@ -222,6 +503,13 @@ enum enumHeatMode {
   HUM_CONTROL    ///< Mode for humidity control.
 };
 
+/** Drying profiles of the material presets. */
+enum enumDryingProfile {
+  DRYING_STANDARD,    ///< Direct ramp to the preset temperature.
+  DRYING_GENTLE,      ///< Slow ramp for materials with a low glass transition temperature.
+  DRYING_HYGROSCOPIC  ///< Long drying for strongly hygroscopic materials.
+};
+
 /** Menu states for the user interface. */
 enum enumMenuState {
   MENU_HOME,      ///< Home page.
@@ -239,22 +527,24 @@ typedef struct {
 
 /**
  * @brief Holds data from the BME280 sensor.
+ * @details All values are fixed-point in 0.01 units (`_CENTI`) to keep the full sensor resolution.
  */
 typedef struct {
-  float temperature;  ///< Current temperature reading (°C).
-  float humidity;     ///< Current humidity reading (%).
-  float press;        ///< Current pressure reading (hPa).
-  float altitude;     ///< Current altitude reading (meters).
-  bool isActive;      ///< Status flag indicating if the sensor is active.
+  int32_t temperature;  ///< Current temperature reading (0.01 °C).
+  int32_t humidity;     ///< Current humidity reading (0.01 %).
+  int32_t press;        ///< Current pressure reading (0.01 hPa).
+  int32_t altitude;     ///< Current altitude reading (0.01 meters).
+  bool isActive;        ///< Status flag indicating if the sensor is active.
 } SensorData;
 
 
 /**
  * @brief Contains target values for heating and humidity control.
+ * @details Values are fixed-point in 0.01 units (`_CENTI`); round with `centiToInt()` for display only.
  */
 typedef struct {
-  int temperature;  ///< Target temperature (°C).
-  int humidity;     ///< Target humidity (%).
+  int32_t temperature;  ///< Target temperature (0.01 °C).
+  int32_t humidity;     ///< Target humidity (0.01 %).
 } HeatingValues;
 
 /**
@@ -265,12 +555,23 @@ typedef struct {
   int minutes;  ///< Countdown minutes.
 } Countdown;
 
+/**
+ * @brief Represents the state of a drying run.
+ */
+typedef struct {
+  bool running;             ///< True while a run is active.
+  uint32_t elapsedSeconds;  ///< Heating time of the run so far (s).
+} RunState;
+
 /**
  * @brief Represents a material preset for heating configuration.
  */
 typedef struct {
-  const char *name;  ///< Material name (e.g., "PLA", "ABS").
-  int value;         ///< Preset temperature value (°C).
+  const char *name;           ///< Material name (e.g., "PLA", "ABS").
+  int16_t temperature;        ///< Preset temperature value (°C).
+  uint8_t humidity;           ///< Preset target humidity (%).
+  uint8_t hours;              ///< Default drying time (hours).
+  enumDryingProfile profile;  ///< Drying profile.
 } MaterialPreset;
 
 /**
@@ -297,9 +598,17 @@ extern HeatingValues targetHeatingValue;
  */
 extern Countdown targetCountdown;
 
+/**
+ * @brief Tracks the active drying run.
+ * @details Persisted by the settings store, so an interrupted run resumes after a power loss.
+ */
+extern RunState runState;
+
 /**
  * @brief Array of material presets for heating profiles.
  * @details Each entry contains a material name and its corresponding heating preset values.
+ *          The table is `constexpr` data in flash: it needs no RAM and no copy at startup.
+ *          To add a material, append a line here; `_MATERIAL_COUNT` follows automatically.
  *
  * ### Materials:
  * - `"PLA"`: Preset for PLA material.
@@ -311,13 +620,44 @@ extern Countdown targetCountdown;
  * - `"PC"`: Preset for PC material.
  * - `"TPU"`: Preset for TPU material.
  */
-extern MaterialPreset materialPresets[_MATERIAL_COUNT];
+inline constexpr MaterialPreset materialPresets[] = {
+  { "PLA", _PLA_PRESET, 20, 4, DRYING_GENTLE },     /**< Index 0: PLA preset. */
+  { "PETG", _PETG_PRESET, 15, 4, DRYING_STANDARD }, /**< Index 1: PETG preset. */
+  { "ASA", _ASA_PRESET, 15, 4, DRYING_STANDARD },   /**< Index 2: ASA preset. */
+  { "ABS", _ABS_PRESET, 15, 4, DRYING_STANDARD },   /**< Index 3: ABS preset. */
+  { "PP", _PP_PRESET, 15, 6, DRYING_STANDARD },     /**< Index 4: PP preset. */
+  { "PA", _PA_PRESET, 10, 8, DRYING_HYGROSCOPIC },  /**< Index 5: PA preset. */
+  { "PC", _PC_PRESET, 10, 8, DRYING_HYGROSCOPIC },  /**< Index 6: PC preset. */
+  { "TPU", _TPU_PRESET, 15, 5, DRYING_GENTLE }      /**< Index 7: TPU preset. */
+};
+
+/** Total number of material presets. */
+#define _MATERIAL_COUNT (sizeof(materialPresets) / sizeof(materialPresets[0]))
+
+static_assert(_MATERIAL_COUNT <= UINT8_MAX, "Material index must fit into uint8_t");
+
+/**
+ * @brief Compares two material names at compile time.
+ * @param a First name.
+ * @param b Second name.
+ * @return true if both names are equal.
+ */
+constexpr bool materialNameEquals(const char *a, const char *b) {
+  return (*a == *b) && (*a == '\0' || materialNameEquals(a + 1, b + 1));
+}
 
 /**
- * @brief Array of material names derived from `materialPresets`.
- * @details This array is populated for use in an LCD item list, containing the names of all supported materials.
+ * @brief Looks up a material preset by name.
+ * @details Usable at compile time, e.g. `constexpr int pla = findMaterialPreset("PLA");`.
+ * @param name Material name, case sensitive.
+ * @return Index into `materialPresets`, or -1 if the name is unknown.
  */
-extern String materialNames[_MATERIAL_COUNT];
+constexpr int findMaterialPreset(const char *name) {
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    if (materialNameEquals(materialPresets[i].name, name)) return (int)i;
+  }
+  return -1;
+}
 
 /**
  * @brief Maps a float value from one range to another.
@@ -332,5 +672,15 @@ extern String materialNames[_MATERIAL_COUNT];
  */
 float mapFloat(float x, float in_min, float in_max, float out_min, float out_max);
 
+/**
+ * @brief Rounds a fixed-point value in 0.01 units to the nearest integer.
+ * @details Rounds half away from zero. Intended for display formatting only, all other
+ *          code should keep the fixed-point value.
+ *
+ * @param value Fixed-point value in 0.01 units.
+ * @return The rounded integer value.
+ */
+int32_t centiToInt(int32_t value);
+
 
 #endif  // GLOBALS_HX_H
\ No newline at end of file
@@ -5,6 +5,7 @@
  *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Debug pins removed, replaced by the trace recorder
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -19,18 +20,6 @@
 #include "gpio_hx.h"
 #include "globals_hx.h"
 
-void setupDebug() {
-  pinMode(_PIN_DEBUG_CH4, OUTPUT);
-  pinMode(_PIN_DEBUG_CH5, OUTPUT);
-  pinMode(_PIN_DEBUG_CH6, OUTPUT);
-  pinMode(_PIN_DEBUG_CH7, OUTPUT);
-
-  digitalWrite(_PIN_DEBUG_CH4, LOW);
-  digitalWrite(_PIN_DEBUG_CH5, LOW);
-  digitalWrite(_PIN_DEBUG_CH6, LOW);
-  digitalWrite(_PIN_DEBUG_CH7, LOW);
-}
-
 void setupSerial() {
   Serial.begin(_SERIAL_BAUD);
   delay(_SETUP_DELAY);
@@ -7,6 +7,8 @@
  * 
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Added `GpioOffDelay::isOn()`
+ * - **2026-10-19**: Inputs and time read through the capture port `input_hx.h`
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -22,12 +24,7 @@
 #define GPIO_HX_H
 
 #include <Arduino.h>
-
-/**
- * @brief Initializes debug pins for output and sets them to LOW.
- * @details Configures GPIO debug pins for use with a logic analyzer.
- */
-void setupDebug();
+#include "input_hx.h"
 
 /**
  * @brief Initializes the serial communication interface.
@@ -99,8 +96,8 @@ public:
    *          duration has elapsed.
    */
   void update() {
-    int readButtonState = digitalRead(pin);  // Read the button state
-    unsigned long currentMillis = millis();
+    int readButtonState = readInputPin(pin);  // Read the button state
+    unsigned long currentMillis = loopMillis();
 
     // Check for a state change
     if (readButtonState != lastButtonState) {
@@ -180,11 +177,11 @@ public:
       isOffDelayActive = false;  // Reset delay flag
     } else {
       if (!isOffDelayActive) {
-        offStartTime = millis();  // Save the time when off delay starts
-        isOffDelayActive = true;  // Set the delay flag
+        offStartTime = loopMillis();  // Save the time when off delay starts
+        isOffDelayActive = true;      // Set the delay flag
       }
       // Check if the off delay time has elapsed
-      if (isOffDelayActive && (millis() - offStartTime >= offDelayTime)) {
+      if (isOffDelayActive && (loopMillis() - offStartTime >= offDelayTime)) {
         digitalWrite(pin, LOW);    // Turn the GPIO pin off
         isOffDelayActive = false;  // Reset delay flag
       }
@@ -198,6 +195,14 @@ public:
   void control(bool state) {
     powerOn = state;
   }
+
+  /**
+   * @brief Checks if the GPIO pin is on, including the off delay.
+   * @return true if the pin is driven high.
+   */
+  bool isOn() const {
+    return powerOn || isOffDelayActive;
+  }
 };
 
 
@@ -1,10 +1,14 @@
 /**
  * @file heating_hx.cpp
- * @brief ...
- * @details ...
+ * @brief Implementation of the heater control.
+ * @details Contains the PID, heater output and fan handling of `HeatingController` and the
+ *          run timing of `RunTimer`.
  * 
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Implementation of `HeatingController`
+ * - **2026-10-19**: Implementation of `RunTimer`
+ * - **2026-10-19**: Float PID input
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -17,4 +21,73 @@
  */
 
 #include "heating_hx.h"
-#include "globals_hx.h"
\ No newline at end of file
+#include "globals_hx.h"
+#include "input_hx.h"
+
+HeatingController::HeatingController(PID_heatX &pidHeating, GpioOffDelay &fanCirculation,
+                                     GpioOffDelay &fanHeater, uint8_t heaterPin)
+  : pid(pidHeating), fan(fanCirculation), fanHeat(fanHeater), pin(heaterPin), enabled(false) {}
+
+void HeatingController::setInput(float temperature, float rate, int32_t setpoint) {
+  pid.SetInput(temperature, rate);
+  pid.SetSetpoint((float)setpoint / _CENTI);
+}
+
+bool HeatingController::control(bool enable) {
+  bool heatingIsOn = (pid.GetOutput() > 0.0);
+  bool written = false;
+
+  enabled = enable;
+  if (enabled) {
+    pid.SetMode(1);  // 1 = Automatic --> On
+    if (pid.Compute()) {
+      ledcWrite(pin, pid.GetOutput());
+      written = true;
+    }
+  } else {
+    ledcWrite(pin, 0);
+    heatingIsOn = false;
+    pid.SetMode(0);  // 0 = Manual --> Off
+  }
+  fan.control(heatingIsOn);
+  fanHeat.control(heatingIsOn);
+  return written;
+}
+
+int32_t HeatingController::getDuty() const {
+  // The PID output is stale while the heater is off
+  return enabled ? lroundf(pid.GetOutput() * 100 * _CENTI / _PWM_MAX_VALUE) : 0;
+}
+
+RunTimer::RunTimer()
+  : lastTick(0), started(false) {}
+
+bool RunTimer::update(RunState &run, bool start, bool stop, bool counting, uint32_t targetSeconds) {
+  unsigned long now = loopMillis();
+  if (!started) {
+    lastTick = now;
+    started = true;
+  }
+
+  if (start && !run.running) {
+    run.running = true;
+    run.elapsedSeconds = 0;
+  }
+  if (stop) {
+    run.running = false;
+  }
+
+  // Only time with valid sensor data counts as drying time
+  while (now - lastTick >= 1000) {
+    lastTick += 1000;
+    if (run.running && counting) {
+      run.elapsedSeconds++;
+    }
+  }
+
+  if (run.running && run.elapsedSeconds >= targetSeconds) {
+    run.running = false;
+    return true;
+  }
+  return false;
+}
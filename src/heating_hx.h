@@ -1,10 +1,17 @@
 /**
  * @file heating_hx.h
- * @brief ...
- * @details ...
- * 
+ * @brief Heater control: PID, heater output, fans and run timer.
+ * @details This file contains the `HeatingController` class, which drives the heater PWM from
+ *          the temperature PID and switches the fans with the heater, and the `RunTimer` class,
+ *          which counts the drying time of a run. They hold the logic that ran in
+ *          `controlHeating()` and `updateRunState()` of the sketch, so the firmware, the host
+ *          simulation in `tools/sim` and the replayer in `tools/replay` execute the same code.
+ *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Added `HeatingController`, moved from `controlHeating()` of the sketch
+ * - **2026-10-19**: Added `RunTimer`, moved from `updateRunState()` of the sketch
+ * - **2026-10-19**: PID input taken from the filter state in °C without a fixed-point round trip
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -19,6 +26,116 @@
 #ifndef HEATING_HX_H
 #define HEATING_HX_H
 
+#include <Arduino.h>
+#include "globals_hx.h"
+#include "gpio_hx.h"
+#include "pid_hx.h"
+
+/**
+ * @brief Heater control with the temperature PID and the fans.
+ * @details `control()` is called after every new sensor sample. While heating is enabled the
+ *          PID runs in automatic mode and its output is written to the heater PWM when it was
+ *          computed. While heating is disabled the heater is off and the PID is in manual
+ *          mode. The fans follow the heater, their off-delay is handled by `GpioOffDelay`.
+ *
+ * ### Example Usage
+ * ```cpp
+ * HeatingController heating(pidHeating, fan, fanHeat, _PIN_HEAT);
+ *
+ * void onSample() {
+ *   heating.setInput(sensorFusion.getTemperature(), sensorFusion.getTemperatureRate(), setpoint);
+ *   heating.control(runState.running && sensorFusion.isActive());
+ * }
+ * ```
+ */
+class HeatingController {
+private:
+  PID_heatX &pid;        /**< Temperature PID. */
+  GpioOffDelay &fan;     /**< Circulation fan. */
+  GpioOffDelay &fanHeat; /**< Fan of the heater. */
+  const uint8_t pin;     /**< PWM pin of the heater. */
+  bool enabled;          /**< Heating enabled in the last `control()` call. */
+
+public:
+  /**
+   * @brief Constructor to initialize the controller with heating disabled.
+   * @param pidHeating Temperature PID, limits and sample time are set by the caller.
+   * @param fanCirculation Circulation fan.
+   * @param fanHeater Fan of the heater.
+   * @param heaterPin PWM pin of the heater, attached by the caller.
+   */
+  HeatingController(PID_heatX &pidHeating, GpioOffDelay &fanCirculation, GpioOffDelay &fanHeater,
+                    uint8_t heaterPin);
+
+  /**
+   * @brief Passes a sample and the setpoint to the PID.
+   * @details The filter and the PID both run in °C on the FPU, so the estimate is passed in
+   *          single precision without rounding; only the setpoint is converted here.
+   * @param temperature Temperature in °C, e.g. `SensorFusion::getTemperature()`.
+   * @param rate Temperature rate in °C per second.
+   * @param setpoint Setpoint in 0.01 °C.
+   */
+  void setInput(float temperature, float rate, int32_t setpoint);
+
+  /**
+   * @brief Runs the PID and updates the heater and the fans.
+   * @param enable True if heating is allowed, i.e. a run is active and the sensor data is valid.
+   * @return True if a new PID output was written to the heater.
+   */
+  bool control(bool enable);
+
+  /**
+   * @brief Gets the heater duty.
+   * @return Duty in 0.01 %, 0 while heating is disabled.
+   */
+  int32_t getDuty() const;
+
+  /**
+   * @brief Checks whether heating was enabled in the last `control()` call.
+   * @return True if enabled.
+   */
+  bool isEnabled() const {
+    return enabled;
+  }
+};
+
+/**
+ * @brief Starts, stops and times a drying run.
+ * @details `update()` is called once per loop pass. Only seconds in which the sensor data is
+ *          valid count as drying time; the run ends when the countdown target is reached.
+ *
+ * ### Example Usage
+ * ```cpp
+ * RunTimer runTimer;
+ *
+ * void loop() {
+ *   runTimer.update(runState, buttonStart.isPressed(), buttonStop.isPressed(),
+ *                   sensorFusion.isActive(), targetSeconds);
+ * }
+ * ```
+ */
+class RunTimer {
+private:
+  unsigned long lastTick; /**< Time of the last counted second (ms). */
+  bool started;           /**< True after the first `update()`. */
+
+public:
+  /**
+   * @brief Constructor: the seconds are counted from the first `update()`.
+   */
+  RunTimer();
+
+  /**
+   * @brief Applies the buttons and counts the elapsed seconds.
+   * @param run Run state, updated in place.
+   * @param start True while the start button is pressed; starts a new run if none is active.
+   * @param stop True while the stop button is pressed; stops the run.
+   * @param counting True if the elapsed time counts, i.e. the sensor data is valid.
+   * @param targetSeconds Drying time after which the run ends.
+   * @return True if the run ended because the target was reached.
+   */
+  bool update(RunState &run, bool start, bool stop, bool counting, uint32_t targetSeconds);
+};
 
 
-#endif //HEATING_HX_H
\ No newline at end of file
+#endif //HEATING_HX_H
@@ -0,0 +1,161 @@
+/**
+ * @file history_hx.cpp
+ * @brief Implementation of the tiered time-series store.
+ * @details Contains the column allocation, the rollup cascade and the range query of
+ *          `HistoryStore`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "history_hx.h"
+#include "log_hx.h"
+
+#include <esp_heap_caps.h>
+
+static const uint32_t tierResolutions[HISTORY_TIER_COUNT] = { 1, 60, 900 };
+static const uint32_t tierCapacities[HISTORY_TIER_COUNT] = {
+  _HISTORY_1S_POINTS, _HISTORY_1MIN_POINTS, _HISTORY_15MIN_POINTS
+};
+
+HistoryStore::HistoryStore()
+  : ready(false) {
+  memset(tiers, 0, sizeof(tiers));
+  for (uint8_t t = 0; t < HISTORY_TIER_COUNT; t++) {
+    tiers[t].resolution = tierResolutions[t];
+    tiers[t].capacity = tierCapacities[t];
+  }
+}
+
+bool HistoryStore::begin() {
+  if (ready) {
+    return true;
+  }
+
+  // One block per tier: the time column followed by the value columns
+  for (uint8_t t = 0; t < HISTORY_TIER_COUNT; t++) {
+    Tier &tier = tiers[t];
+    size_t columnBytes = tier.capacity * sizeof(int16_t);
+    size_t bytes = tier.capacity * sizeof(uint32_t) + 3 * HISTORY_CHANNEL_COUNT * columnBytes;
+    uint8_t *block = (uint8_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (block == nullptr) {
+      HX_LOG_ERROR("History: %u bytes of PSRAM not available", (unsigned)bytes);
+      for (uint8_t i = 0; i < t; i++) {
+        heap_caps_free(tiers[i].time);
+        tiers[i].time = nullptr;
+      }
+      return false;
+    }
+
+    tier.time = (uint32_t *)block;
+    int16_t *column = (int16_t *)(block + tier.capacity * sizeof(uint32_t));
+    for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+      tier.min[c] = column;
+      tier.max[c] = column + tier.capacity;
+      tier.mean[c] = column + 2 * tier.capacity;
+      column += 3 * tier.capacity;
+    }
+  }
+  ready = true;
+  return true;
+}
+
+void HistoryStore::add(uint32_t seconds, const int16_t *values) {
+  if (!ready) {
+    return;
+  }
+  int64_t sum[HISTORY_CHANNEL_COUNT];
+  for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+    sum[c] = values[c];
+  }
+  accumulate(HISTORY_1S, seconds / tiers[HISTORY_1S].resolution, values, values, sum, 1);
+}
+
+void HistoryStore::accumulate(uint8_t tier, uint32_t bucket, const int16_t *min, const int16_t *max,
+                              const int64_t *sum, uint32_t count) {
+  Accumulator &open = tiers[tier].open;
+  if (open.count > 0 && open.bucket != bucket) {
+    close(tier);
+  }
+
+  if (open.count == 0) {
+    open.bucket = bucket;
+    for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+      open.min[c] = min[c];
+      open.max[c] = max[c];
+      open.sum[c] = 0;
+    }
+  }
+  for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+    if (min[c] < open.min[c]) open.min[c] = min[c];
+    if (max[c] > open.max[c]) open.max[c] = max[c];
+    open.sum[c] += sum[c];
+  }
+  open.count += count;
+}
+
+void HistoryStore::close(uint8_t t) {
+  Tier &tier = tiers[t];
+  Accumulator &open = tier.open;
+
+  uint32_t i = tier.head;
+  tier.time[i] = open.bucket * tier.resolution;
+  for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+    tier.min[c][i] = open.min[c];
+    tier.max[c][i] = open.max[c];
+    tier.mean[c][i] = open.sum[c] / (int64_t)open.count;
+  }
+  tier.head = (tier.head + 1) % tier.capacity;
+  if (tier.size < tier.capacity) tier.size++;
+
+  // Sum and count are passed on, so the coarse means are weighted by the samples
+  if (t + 1 < HISTORY_TIER_COUNT) {
+    uint32_t bucket = tier.time[i] / tiers[t + 1].resolution;
+    accumulate(t + 1, bucket, open.min, open.max, open.sum, open.count);
+  }
+  open.count = 0;
+}
+
+uint32_t HistoryStore::physical(const Tier &tier, uint32_t index) const {
+  return (tier.head + tier.capacity - tier.size + index) % tier.capacity;
+}
+
+size_t HistoryStore::query(enumHistoryTier t, uint32_t from, uint32_t to, HistoryPoint *points, size_t maxPoints) const {
+  if (!ready || t >= HISTORY_TIER_COUNT) {
+    return 0;
+  }
+  const Tier &tier = tiers[t];
+
+  // First point with time >= from, the ring is sorted by time
+  uint32_t low = 0;
+  uint32_t high = tier.size;
+  while (low < high) {
+    uint32_t mid = (low + high) / 2;
+    if (tier.time[physical(tier, mid)] < from) low = mid + 1;
+    else high = mid;
+  }
+
+  size_t count = 0;
+  for (uint32_t index = low; index < tier.size && count < maxPoints; index++) {
+    uint32_t i = physical(tier, index);
+    if (tier.time[i] > to) {
+      break;
+    }
+    HistoryPoint &point = points[count++];
+    point.time = tier.time[i];
+    for (uint8_t c = 0; c < HISTORY_CHANNEL_COUNT; c++) {
+      point.values[c] = { tier.min[c][i], tier.max[c][i], tier.mean[c][i] };
+    }
+  }
+  return count;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file history_hx.h
+ * @brief Tiered time-series store for the run history.
+ * @details This file contains the `HistoryStore` class, which keeps the history of the
+ *          measured and controlled values in column ring buffers in PSRAM, rolled up to
+ *          several resolutions.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HISTORY_HX_H
+#define HISTORY_HX_H
+
+#include <Arduino.h>
+#include "globals_hx.h"
+
+/**
+ * @brief Recorded channels, all in 0.01 units.
+ */
+enum enumHistoryChannel {
+  HISTORY_TEMPERATURE,   ///< Fused temperature (0.01 °C).
+  HISTORY_HUMIDITY,      ///< Relative humidity (0.01 %).
+  HISTORY_DUTY,          ///< Heater duty cycle (0.01 %).
+  HISTORY_SETPOINT,      ///< Target temperature (0.01 °C).
+  HISTORY_FAN,           ///< Fan on time (0.01 %).
+  HISTORY_CHANNEL_COUNT  ///< Number of channels.
+};
+
+/**
+ * @brief Resolutions of the history.
+ */
+enum enumHistoryTier {
+  HISTORY_1S,         ///< One point per second.
+  HISTORY_1MIN,       ///< One point per minute.
+  HISTORY_15MIN,      ///< One point per 15 minutes.
+  HISTORY_TIER_COUNT  ///< Number of tiers.
+};
+
+/**
+ * @brief Rollup of one channel over one point interval.
+ */
+typedef struct {
+  int16_t min;   ///< Smallest sample.
+  int16_t max;   ///< Largest sample.
+  int16_t mean;  ///< Mean of all samples.
+} HistoryStat;
+
+/**
+ * @brief One point of a history query.
+ */
+typedef struct {
+  uint32_t time;                              ///< Start of the interval (s since boot).
+  HistoryStat values[HISTORY_CHANNEL_COUNT];  ///< Rollup per channel.
+} HistoryPoint;
+
+/**
+ * @brief Time-series store with automatic min/max/mean rollups.
+ * @details Samples are aggregated into 1 s points, which are rolled up into 1 min points,
+ *          which are rolled up into 15 min points. Each tier is a ring buffer of fixed size,
+ *          stored as separate columns (time, and min, max and mean per channel), so a query
+ *          reads only the memory it returns. With the default sizes the 1 s tier holds the
+ *          last hour, the 1 min tier the last 72 hours and the 15 min tier the last week,
+ *          in about 290 KB of PSRAM.
+ *
+ *          Adding a sample is O(1) and never allocates. A range query finds its first point
+ *          with a binary search over the time column and then copies the requested points.
+ *          The store is not locked: samples are added and queries are made from the loop task.
+ *
+ *          If no PSRAM is available, `begin()` fails and the store stays empty.
+ *
+ * ### Example Usage
+ * ```cpp
+ * HistoryStore history;
+ *
+ * void setup() {
+ *   history.begin();
+ * }
+ *
+ * void loop() {
+ *   int16_t sample[HISTORY_CHANNEL_COUNT] = { temperature, humidity, duty, setpoint, fan };
+ *   history.add(millis() / 1000, sample);
+ *
+ *   HistoryPoint points[10];
+ *   size_t count = history.query(HISTORY_1MIN, 0, UINT32_MAX, points, 10);
+ * }
+ * ```
+ */
+class HistoryStore {
+private:
+  /**
+   * @brief Open point of a tier that is still being aggregated.
+   */
+  struct Accumulator {
+    uint32_t bucket;                    /**< Index of the interval (time / resolution). */
+    uint32_t count;                     /**< Number of samples, 0 if empty. */
+    int16_t min[HISTORY_CHANNEL_COUNT]; /**< Smallest sample per channel. */
+    int16_t max[HISTORY_CHANNEL_COUNT]; /**< Largest sample per channel. */
+    int64_t sum[HISTORY_CHANNEL_COUNT]; /**< Sum of the samples per channel. */
+  };
+
+  /**
+   * @brief Column ring buffer of one resolution.
+   */
+  struct Tier {
+    uint32_t resolution;                  /**< Interval of one point (s). */
+    uint32_t capacity;                    /**< Maximum number of points. */
+    uint32_t head;                        /**< Index of the next point to write. */
+    uint32_t size;                        /**< Number of stored points. */
+    uint32_t *time;                       /**< Column of interval starts. */
+    int16_t *min[HISTORY_CHANNEL_COUNT];  /**< Columns of the minimums. */
+    int16_t *max[HISTORY_CHANNEL_COUNT];  /**< Columns of the maximums. */
+    int16_t *mean[HISTORY_CHANNEL_COUNT]; /**< Columns of the means. */
+    Accumulator open;                     /**< Point being aggregated. */
+  };
+
+  Tier tiers[HISTORY_TIER_COUNT]; /**< All tiers, finest first. */
+  bool ready;                     /**< True if the columns are allocated. */
+
+  void accumulate(uint8_t tier, uint32_t bucket, const int16_t *min, const int16_t *max,
+                  const int64_t *sum, uint32_t count);
+  void close(uint8_t tier);
+  uint32_t physical(const Tier &tier, uint32_t index) const;
+
+public:
+  /**
+   * @brief Constructor: Initializes an empty store without memory.
+   */
+  HistoryStore();
+
+  /**
+   * @brief Allocates the columns in PSRAM.
+   * @return true if the memory is available.
+   */
+  bool begin();
+
+  /**
+   * @brief Adds a sample of all channels.
+   * @param seconds Sample time (s since boot), must not decrease.
+   * @param values One value per channel, see `enumHistoryChannel`.
+   */
+  void add(uint32_t seconds, const int16_t *values);
+
+  /**
+   * @brief Copies the stored points of a time range, oldest first.
+   * @details Points still being aggregated are not returned.
+   * @param tier Resolution to read.
+   * @param from First interval start to return (s since boot).
+   * @param to Last interval start to return (s since boot).
+   * @param points Destination.
+   * @param maxPoints Capacity of `points`.
+   * @return Number of points copied.
+   */
+  size_t query(enumHistoryTier tier, uint32_t from, uint32_t to, HistoryPoint *points, size_t maxPoints) const;
+
+  /**
+   * @brief Gets the number of stored points of a tier.
+   * @param tier Resolution.
+   * @return Number of points.
+   */
+  size_t size(enumHistoryTier tier) const {
+    return tiers[tier].size;
+  }
+
+  /**
+   * @brief Gets the interval of one point of a tier.
+   * @param tier Resolution.
+   * @return Interval in seconds.
+   */
+  uint32_t getResolution(enumHistoryTier tier) const {
+    return tiers[tier].resolution;
+  }
+
+  /**
+   * @brief Checks if the store has memory.
+   * @return true after a successful `begin()`.
+   */
+  bool isReady() const {
+    return ready;
+  }
+};
+
+
+#endif  // HISTORY_HX_H
@@ -0,0 +1,281 @@
+/**
+ * @file i2c_bus_hx.cpp
+ * @brief Implementation of the I2C bus manager.
+ * @details Contains the device table of the board, the bus ownership, the worker task, the bus
+ *          recovery and the statistics of `I2cBus`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Error classes, timeouts and bounded bus recovery
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "i2c_bus_hx.h"
+#include "LiquidCrystal_AIP31068_I2C.h"
+#include "log_hx.h"
+
+static const I2cDeviceConfig boardDevices[] = {
+  { _TEMPSENSOR_I2C_ADDRESS_1, _I2C_CLOCK_SENSOR, "spool" },
+  { _TEMPSENSOR_I2C_ADDRESS_2, _I2C_CLOCK_SENSOR, "outlet" },
+  { _LCD_ADDRESS, _I2C_CLOCK_LCD, "lcd" },
+  { RGB_ADDRESS, _I2C_CLOCK_RGB, "rgb" },
+};
+
+I2cBus i2cBus(boardDevices, sizeof(boardDevices) / sizeof(boardDevices[0]));
+
+I2cBus::I2cBus(const I2cDeviceConfig *deviceList, uint8_t count, TwoWire *bus)
+  : wire(bus), devices(deviceList), deviceCount(count < _I2C_DEVICE_MAX ? count : _I2C_DEVICE_MAX - 1),
+    clock(0), owner(0), ownerMicros(0), resetMicros(0), mutex(nullptr), queue(nullptr), task(nullptr),
+    waiting(0), stalls(0), dropped(0), faulted(false), faultMillis(0), recoveries(0), recoveryFailures(0),
+    maxRecoveryMicros(0) {
+  memset(stats, 0, sizeof(stats));
+  memset(readyMicros, 0, sizeof(readyMicros));
+}
+
+bool I2cBus::begin() {
+  wire->begin(_PIN_I2C_SDA, _PIN_I2C_SCL);
+  wire->setTimeOut(_I2C_TIMEOUT);
+  resetMicros = micros();
+
+  mutex = xSemaphoreCreateMutex();
+  queue = xQueueCreate(_I2C_QUEUE_LENGTH, sizeof(I2cWrite));
+  if (mutex == nullptr || queue == nullptr
+      || xTaskCreatePinnedToCore(workerTask, "i2c", _I2C_TASK_STACK, this, _I2C_TASK_PRIORITY, &task, 0) != pdPASS) {
+    HX_LOG_ERROR("I2C: cannot start worker task, display writes are sent at once");
+    task = nullptr;
+    return false;
+  }
+  return task != nullptr;
+}
+
+uint8_t I2cBus::slot(uint8_t address) const {
+  for (uint8_t i = 0; i < deviceCount; i++) {
+    if (devices[i].address == address) {
+      return i;
+    }
+  }
+  return _I2C_DEVICE_MAX - 1;
+}
+
+bool I2cBus::lock(uint8_t address) {
+  uint32_t start = micros();
+  if (mutex != nullptr) {
+    waiting.fetch_add(1, std::memory_order_relaxed);
+    bool taken = xSemaphoreTake(mutex, pdMS_TO_TICKS(_I2C_LOCK_TIMEOUT)) == pdTRUE;
+    waiting.fetch_sub(1, std::memory_order_relaxed);
+    if (!taken) {
+      count(slot(address), I2C_ERROR_SKIPPED);
+      return false;
+    }
+  }
+  if (!usable()) {
+    count(slot(address), I2C_ERROR_SKIPPED);
+    if (mutex != nullptr) xSemaphoreGive(mutex);
+    return false;
+  }
+  take(address);
+  uint32_t waited = ownerMicros - start;
+  if (waited > stats[owner].maxWaitMicros) {
+    stats[owner].maxWaitMicros = waited;
+  }
+  return true;
+}
+
+bool I2cBus::usable() {
+  if (!faulted) {
+    return true;
+  }
+  // A stuck bus costs one recovery per interval, every other transaction is skipped at once
+  if (millis() - faultMillis < _I2C_RECOVERY_INTERVAL) {
+    return false;
+  }
+  return recover();
+}
+
+void I2cBus::take(uint8_t address) {
+  owner = slot(address);
+  uint32_t frequency = owner < deviceCount ? devices[owner].clock : _I2C_CLOCK_DEFAULT;
+  if (frequency != clock) {
+    wire->setClock(frequency);
+    clock = frequency;
+  }
+  ownerMicros = micros();
+}
+
+void I2cBus::count(uint8_t device, enumI2cError error) {
+  if (error != I2C_OK) {
+    stats[device].errors[error - 1]++;
+  }
+}
+
+void I2cBus::unlock(size_t bytes, enumI2cError error) {
+  I2cDeviceStats &device = stats[owner];
+  device.transactions++;
+  device.bytes += bytes;
+  device.busyMicros += micros() - ownerMicros;
+  count(owner, error);
+
+  // A NACK is the answer of a working bus, the other errors may come from a device holding a line
+  if (mutex != nullptr
+      && (error == I2C_ERROR_BUS || error == I2C_ERROR_TIMEOUT || (error == I2C_ERROR_READ && !linesIdle()))) {
+    recover();
+  }
+  if (mutex != nullptr) {
+    xSemaphoreGive(mutex);
+  }
+}
+
+void I2cBus::post(uint8_t address, const uint8_t *data, uint8_t length, uint16_t holdMicros) {
+  I2cWrite write{};
+  write.address = address;
+  write.length = length < _I2C_BATCH_MAX ? length : (uint8_t)_I2C_BATCH_MAX;
+  write.holdMicros = holdMicros;
+  memcpy(write.data, data, write.length);
+  if (task == nullptr) {
+    send(write);
+    return;
+  }
+  // Waiting keeps the screen consistent, but never longer than the loop can afford
+  if (xQueueSend(queue, &write, 0) != pdTRUE) {
+    stalls.fetch_add(1, std::memory_order_relaxed);
+    if (xQueueSend(queue, &write, pdMS_TO_TICKS(_I2C_POST_TIMEOUT)) != pdTRUE) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void I2cBus::send(const I2cWrite &write) {
+  // The device may still execute the previous write
+  uint8_t device = slot(write.address);
+  int32_t remaining = (int32_t)(readyMicros[device] - micros());
+  if (remaining >= 1000 && task != nullptr) {
+    vTaskDelay(pdMS_TO_TICKS((remaining + 999) / 1000));
+  } else if (remaining > 0) {
+    delayMicroseconds(remaining);
+  }
+
+  if (mutex != nullptr) {
+    // Sensor transactions go first; the worker runs on the other core, so yielding is enough
+    while (waiting.load(std::memory_order_relaxed) > 0) {
+      taskYIELD();
+    }
+    xSemaphoreTake(mutex, portMAX_DELAY);
+  }
+  if (!usable()) {
+    count(device, I2C_ERROR_SKIPPED);
+    if (mutex != nullptr) xSemaphoreGive(mutex);
+    return;
+  }
+  take(write.address);
+  wire->beginTransmission(write.address);
+  wire->write(write.data, write.length);
+  enumI2cError error = classify(wire->endTransmission());
+  unlock(write.length, error);
+  readyMicros[device] = micros() + write.holdMicros;
+}
+
+bool I2cBus::linesIdle() const {
+  return digitalRead(_PIN_I2C_SDA) == HIGH && digitalRead(_PIN_I2C_SCL) == HIGH;
+}
+
+bool I2cBus::recover() {
+  uint32_t start = micros();
+  wire->end();
+
+  // Up to nine clocks let a device finish the byte it is sending and release SDA
+  pinMode(_PIN_I2C_SDA, INPUT_PULLUP);
+  pinMode(_PIN_I2C_SCL, OUTPUT_OPEN_DRAIN);
+  digitalWrite(_PIN_I2C_SCL, HIGH);
+  delayMicroseconds(_I2C_RECOVERY_HALF_PERIOD);
+  for (uint8_t i = 0; i < 9 && digitalRead(_PIN_I2C_SDA) == LOW; i++) {
+    digitalWrite(_PIN_I2C_SCL, LOW);
+    delayMicroseconds(_I2C_RECOVERY_HALF_PERIOD);
+    digitalWrite(_PIN_I2C_SCL, HIGH);
+    delayMicroseconds(_I2C_RECOVERY_HALF_PERIOD);
+  }
+
+  // STOP: SDA rises while SCL is high
+  pinMode(_PIN_I2C_SDA, OUTPUT_OPEN_DRAIN);
+  digitalWrite(_PIN_I2C_SDA, LOW);
+  delayMicroseconds(_I2C_RECOVERY_HALF_PERIOD);
+  digitalWrite(_PIN_I2C_SDA, HIGH);
+  delayMicroseconds(_I2C_RECOVERY_HALF_PERIOD);
+  bool released = linesIdle();
+
+  wire->begin(_PIN_I2C_SDA, _PIN_I2C_SCL);
+  wire->setTimeOut(_I2C_TIMEOUT);
+  clock = 0;  // The driver starts with its default clock
+  recoveries++;
+
+  uint32_t duration = micros() - start;
+  if (duration > maxRecoveryMicros) {
+    maxRecoveryMicros = duration;
+  }
+  if (!released) {
+    recoveryFailures++;
+    faultMillis = millis();
+    if (!faulted) {
+      HX_LOG_ERROR("I2C: bus stuck, transactions skipped");
+    }
+  } else if (faulted) {
+    HX_LOG_INFO("I2C: bus recovered");
+  }
+  faulted = !released;
+  return released;
+}
+
+void I2cBus::workerTask(void *parameter) {
+  I2cBus *bus = (I2cBus *)parameter;
+  I2cWrite write;
+  for (;;) {
+    if (xQueueReceive(bus->queue, &write, portMAX_DELAY) == pdTRUE) {
+      bus->send(write);
+    }
+  }
+}
+
+void I2cBus::reset() {
+  memset(stats, 0, sizeof(stats));
+  resetMicros = micros();
+}
+
+void I2cBus::print(Print &out) const {
+  uint32_t elapsed = micros() - resetMicros;
+  out.println("device,address,clock,transactions,bytes,length,nack_address,nack_data,bus,timeout,read,skipped,"
+              "busy_us,utilization,max_wait_us");
+  for (uint8_t i = 0; i < _I2C_DEVICE_MAX; i++) {
+    const I2cDeviceStats &device = stats[i];
+    bool known = i < deviceCount;
+    if (!known && (i < _I2C_DEVICE_MAX - 1 || device.transactions == 0)) {
+      continue;  // Unused slot, or no unknown device was addressed
+    }
+    out.printf("%s,0x%02X,%u,%u,%u", known ? devices[i].name : "other", known ? devices[i].address : 0,
+               (unsigned)(known ? devices[i].clock : _I2C_CLOCK_DEFAULT), (unsigned)device.transactions,
+               (unsigned)device.bytes);
+    for (uint8_t e = 0; e < TELEMETRY_I2C_ERRORS; e++) {
+      out.printf(",%u", (unsigned)device.errors[e]);
+    }
+    out.printf(",%u,%.2f%%,%u\n", (unsigned)device.busyMicros, elapsed ? 100.0 * device.busyMicros / elapsed : 0.0,
+               (unsigned)device.maxWaitMicros);
+  }
+  out.printf("Bus %s, %u recoveries, %u failed, longest %u us; display writes %u stalled, %u dropped\n",
+             faulted ? "faulted" : "ok", (unsigned)recoveries, (unsigned)recoveryFailures,
+             (unsigned)maxRecoveryMicros, (unsigned)stalls.load(), (unsigned)dropped.load());
+}
+
+void I2cBus::fill(uint8_t index, TelemetryI2c &message) const {
+  const I2cDeviceStats &device = stats[index];
+  message.address = devices[index].address;
+  message.faulted = faulted;
+  message.recoveries = recoveries;
+  message.transactions = device.transactions;
+  memcpy(message.errors, device.errors, sizeof(message.errors));
+}
@@ -0,0 +1,282 @@
+/**
+ * @file i2c_bus_hx.h
+ * @brief Arbitration of the I2C bus between the sensors and the display.
+ * @details This file contains the `I2cBus` class, which owns the I2C master, sets the clock of
+ *          each device, serves the sensor transactions ahead of the display writes and recovers
+ *          the bus when a device holds a line low.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Error classes, timeouts and bounded bus recovery
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef I2C_BUS_HX_H
+#define I2C_BUS_HX_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "globals_hx.h"
+#include "telemetry_protocol_hx.h"
+
+/** Result classes of a transaction; the first five are the codes of `TwoWire::endTransmission()`. */
+enum enumI2cError {
+  I2C_OK,                  ///< Success.
+  I2C_ERROR_LENGTH,        ///< Data too long for the driver buffer.
+  I2C_ERROR_NACK_ADDRESS,  ///< No device answered the address.
+  I2C_ERROR_NACK_DATA,     ///< The device rejected a data byte.
+  I2C_ERROR_BUS,           ///< Other bus error, e.g. arbitration lost or bus busy.
+  I2C_ERROR_TIMEOUT,       ///< The transaction did not finish within `_I2C_TIMEOUT`.
+  I2C_ERROR_READ,          ///< A library read failed, the driver code is not passed on.
+  I2C_ERROR_SKIPPED,       ///< Not sent: the bus is faulted or was not free within `_I2C_LOCK_TIMEOUT`.
+  I2C_ERROR_COUNT          ///< Number of classes including `I2C_OK`.
+};
+
+static_assert(I2C_ERROR_COUNT - 1 == TELEMETRY_I2C_ERRORS, "TelemetryI2c has one counter per error class");
+
+/**
+ * @brief Device on the bus with its clock.
+ */
+typedef struct {
+  uint8_t address;   ///< 7 bit address.
+  uint32_t clock;    ///< SCL frequency in Hz.
+  const char *name;  ///< Name for the statistics.
+} I2cDeviceConfig;
+
+/**
+ * @brief Bus statistics of one device.
+ */
+typedef struct {
+  uint32_t transactions;                  ///< Completed transactions.
+  uint32_t bytes;                         ///< Bytes written and read.
+  uint32_t errors[TELEMETRY_I2C_ERRORS];  ///< Failed transactions per class, `enumI2cError` minus one.
+  uint32_t busyMicros;                    ///< Time the device held the bus in µs.
+  uint32_t maxWaitMicros;                 ///< Longest wait for the bus in µs.
+} I2cDeviceStats;
+
+/**
+ * @brief Display write waiting for the bus.
+ */
+typedef struct {
+  uint8_t address;               ///< 7 bit address.
+  uint8_t length;                ///< Number of bytes in `data`.
+  uint16_t holdMicros;           ///< Execution time of the device, no further write to it before.
+  uint8_t data[_I2C_BATCH_MAX];  ///< Bytes of the transaction.
+} I2cWrite;
+
+/**
+ * @brief Owner of the I2C master with two priority classes.
+ * @details The sensors and the display share one bus. With every caller on `Wire` directly, a
+ *          sensor read would wait for a complete screen update. The manager splits the traffic by
+ *          priority:
+ *          - Sensor transactions run in the calling task between `lock()` and `unlock()`. The
+ *            caller needs the result anyway, so a queue would only add two task switches.
+ *          - Display writes are queued with `post()` and return at once. A worker task on core 0
+ *            sends them one batch at a time and gives way to every waiting sensor transaction,
+ *            so a sensor read waits for at most one batch, never for a whole redraw.
+ *
+ *          Each device has its own SCL frequency, set before its transaction when it differs
+ *          from the current one. A write may carry the execution time of the device, e.g. 2 ms
+ *          for clearing the LCD; the worker sends nothing to that device before it has elapsed,
+ *          but serves the other devices meanwhile.
+ *
+ *          Until `begin()` has started the worker, and on the host, `post()` sends at once.
+ *
+ * ### Faults
+ * Every transaction ends with an `enumI2cError` class, counted per device. A device that
+ * lost track of the clock, e.g. after a glitch on a long sensor lead, may hold SDA low and block
+ * every master. After a bus error, a timeout, or a failed read with a line still low, the bus is
+ * recovered:
+ * - the controller releases the pins,
+ * - up to nine SCL pulses let the device finish its byte and release SDA,
+ * - a STOP resets the state machines of all devices,
+ * - the controller is initialized again.
+ *
+ * This takes about 0.2 ms plus the driver initialization. If SDA stays low, the bus is marked
+ * faulted: every transaction is skipped at once, and the recovery is retried at most every
+ * `_I2C_RECOVERY_INTERVAL`. The time a caller spends on the bus is therefore bounded:
+ * - waiting for the bus: `_I2C_LOCK_TIMEOUT`
+ * - one transaction: `_I2C_TIMEOUT`, set as the driver timeout
+ * - one recovery: about 1 ms, at most once per `_I2C_RECOVERY_INTERVAL` while faulted
+ * - posting a display write: `_I2C_POST_TIMEOUT`, after that the write is dropped
+ *
+ * ### Example Usage
+ * ```cpp
+ * void setup() {
+ *   i2cBus.begin();
+ * }
+ *
+ * void loop() {
+ *   if (i2cBus.lock(0x76)) {
+ *     bool read = device.write_then_read(&reg, 1, buffer, 5);
+ *     i2cBus.unlock(6, read ? I2C_OK : I2C_ERROR_READ);
+ *   }
+ *
+ *   const uint8_t text[] = { 0x40, 'H', 'i' };
+ *   i2cBus.post(0x3E, text, sizeof(text));
+ * }
+ * ```
+ */
+class I2cBus {
+private:
+  TwoWire *wire;                         /**< Bus driver. */
+  const I2cDeviceConfig *devices;        /**< Known devices. */
+  uint8_t deviceCount;                   /**< Number of known devices. */
+  I2cDeviceStats stats[_I2C_DEVICE_MAX]; /**< Statistics per device, the last slot for unknown ones. */
+  uint32_t readyMicros[_I2C_DEVICE_MAX]; /**< Time the device accepts the next write. */
+  uint32_t clock;                        /**< Current SCL frequency. */
+  uint8_t owner;                         /**< Slot of the device holding the bus. */
+  uint32_t ownerMicros;                  /**< Time the bus was taken. */
+  uint32_t resetMicros;                  /**< Start of the statistics. */
+  SemaphoreHandle_t mutex;               /**< Bus ownership, nullptr until `begin()`. */
+  QueueHandle_t queue;                   /**< Display writes waiting for the worker. */
+  TaskHandle_t task;                     /**< Worker task, nullptr if writes are sent at once. */
+  std::atomic<uint8_t> waiting;          /**< Sensor transactions waiting for the bus. */
+  std::atomic<uint32_t> stalls;          /**< Posts that waited for a free queue slot. */
+  std::atomic<uint32_t> dropped;         /**< Posts dropped after `_I2C_POST_TIMEOUT`. */
+  bool faulted;                          /**< True while the bus is stuck and transactions are skipped. */
+  unsigned long faultMillis;             /**< Time of the last failed recovery. */
+  uint16_t recoveries;                   /**< Bus recoveries since boot. */
+  uint16_t recoveryFailures;             /**< Recoveries that left a line low. */
+  uint32_t maxRecoveryMicros;            /**< Longest recovery. */
+
+  uint8_t slot(uint8_t address) const;
+  bool usable();
+  void take(uint8_t address);
+  void count(uint8_t device, enumI2cError error);
+  void send(const I2cWrite &write);
+  bool linesIdle() const;
+  bool recover();
+
+  static void workerTask(void *parameter);
+
+public:
+  /**
+   * @brief Constructor: Initializes the manager.
+   * @param deviceList Devices with their clocks, at most `_I2C_DEVICE_MAX - 1`.
+   * @param count Number of entries in `deviceList`.
+   * @param bus The I2C bus driver.
+   */
+  I2cBus(const I2cDeviceConfig *deviceList, uint8_t count, TwoWire *bus = &Wire);
+
+  /**
+   * @brief Starts the bus and the worker task.
+   * @return true if display writes are queued, false if they are sent at once.
+   */
+  bool begin();
+
+  /**
+   * @brief Takes the bus for a sensor transaction and sets the clock of the device.
+   * @details Waits for the display batch on the bus, if any, but at most `_I2C_LOCK_TIMEOUT`.
+   *          Must be followed by `unlock()` if it succeeded.
+   * @param address 7 bit address of the device.
+   * @return false if the transaction must be skipped, counted as `I2C_ERROR_SKIPPED`.
+   */
+  bool lock(uint8_t address);
+
+  /**
+   * @brief Releases the bus after a sensor transaction, records it and recovers the bus if needed.
+   * @param bytes Bytes written and read.
+   * @param error Result of the transaction.
+   */
+  void unlock(size_t bytes, enumI2cError error);
+
+  /**
+   * @brief Maps a result of `TwoWire::endTransmission()` to its class.
+   * @param code Driver result.
+   * @return The error class.
+   */
+  static enumI2cError classify(uint8_t code) {
+    return code < I2C_ERROR_READ ? (enumI2cError)code : I2C_ERROR_BUS;
+  }
+
+  /**
+   * @brief Queues a display write; returns at once unless the queue is full.
+   * @details A full queue is waited for at most `_I2C_POST_TIMEOUT`, then the write is dropped.
+   * @param address 7 bit address of the device.
+   * @param data Bytes of the transaction, copied.
+   * @param length Number of bytes, at most `_I2C_BATCH_MAX`.
+   * @param holdMicros Execution time of the device after the write.
+   */
+  void post(uint8_t address, const uint8_t *data, uint8_t length, uint16_t holdMicros = 0);
+
+  /**
+   * @brief Clears the statistics.
+   */
+  void reset();
+
+  /**
+   * @brief Prints the statistics and bus utilization of every device as CSV.
+   * @param out Output, e.g. `Serial`.
+   */
+  void print(Print &out) const;
+
+  /**
+   * @brief Fills the telemetry message of a device.
+   * @param index Device index, below `getDeviceCount()`.
+   * @param message Receives the counters.
+   */
+  void fill(uint8_t index, TelemetryI2c &message) const;
+
+  /**
+   * @brief Gets the number of devices in the table.
+   * @return Known devices.
+   */
+  uint8_t getDeviceCount() const {
+    return deviceCount;
+  }
+
+  /**
+   * @brief Gets the statistics of a device.
+   * @param address 7 bit address of the device.
+   * @return Statistics since the last reset; those of all unknown devices for an unknown address.
+   */
+  const I2cDeviceStats &getStats(uint8_t address) const {
+    return stats[slot(address)];
+  }
+
+  /**
+   * @brief Gets the number of posts that found the queue full.
+   * @return Stalled posts since boot.
+   */
+  uint32_t getStalls() const {
+    return stalls;
+  }
+
+  /**
+   * @brief Checks if the bus is stuck.
+   * @return true while transactions are skipped.
+   */
+  bool isFaulted() const {
+    return faulted;
+  }
+
+  /**
+   * @brief Gets the number of bus recoveries.
+   * @return Recoveries since boot.
+   */
+  uint16_t getRecoveries() const {
+    return recoveries;
+  }
+};
+
+/**
+ * @brief The I2C bus of the board with the sensors, the LCD and its backlight.
+ */
+extern I2cBus i2cBus;
+
+
+#endif  // I2C_BUS_HX_H
@@ -0,0 +1,78 @@
+/**
+ * @file input_hx.h
+ * @brief Input port of the control path.
+ * @details The control and UI code reads its external inputs through these functions instead
+ *          of `millis()`, `digitalRead()`, `analogRead()` and the raw sensor registers. On the
+ *          board they are implemented by `InputCapture`, which records every value for the
+ *          host replayer. The host HAL implements them with direct reads of its virtual board,
+ *          so the replayer feeds a capture back through the unchanged firmware sources.
+ *
+ *          Time is the time of the current loop pass: it is sampled once at the start of
+ *          `loop()`, so every decision of a pass sees the same millisecond and a replay with the
+ *          same pass times takes the same decisions.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef INPUT_HX_H
+#define INPUT_HX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Gets the time of the current loop pass.
+ * @return Milliseconds since boot at the start of the pass.
+ */
+uint32_t loopMillis();
+
+/**
+ * @brief Reads a digital input.
+ * @param pin GPIO number.
+ * @return `HIGH` or `LOW`.
+ */
+int readInputPin(uint8_t pin);
+
+/**
+ * @brief Reads an analog input.
+ * @param pin GPIO number.
+ * @return Raw 12 bit value.
+ */
+uint16_t readInputAnalog(uint8_t pin);
+
+/**
+ * @brief Records the result of an I2C probe.
+ * @param address 7 bit device address.
+ * @param present True if the device acknowledged.
+ */
+void captureI2cPresence(uint8_t address, bool present);
+
+/**
+ * @brief Records bytes read from the registers of an I2C device.
+ * @param address 7 bit device address.
+ * @param reg First register.
+ * @param data Bytes read, nullptr if the read failed.
+ * @param length Number of bytes.
+ */
+void captureI2cRead(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length);
+
+/**
+ * @brief Records the calibration data of a sensor after it was initialized.
+ * @param address 7 bit device address.
+ * @param calibration Calibration data as stored by the driver.
+ * @param size Size of the calibration data in bytes.
+ */
+void captureCalibration(uint8_t address, const void *calibration, size_t size);
+
+
+#endif  // INPUT_HX_H
@@ -0,0 +1,118 @@
+/**
+ * @file latency_hx.cpp
+ * @brief Implementation of the latency histograms.
+ * @details Contains the percentile search of `LatencyHistogram` and the period tracking and
+ *          reporting of `LatencyMonitor`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "latency_hx.h"
+
+static_assert(_LATENCY_SUB_BUCKET_BITS >= 1 && _LATENCY_SUB_BUCKET_BITS <= 8, "_LATENCY_SUB_BUCKET_BITS out of range");
+
+static const char *const channelNames[LATENCY_COUNT] = { "loop", "pid", "output", "i2c" };
+
+LatencyMonitor latency;
+
+LatencyHistogram::LatencyHistogram() {
+  reset();
+}
+
+void LatencyHistogram::reset() {
+  memset(buckets, 0, sizeof(buckets));
+  count = 0;
+  min = UINT32_MAX;
+  max = 0;
+}
+
+uint32_t LatencyHistogram::bucketUpper(uint32_t index) {
+  if (index < _LATENCY_SUB_BUCKETS) {
+    return index;
+  }
+  uint32_t shift = index / _LATENCY_SUB_BUCKETS - 1;
+  uint32_t lower = (_LATENCY_SUB_BUCKETS + index % _LATENCY_SUB_BUCKETS) << shift;
+  return lower + ((1UL << shift) - 1);
+}
+
+uint32_t LatencyHistogram::percentile(float percent) const {
+  if (count == 0) {
+    return 0;
+  }
+  // Rank of the value at the percentile, 1 based
+  uint32_t rank = (uint32_t)ceilf(percent / 100.0f * count);
+  if (rank < 1) rank = 1;
+  if (rank > count) rank = count;
+
+  uint32_t seen = 0;
+  for (uint32_t i = 0; i < _LATENCY_BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      uint32_t upper = bucketUpper(i);
+      return upper < max ? upper : max;
+    }
+  }
+  return max;
+}
+
+LatencyMonitor::LatencyMonitor()
+  : deadlineMisses(0) {
+  memset(lastMicros, 0, sizeof(lastMicros));
+  memset(started, 0, sizeof(started));
+}
+
+void LatencyMonitor::recordPeriod(enumLatencyChannel channel, uint32_t now, uint32_t deadline) {
+  if (started[channel]) {
+    uint32_t period = now - lastMicros[channel];
+    histograms[channel].record(period);
+    if (deadline > 0 && period > deadline) {
+      deadlineMisses++;
+    }
+  }
+  lastMicros[channel] = now;
+  started[channel] = true;
+}
+
+void LatencyMonitor::reset() {
+  for (uint8_t c = 0; c < LATENCY_COUNT; c++) {
+    histograms[c].reset();
+    started[c] = false;
+  }
+  deadlineMisses = 0;
+}
+
+void LatencyMonitor::print(Print &out) const {
+  out.println("channel,count,min_us,p50_us,p99_us,max_us");
+  for (uint8_t c = 0; c < LATENCY_COUNT; c++) {
+    const LatencyHistogram &histogram = histograms[c];
+    out.printf("%s,%u,%u,%u,%u,%u\n", channelNames[c], (unsigned)histogram.getCount(),
+               (unsigned)histogram.getMin(), (unsigned)histogram.percentile(50),
+               (unsigned)histogram.percentile(99), (unsigned)histogram.getMax());
+  }
+  out.printf("deadline misses,%u\n", (unsigned)deadlineMisses);
+}
+
+void LatencyMonitor::fill(enumLatencyChannel channel, TelemetryLatency &message) const {
+  const LatencyHistogram &histogram = histograms[channel];
+  memset(&message, 0, sizeof(message));
+  message.channel = channel;
+  message.count = histogram.getCount();
+  message.p50 = histogram.percentile(50);
+  message.p99 = histogram.percentile(99);
+  message.max = histogram.getMax();
+  message.deadlineMisses = deadlineMisses;
+}
+
+const char *LatencyMonitor::channelName(uint8_t channel) {
+  return (channel < LATENCY_COUNT) ? channelNames[channel] : "unknown";
+}
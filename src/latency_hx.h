@@ -0,0 +1,216 @@
+/**
+ * @file latency_hx.h
+ * @brief Latency and jitter statistics of the control loop.
+ * @details This file contains the `LatencyHistogram` class, a log-bucketed histogram with fixed
+ *          memory and constant recording time, and the `LatencyMonitor` class, which keeps one
+ *          histogram per measured interval and counts missed PID deadlines.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef LATENCY_HX_H
+#define LATENCY_HX_H
+
+#include <Arduino.h>
+#include "globals_hx.h"
+#include "telemetry_protocol_hx.h"
+
+#define _LATENCY_SUB_BUCKETS (1 << _LATENCY_SUB_BUCKET_BITS)                     ///< Buckets per power of two
+#define _LATENCY_BUCKETS ((33 - _LATENCY_SUB_BUCKET_BITS) * _LATENCY_SUB_BUCKETS)  ///< Buckets for the full 32 bit range
+
+/**
+ * @brief Measured intervals.
+ */
+enum enumLatencyChannel {
+  LATENCY_LOOP,    ///< Period of `loop()`.
+  LATENCY_PID,     ///< Period of the PID computations, checked against the deadline.
+  LATENCY_OUTPUT,  ///< Time from the sensor poll that delivered a sample to `ledcWrite()`.
+  LATENCY_I2C,     ///< Duration of a BME280 transaction.
+  LATENCY_COUNT    ///< Number of channels.
+};
+
+/**
+ * @brief Histogram of durations in microseconds with logarithmic buckets.
+ * @details Like an HDR histogram, each power of two is split into `_LATENCY_SUB_BUCKETS` linear
+ *          buckets, so the relative error of a reported value is below 1 / `_LATENCY_SUB_BUCKETS`
+ *          (12.5 % with 3 bits) from 1 µs up to 71 minutes. Recording is a bit scan and an
+ *          increment. Percentiles are reported as the upper bound of their bucket, limited to
+ *          the exact maximum.
+ */
+class LatencyHistogram {
+private:
+  uint32_t buckets[_LATENCY_BUCKETS];  /**< Number of values per bucket. */
+  uint32_t count;                      /**< Number of recorded values. */
+  uint32_t min;                        /**< Smallest recorded value. */
+  uint32_t max;                        /**< Largest recorded value. */
+
+public:
+  /**
+   * @brief Constructor: Initializes an empty histogram.
+   */
+  LatencyHistogram();
+
+  /**
+   * @brief Records a value.
+   * @param value Duration in microseconds.
+   */
+  void record(uint32_t value) {
+    buckets[bucketIndex(value)]++;
+    count++;
+    if (value < min) min = value;
+    if (value > max) max = value;
+  }
+
+  /**
+   * @brief Gets a percentile.
+   * @param percent Percentile between 0 and 100.
+   * @return Upper bound of the bucket that contains the percentile, 0 if the histogram is empty.
+   */
+  uint32_t percentile(float percent) const;
+
+  /**
+   * @brief Removes all values.
+   */
+  void reset();
+
+  uint32_t getCount() const {
+    return count;
+  }
+
+  uint32_t getMin() const {
+    return count > 0 ? min : 0;
+  }
+
+  uint32_t getMax() const {
+    return max;
+  }
+
+  /**
+   * @brief Gets the bucket of a value.
+   * @param value Duration in microseconds.
+   * @return Bucket index below `_LATENCY_BUCKETS`.
+   */
+  static uint32_t bucketIndex(uint32_t value) {
+    if (value < _LATENCY_SUB_BUCKETS) {
+      return value;
+    }
+    uint32_t msb = 31 - __builtin_clz(value);
+    uint32_t shift = msb - _LATENCY_SUB_BUCKET_BITS;
+    return (shift + 1) * _LATENCY_SUB_BUCKETS + ((value >> shift) & (_LATENCY_SUB_BUCKETS - 1));
+  }
+
+  /**
+   * @brief Gets the largest value of a bucket.
+   * @param index Bucket index.
+   * @return Upper bound in microseconds.
+   */
+  static uint32_t bucketUpper(uint32_t index);
+};
+
+/**
+ * @brief Latency histograms of the control loop.
+ * @details Keeps one `LatencyHistogram` per `enumLatencyChannel`, about 1 KB each. A PID period
+ *          longer than the deadline passed to `recordPeriod()` counts as a miss.
+ *
+ *          All recording and reading happens in the loop task, so the class does no locking.
+ *
+ * ### Example Usage
+ * ```cpp
+ * unsigned long start = micros();
+ * sensor.readFixed(temperature, humidity);
+ * latency.record(LATENCY_I2C, micros() - start);
+ *
+ * latency.print(Serial);
+ * ```
+ */
+class LatencyMonitor {
+private:
+  LatencyHistogram histograms[LATENCY_COUNT];  /**< Histogram per channel. */
+  uint32_t deadlineMisses;                     /**< PID periods longer than the deadline. */
+  uint32_t lastMicros[LATENCY_COUNT];          /**< Start of the current period per channel. */
+  bool started[LATENCY_COUNT];                 /**< True if `lastMicros` is valid. */
+
+public:
+  /**
+   * @brief Constructor: Initializes empty histograms.
+   */
+  LatencyMonitor();
+
+  /**
+   * @brief Records a duration.
+   * @param channel Channel, see `enumLatencyChannel`.
+   * @param micros Duration in microseconds.
+   */
+  void record(enumLatencyChannel channel, uint32_t micros) {
+    histograms[channel].record(micros);
+  }
+
+  /**
+   * @brief Records the time since the previous call as a period.
+   * @details The first call after construction, `reset()` or `restart()` only starts the period.
+   * @param channel Channel, see `enumLatencyChannel`.
+   * @param now Current time from `micros()`.
+   * @param deadline Longest period in microseconds that is not a miss, 0 for no check.
+   */
+  void recordPeriod(enumLatencyChannel channel, uint32_t now, uint32_t deadline = 0);
+
+  /**
+   * @brief Starts a new period without recording the current one.
+   * @details Used when a period is interrupted on purpose, e.g. the PID is switched off.
+   * @param channel Channel, see `enumLatencyChannel`.
+   */
+  void restart(enumLatencyChannel channel) {
+    started[channel] = false;
+  }
+
+  /**
+   * @brief Removes all values and the miss counter.
+   */
+  void reset();
+
+  /**
+   * @brief Prints count, p50, p99 and maximum of every channel.
+   * @param out Destination, e.g. `Serial`.
+   */
+  void print(Print &out) const;
+
+  /**
+   * @brief Fills a telemetry message with the statistics of a channel.
+   * @param channel Channel, see `enumLatencyChannel`.
+   * @param message Destination.
+   */
+  void fill(enumLatencyChannel channel, TelemetryLatency &message) const;
+
+  const LatencyHistogram &get(enumLatencyChannel channel) const {
+    return histograms[channel];
+  }
+
+  uint32_t getDeadlineMisses() const {
+    return deadlineMisses;
+  }
+
+  /**
+   * @brief Gets the name of a channel.
+   * @param channel Channel, see `enumLatencyChannel`.
+   * @return Name without spaces, e.g. `"pid"`.
+   */
+  static const char *channelName(uint8_t channel);
+};
+
+/**
+ * @brief Global latency monitor.
+ */
+extern LatencyMonitor latency;
+
+
+#endif  // LATENCY_HX_H
@@ -1,10 +1,12 @@
 /**
  * @file lcd_hx.cpp
- * @brief ...
- * @details ...
+ * @brief Implementation of the LCD glyph cache and graphs.
+ * @details Contains the icon bitmaps, the slot replacement of `LcdGlyphManager` and the
+ *          rendering of bargraphs and sparklines into glyphs.
  *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Added `LcdGlyphManager` with bargraph and sparkline rendering, icons
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -18,6 +20,98 @@
 #include "lcd_hx.h"
 #include "globals_hx.h"
 
+const uint8_t lcdIconDegree[8] = { 0b00111, 0b00101, 0b00111, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000 };
+const uint8_t lcdIconTemperature[8] = { 0b00100, 0b01010, 0b01010, 0b01010, 0b01110, 0b11111, 0b01110, 0b00000 };
+const uint8_t lcdIconHumidity[8] = { 0b00100, 0b00100, 0b01110, 0b11111, 0b11111, 0b01110, 0b00000, 0b00000 };
+const uint8_t lcdIconTime[8] = { 0b01110, 0b10001, 0b10101, 0b10101, 0b10001, 0b01110, 0b00000, 0b00000 };
+const uint8_t lcdIconMode[8] = { 0b00100, 0b01010, 0b11111, 0b01110, 0b01110, 0b11111, 0b01010, 0b00100 };
+
+LcdGlyphManager::LcdGlyphManager(LiquidCrystal_AIP31068_I2C &display)
+  : lcd(display), counter(0), frameStart(0), uploads(0), fallbacks(0) {
+  memset(bitmaps, 0, sizeof(bitmaps));
+  memset(used, 0, sizeof(used));
+}
+
+void LcdGlyphManager::beginFrame() {
+  frameStart = counter;
+}
+
+uint8_t LcdGlyphManager::acquire(const uint8_t *bitmap, uint8_t fallback) {
+  uint8_t victim = _LCD_GLYPH_SLOTS;
+  for (uint8_t i = 0; i < _LCD_GLYPH_SLOTS; i++) {
+    if (used[i] != 0 && memcmp(bitmaps[i], bitmap, 8) == 0) {
+      used[i] = ++counter;
+      return _LCD_GLYPH_FIRST + i;
+    }
+    // Empty slots have the oldest use, slots of the current frame are on screen
+    if (used[i] <= frameStart && (victim == _LCD_GLYPH_SLOTS || used[i] < used[victim])) {
+      victim = i;
+    }
+  }
+  if (victim == _LCD_GLYPH_SLOTS) {
+    fallbacks++;
+    return fallback;
+  }
+  memcpy(bitmaps[victim], bitmap, 8);
+  used[victim] = ++counter;
+  lcd.createChar(_LCD_GLYPH_FIRST + victim, bitmaps[victim]);
+  uploads++;
+  return _LCD_GLYPH_FIRST + victim;
+}
+
+void LcdGlyphManager::drawBar(uint8_t col, uint8_t row, uint8_t cells, int32_t value, int32_t full) {
+  uint8_t codes[_LCD_COLS];
+  cells = cells < _LCD_COLS ? cells : _LCD_COLS;
+  value = value < 0 ? 0 : value > full ? full : value;
+  int32_t pixels = value * cells * 5 / full;
+  for (uint8_t i = 0; i < cells; i++) {
+    int32_t lit = pixels - i * 5;
+    lit = lit < 0 ? 0 : lit > 5 ? 5 : lit;
+    if (lit == 0 || lit == 5) {
+      codes[i] = lit ? LCD_CHAR_FULL : LCD_CHAR_EMPTY;
+      continue;
+    }
+    // Only the cell with the end of the bar needs a glyph, shared by all bars with the same end
+    uint8_t bitmap[8];
+    memset(bitmap, (0x1F << (5 - lit)) & 0x1F, sizeof(bitmap));
+    codes[i] = acquire(bitmap, lit >= 3 ? LCD_CHAR_FULL : LCD_CHAR_EMPTY);
+  }
+  lcd.setCursor(col, row);
+  lcd.write(codes, cells);
+}
+
+void LcdGlyphManager::drawSparkline(uint8_t col, uint8_t row, uint8_t cells, const int16_t *values, size_t count,
+                                    int16_t low, int16_t high) {
+  uint8_t codes[_LCD_COLS];
+  cells = cells < _LCD_COLS ? cells : _LCD_COLS;
+  size_t columns = cells * 5;
+  size_t first = count > columns ? count - columns : 0;  // Index of the oldest value shown
+  size_t offset = columns - (count - first);             // Empty columns on the left
+  int32_t range = high > low ? high - low : 1;
+
+  for (uint8_t i = 0; i < cells; i++) {
+    uint8_t bitmap[8] = { 0 };
+    bool empty = true;
+    for (uint8_t c = 0; c < 5; c++) {
+      size_t column = i * 5 + c;
+      if (column < offset) {
+        continue;
+      }
+      // A column is filled from the bottom, so even the lowest value shows one pixel
+      int32_t value = values[first + column - offset];
+      value = value < low ? low : value > high ? high : value;
+      int32_t level = (value - low) * 7 / range;
+      for (int32_t r = 7 - level; r < 8; r++) {
+        bitmap[r] |= 0x10 >> c;
+      }
+      empty = false;
+    }
+    codes[i] = empty ? LCD_CHAR_EMPTY : acquire(bitmap);
+  }
+  lcd.setCursor(col, row);
+  lcd.write(codes, cells);
+}
+
 /* LcdMenu API:
 class DisplayInterface:
 
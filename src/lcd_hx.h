@@ -1,23 +1,145 @@
 /**
  * @file lcd_hx.h
- * @brief ...
- * @details ...
- * 
+ * @brief Custom characters and graphs on the LCD.
+ * @details This file contains the `LcdGlyphManager` class, which shares the CGRAM slots of the
+ *          LCD between the icons, bargraphs and sparklines, and the icons of the home screen.
+ *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Added `LcdGlyphManager` with bargraph and sparkline rendering, icons and pages
  *
  * @version 0.0.1
  * @date 2024-11-08
  * @author Kevin Hinrichs
  *
  * @copyright
- * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.  
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
  * All rights reserved. Unauthorized copying or use of this code is prohibited.
  */
 
 #ifndef LCD_HX_H
 #define LCD_HX_H
 
+#include <Arduino.h>
+#include "LiquidCrystal_AIP31068_I2C.h"
+#include "globals_hx.h"
+
+#define LCD_CHAR_FULL 0xFF  ///< Full block in the character ROM
+#define LCD_CHAR_EMPTY ' '  ///< Empty cell in the character ROM
+
+/** Screens shown one after the other. */
+enum enumLcdPage {
+  LCD_PAGE_HOME,         ///< Temperature, humidity and countdown.
+  LCD_PAGE_TEMPERATURE,  ///< Temperature sparkline and duty bargraphs.
+  LCD_PAGE_HUMIDITY,     ///< Humidity sparkline and duty bargraphs.
+  LCD_PAGE_COUNT         ///< Number of pages.
+};
+
+extern const uint8_t lcdIconDegree[8];       ///< Degree sign.
+extern const uint8_t lcdIconTemperature[8];  ///< Thermometer.
+extern const uint8_t lcdIconHumidity[8];     ///< Droplet.
+extern const uint8_t lcdIconTime[8];         ///< Clock.
+extern const uint8_t lcdIconMode[8];         ///< Heating mode.
+
+/**
+ * @brief Cache of the custom characters in the CGRAM of the LCD.
+ * @details The LCD has eight custom characters; slots 0 and 1 belong to LcdMenu, the others
+ *          are handed out by `acquire()` as a least recently used cache keyed by the bitmap.
+ *          A bitmap already in a slot costs nothing, a new one one command and one 8 byte data
+ *          stream, queued by `I2cBus` without waiting.
+ *
+ *          A slot shown on the screen must not be overwritten, the LCD would redraw every cell
+ *          using it. The glyphs acquired since the last `beginFrame()` are therefore never
+ *          replaced. A screen that redraws all its custom cells calls `beginFrame()` first; if
+ *          more glyphs are needed than slots exist, `acquire()` returns the given ROM character.
+ *
+ *          An upload moves the address counter of the LCD into the CGRAM, so glyphs are
+ *          acquired before `setCursor()`, and the draw functions set the cursor themselves.
+ *
+ * ### Example Usage
+ * ```cpp
+ * LcdGlyphManager glyphs(lcd);
+ *
+ * void draw() {
+ *   glyphs.beginFrame();
+ *   uint8_t icon = glyphs.acquire(lcdIconTemperature);
+ *   lcd.setCursor(0, 0);
+ *   lcd.write(icon);
+ *   glyphs.drawBar(1, 0, 6, duty, 10000);
+ * }
+ * ```
+ */
+class LcdGlyphManager {
+private:
+  LiquidCrystal_AIP31068_I2C &lcd;      /**< Display with the CGRAM. */
+  uint8_t bitmaps[_LCD_GLYPH_SLOTS][8]; /**< Bitmap in each slot. */
+  uint32_t used[_LCD_GLYPH_SLOTS];      /**< Use counter at the last acquire, 0 if empty. */
+  uint32_t counter;                     /**< Number of acquires, orders the slots by use. */
+  uint32_t frameStart;                  /**< Counter at the last `beginFrame()`. */
+  uint32_t uploads;                     /**< Bitmaps written to the CGRAM. */
+  uint32_t fallbacks;                   /**< Acquires answered with the ROM character. */
+
+public:
+  /**
+   * @brief Constructor: Initializes an empty cache.
+   * @param display Display whose CGRAM is managed.
+   */
+  explicit LcdGlyphManager(LiquidCrystal_AIP31068_I2C &display);
+
+  /**
+   * @brief Starts a new screen; the glyphs acquired before may be replaced again.
+   */
+  void beginFrame();
+
+  /**
+   * @brief Gets the character code of a bitmap, uploading it if needed.
+   * @param bitmap Eight rows of five pixels, bit 4 is the left column.
+   * @param fallback ROM character returned if every slot is in use by the current frame.
+   * @return Character code to write.
+   */
+  uint8_t acquire(const uint8_t *bitmap, uint8_t fallback = LCD_CHAR_EMPTY);
+
+  /**
+   * @brief Draws a horizontal bar with a resolution of one pixel column.
+   * @param col First column.
+   * @param row Row.
+   * @param cells Width in characters, at most `_LCD_COLS`.
+   * @param value Value shown, clamped to 0..`full`.
+   * @param full Value of the full bar, greater than 0.
+   */
+  void drawBar(uint8_t col, uint8_t row, uint8_t cells, int32_t value, int32_t full);
+
+  /**
+   * @brief Draws a sparkline with one pixel column per value.
+   * @details The values are right aligned and scaled from `low` to `high` onto the eight pixel
+   *          rows; each character shows five values.
+   * @param col First column.
+   * @param row Row.
+   * @param cells Width in characters, at most `_LCD_COLS`.
+   * @param values Values, oldest first; only the last `5 * cells` are shown.
+   * @param count Number of values.
+   * @param low Value of the bottom row.
+   * @param high Value of the top row.
+   */
+  void drawSparkline(uint8_t col, uint8_t row, uint8_t cells, const int16_t *values, size_t count, int16_t low,
+                     int16_t high);
+
+  /**
+   * @brief Gets the number of bitmaps written to the CGRAM.
+   * @return Uploads since boot.
+   */
+  uint32_t getUploads() const {
+    return uploads;
+  }
+
+  /**
+   * @brief Gets the number of acquires that found no free slot.
+   * @return Fallbacks since boot.
+   */
+  uint32_t getFallbacks() const {
+    return fallbacks;
+  }
+};
 
 
-#endif //LCD_HX_H
\ No newline at end of file
+#endif  // LCD_HX_H
@@ -0,0 +1,161 @@
+/**
+ * @file log_hx.cpp
+ * @brief Implementation of the asynchronous logger.
+ * @details Contains the lock-free ring buffer and the deferred formatting of `AsyncLogger`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Formatting traced
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "log_hx.h"
+#include "trace_hx.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static_assert((_LOG_RING_SIZE & (_LOG_RING_SIZE - 1)) == 0, "_LOG_RING_SIZE must be a power of two");
+static_assert(_LOG_MAX_ARGS <= 4, "Argument types are packed into one byte");
+
+static const char levelNames[] = { '-', 'E', 'W', 'I', 'D' };
+
+AsyncLogger logger;
+
+AsyncLogger::AsyncLogger()
+  : head(0), tail(0), dropped(0), port(nullptr) {
+  for (uint32_t i = 0; i < _LOG_RING_SIZE; i++) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool AsyncLogger::begin(Print &output) {
+  port = &output;
+  return xTaskCreatePinnedToCore(formatTask, "log", _LOG_TASK_STACK, this, _LOG_TASK_PRIORITY, nullptr, 0) == pdPASS;
+}
+
+bool AsyncLogger::push(const LogRecord &record) {
+  uint32_t position = head.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;) {
+    slot = &slots[position & (_LOG_RING_SIZE - 1)];
+    uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+    int32_t difference = (int32_t)(sequence - position);
+    if (difference == 0) {
+      // Claim the slot; on failure position holds the current head and we retry
+      if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->record = record;
+  slot->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+bool AsyncLogger::pop(LogRecord &record) {
+  Slot &slot = slots[tail & (_LOG_RING_SIZE - 1)];
+  if ((int32_t)(slot.sequence.load(std::memory_order_acquire) - (tail + 1)) < 0) {
+    return false;
+  }
+  record = slot.record;
+  slot.sequence.store(tail + _LOG_RING_SIZE, std::memory_order_release);
+  tail++;
+  return true;
+}
+
+void AsyncLogger::format(const LogRecord &record) {
+  char line[_LOG_LINE_LENGTH];
+  int length = snprintf(line, sizeof(line), "%lu.%03lu %c ",
+                        (unsigned long)(record.time / 1000), (unsigned long)(record.time % 1000),
+                        levelNames[record.level < sizeof(levelNames) ? record.level : 0]);
+
+  // Each conversion is formatted on its own with the stored argument type
+  const char *f = record.format;
+  uint8_t arg = 0;
+  while (*f != '\0' && length < (int)sizeof(line) - 1) {
+    if (*f != '%') {
+      line[length++] = *f++;
+      continue;
+    }
+    if (f[1] == '%') {
+      line[length++] = '%';
+      f += 2;
+      continue;
+    }
+
+    char spec[16];
+    size_t specLength = 0;
+    spec[specLength++] = *f++;
+    while (*f != '\0' && strchr("diuxXoceEfgGsp", *f) == nullptr) {
+      // Length modifiers are dropped, the value is passed with its stored type
+      if (strchr("hlLzjt", *f) == nullptr && specLength < sizeof(spec) - 2) spec[specLength++] = *f;
+      f++;
+    }
+    if (*f == '\0') break;
+    char conversion = *f++;
+    spec[specLength++] = conversion;
+    spec[specLength] = '\0';
+
+    char *out = line + length;
+    size_t room = sizeof(line) - length;
+    int written;
+    if (arg >= record.count) {
+      written = snprintf(out, room, "?");
+    } else {
+      uintptr_t raw = record.args[arg];
+      uint8_t type = (record.types >> (2 * arg)) & 0x03;
+      arg++;
+      if (type == LOG_ARG_FLOAT) {
+        float value;
+        memcpy(&value, &raw, sizeof(value));
+        written = snprintf(out, room, spec, (double)value);
+      } else if (type == LOG_ARG_STRING) {
+        written = snprintf(out, room, spec, raw ? (const char *)raw : "(null)");
+      } else if (conversion == 'p') {
+        written = snprintf(out, room, spec, (void *)raw);
+      } else if (type == LOG_ARG_INT) {
+        written = snprintf(out, room, spec, (int)(intptr_t)raw);
+      } else {
+        written = snprintf(out, room, spec, (unsigned)raw);
+      }
+    }
+    if (written > 0) length += ((size_t)written < room) ? written : room - 1;
+  }
+
+  if (length > (int)sizeof(line) - 2) length = sizeof(line) - 2;
+  line[length++] = '\n';
+  port->write((const uint8_t *)line, length);
+}
+
+void AsyncLogger::formatTask(void *parameter) {
+  AsyncLogger *logger = (AsyncLogger *)parameter;
+  LogRecord record;
+  uint32_t reportedDrops = 0;
+  for (;;) {
+    while (logger->pop(record)) {
+      HX_TRACE_SCOPE(TRACE_LOG);
+      logger->format(record);
+    }
+    uint32_t drops = logger->getDropped();
+    if (drops != reportedDrops) {
+      logger->port->printf("Log: %u records dropped\n", (unsigned)(drops - reportedDrops));
+      reportedDrops = drops;
+    }
+    vTaskDelay(pdMS_TO_TICKS(_LOG_TASK_PERIOD));
+  }
+}
@@ -0,0 +1,201 @@
+/**
+ * @file log_hx.h
+ * @brief Asynchronous logger with deferred formatting.
+ * @details This file contains the `HX_LOG_*` macros and the `AsyncLogger` class. A log call
+ *          stores only the format string pointer and the raw arguments; the text is formatted
+ *          later by a low-priority task.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef LOG_HX_H
+#define LOG_HX_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+#include "globals_hx.h"
+
+/**
+ * @brief Types of the stored log arguments.
+ */
+enum enumLogArgType {
+  LOG_ARG_INT,     ///< Signed integer or enum.
+  LOG_ARG_UINT,    ///< Unsigned integer or bool.
+  LOG_ARG_FLOAT,   ///< Floating point value, stored as float.
+  LOG_ARG_STRING,  ///< Pointer to a string that outlives the record.
+};
+
+/**
+ * @brief One log call as stored in the ring buffer.
+ */
+typedef struct {
+  const char *format;             ///< Format string, a literal in flash.
+  uint32_t time;                  ///< Time of the call (ms since boot).
+  uint8_t level;                  ///< Log level `_LOG_LEVEL_*`.
+  uint8_t count;                  ///< Number of arguments.
+  uint8_t types;                  ///< Two bits per argument, see `enumLogArgType`.
+  uintptr_t args[_LOG_MAX_ARGS];  ///< Raw argument values.
+} LogRecord;
+
+/**
+ * @brief Logger with a lock-free multi-producer ring buffer and a formatting task.
+ * @details `push()` reserves a slot with a single compare-and-swap and copies the record, so
+ *          it can be used from any task or core and from interrupts, and it never waits for the
+ *          UART. If the ring is full, the record is dropped and counted. The formatting task
+ *          drains the ring every `_LOG_TASK_PERIOD` ms and writes one line per record:
+ *          ```
+ *          12.345 I Presets: 8 loaded from index
+ *          ```
+ *
+ *          Use the `HX_LOG_*` macros instead of calling `push()`. Levels above `_LOG_LEVEL` are
+ *          removed at compile time, including the evaluation of their arguments.
+ *
+ *          Arguments are stored raw, so a `%s` argument must point to a string that still exists
+ *          when the record is formatted, e.g. a literal or a name in a static table.
+ *
+ * ### Example Usage
+ * ```cpp
+ * void setup() {
+ *   Serial.begin(115200);
+ *   logger.begin(Serial);
+ *   HX_LOG_INFO("Sensor found at 0x%02X", 0x76);
+ * }
+ * ```
+ */
+class AsyncLogger {
+private:
+  /**
+   * @brief Ring buffer slot with its sequence number.
+   */
+  struct Slot {
+    std::atomic<uint32_t> sequence; /**< Ready for writing if equal to the write position, for reading if one more. */
+    LogRecord record;               /**< Stored call. */
+  };
+
+  Slot slots[_LOG_RING_SIZE];     /**< Ring buffer. */
+  std::atomic<uint32_t> head;     /**< Next write position, shared by all producers. */
+  uint32_t tail;                  /**< Next read position, owned by the formatting task. */
+  std::atomic<uint32_t> dropped;  /**< Records dropped because the ring was full. */
+  Print *port;                    /**< Port the lines are written to. */
+
+  bool pop(LogRecord &record);
+  void format(const LogRecord &record);
+  static void formatTask(void *parameter);
+
+public:
+  /**
+   * @brief Constructor: Initializes an empty ring; records are kept until `begin()`.
+   */
+  AsyncLogger();
+
+  /**
+   * @brief Starts the formatting task.
+   * @param port Port to write to, e.g. `Serial`.
+   * @return true if the task has been started.
+   */
+  bool begin(Print &port);
+
+  /**
+   * @brief Stores a record without blocking.
+   * @param record Record to store.
+   * @return true if stored, false if the ring was full.
+   */
+  bool push(const LogRecord &record);
+
+  /**
+   * @brief Gets the number of dropped records.
+   * @return Records dropped since boot.
+   */
+  uint32_t getDropped() const {
+    return dropped;
+  }
+};
+
+/**
+ * @brief Global logger used by the `HX_LOG_*` macros.
+ */
+extern AsyncLogger logger;
+
+/**
+ * @brief Stores one argument in a record.
+ * @param record Record to fill.
+ * @param value Argument value.
+ */
+template<typename T>
+inline void logPack(LogRecord &record, T value) {
+  uint8_t type;
+  uintptr_t raw = 0;
+  if constexpr (std::is_floating_point<T>::value) {
+    float f = value;
+    memcpy(&raw, &f, sizeof(f));
+    type = LOG_ARG_FLOAT;
+  } else if constexpr (std::is_pointer<T>::value) {
+    raw = (uintptr_t)value;
+    type = LOG_ARG_STRING;
+  } else if constexpr (std::is_enum<T>::value || std::is_signed<T>::value) {
+    raw = (uintptr_t)(intptr_t)value;
+    type = LOG_ARG_INT;
+  } else {
+    raw = (uintptr_t)value;
+    type = LOG_ARG_UINT;
+  }
+  record.types |= type << (2 * record.count);
+  record.args[record.count++] = raw;
+}
+
+/**
+ * @brief Builds a record and pushes it to the logger; used by the `HX_LOG_*` macros.
+ * @param level Log level.
+ * @param format Format string literal.
+ * @param args Up to `_LOG_MAX_ARGS` arguments.
+ */
+template<typename... Args>
+inline void logWrite(uint8_t level, const char *format, Args... args) {
+  static_assert(sizeof...(Args) <= _LOG_MAX_ARGS, "Too many log arguments");
+  LogRecord record;
+  record.format = format;
+  record.time = millis();
+  record.level = level;
+  record.count = 0;
+  record.types = 0;
+  (logPack(record, args), ...);
+  logger.push(record);
+}
+
+#if _LOG_LEVEL >= _LOG_LEVEL_ERROR
+#define HX_LOG_ERROR(...) logWrite(_LOG_LEVEL_ERROR, __VA_ARGS__)  ///< Logs an error
+#else
+#define HX_LOG_ERROR(...) do {} while (0)
+#endif
+
+#if _LOG_LEVEL >= _LOG_LEVEL_WARN
+#define HX_LOG_WARN(...) logWrite(_LOG_LEVEL_WARN, __VA_ARGS__)  ///< Logs a warning
+#else
+#define HX_LOG_WARN(...) do {} while (0)
+#endif
+
+#if _LOG_LEVEL >= _LOG_LEVEL_INFO
+#define HX_LOG_INFO(...) logWrite(_LOG_LEVEL_INFO, __VA_ARGS__)  ///< Logs an information
+#else
+#define HX_LOG_INFO(...) do {} while (0)
+#endif
+
+#if _LOG_LEVEL >= _LOG_LEVEL_DEBUG
+#define HX_LOG_DEBUG(...) logWrite(_LOG_LEVEL_DEBUG, __VA_ARGS__)  ///< Logs a debug message
+#else
+#define HX_LOG_DEBUG(...) do {} while (0)
+#endif
+
+
+#endif  // LOG_HX_H
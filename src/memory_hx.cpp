@@ -0,0 +1,182 @@
+/**
+ * @file memory_hx.cpp
+ * @brief Implementation of the memory monitor.
+ * @details Contains the counting `operator new` and the heap and stack checks of
+ *          `MemoryMonitor`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Capture writer task monitored
+ * - **2026-10-19**: I2C worker task monitored
+ * - **2026-10-19**: Notifier task monitored
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "memory_hx.h"
+#include "log_hx.h"
+
+#include <atomic>
+#include <new>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * @brief Task checked by the monitor with its configured stack size.
+ */
+typedef struct {
+  const char *name;  ///< FreeRTOS task name.
+  uint32_t stack;    ///< Stack size in bytes.
+} MonitoredTask;
+
+static const MonitoredTask monitoredTasks[] = {
+  { "loopTask", _LOOP_TASK_STACK },
+  { "log", _LOG_TASK_STACK },
+  { "runlog", _RUNLOG_TASK_STACK },
+  { "capture", _CAPTURE_TASK_STACK },
+  { "telemetry", _TELEMETRY_TASK_STACK },
+  { "i2c", _I2C_TASK_STACK },
+  { "notify", _NOTIFY_TASK_STACK },
+};
+static const uint8_t monitoredTaskCount = sizeof(monitoredTasks) / sizeof(monitoredTasks[0]);
+
+static std::atomic<uint32_t> newCount(0);
+static std::atomic<uint32_t> newBytes(0);
+static std::atomic<uintptr_t> newCaller(0);
+
+static void *countedNew(size_t size, uintptr_t caller) {
+  newCount.fetch_add(1, std::memory_order_relaxed);
+  newBytes.fetch_add(size, std::memory_order_relaxed);
+  newCaller.store(caller, std::memory_order_relaxed);
+  return malloc(size ? size : 1);
+}
+
+// Replacements of the global allocation functions, the default `operator delete` frees them
+void *operator new(size_t size) {
+  void *pointer = countedNew(size, (uintptr_t)__builtin_return_address(0));
+  if (pointer == nullptr) {
+#if __cpp_exceptions
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+  return pointer;
+}
+
+void *operator new[](size_t size) {
+  void *pointer = countedNew(size, (uintptr_t)__builtin_return_address(0));
+  if (pointer == nullptr) {
+#if __cpp_exceptions
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+  }
+  return pointer;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return countedNew(size, (uintptr_t)__builtin_return_address(0));
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return countedNew(size, (uintptr_t)__builtin_return_address(0));
+}
+
+MemoryMonitor::MemoryMonitor()
+  : setupInternal(), setupPsram(), setupNew(), setupDone(false), reportedAllocations(0),
+    reportedStacks(0), lastCheckMillis(0) {}
+
+void MemoryMonitor::markSetupDone() {
+  setupInternal = heap(MALLOC_CAP_INTERNAL);
+  setupPsram = heap(MALLOC_CAP_SPIRAM);
+  setupNew = allocations();
+  setupDone = true;
+  HX_LOG_INFO("Memory: setup done, %u bytes internal and %u bytes PSRAM free",
+              (unsigned)setupInternal.free, (unsigned)setupPsram.free);
+}
+
+void MemoryMonitor::update() {
+  unsigned long now = millis();
+  if (!setupDone || now - lastCheckMillis < _MEMORY_CHECK_INTERVAL) {
+    return;
+  }
+  lastCheckMillis = now;
+
+  MemoryAllocations after = getAllocationsAfterSetup();
+  if (after.count != reportedAllocations) {
+    HX_LOG_WARN("Memory: %u allocations after setup, last from 0x%08x",
+                (unsigned)after.count, (unsigned)after.lastCaller);
+    reportedAllocations = after.count;
+  }
+
+  for (uint8_t i = 0; i < monitoredTaskCount; i++) {
+    TaskHandle_t task = xTaskGetHandle(monitoredTasks[i].name);
+    if (task == nullptr) {
+      continue;
+    }
+    uint32_t headroom = uxTaskGetStackHighWaterMark(task);
+    if (headroom < _MEMORY_STACK_MARGIN && !(reportedStacks & (1UL << i))) {
+      HX_LOG_WARN("Memory: stack of %s has %u bytes left", monitoredTasks[i].name, (unsigned)headroom);
+      reportedStacks |= 1UL << i;
+    }
+  }
+}
+
+void MemoryMonitor::print(Print &out) const {
+  out.println("task,stack,used,headroom");
+  for (uint8_t i = 0; i < monitoredTaskCount; i++) {
+    TaskHandle_t task = xTaskGetHandle(monitoredTasks[i].name);
+    if (task == nullptr) {
+      continue;
+    }
+    uint32_t headroom = uxTaskGetStackHighWaterMark(task);
+    out.printf("%s,%u,%u,%u\n", monitoredTasks[i].name, (unsigned)monitoredTasks[i].stack,
+               (unsigned)(monitoredTasks[i].stack - headroom), (unsigned)headroom);
+  }
+
+  out.println("heap,free,minimum_free,largest_block,blocks,blocks_since_setup");
+  const MemoryHeap *snapshots[] = { &setupInternal, &setupPsram };
+  const uint32_t caps[] = { MALLOC_CAP_INTERNAL, MALLOC_CAP_SPIRAM };
+  const char *names[] = { "internal", "psram" };
+  for (uint8_t i = 0; i < 2; i++) {
+    MemoryHeap current = heap(caps[i]);
+    out.printf("%s,%u,%u,%u,%u,%d\n", names[i], (unsigned)current.free, (unsigned)current.minimumFree,
+               (unsigned)current.largestBlock, (unsigned)current.blocks,
+               setupDone ? (int)(current.blocks - snapshots[i]->blocks) : 0);
+  }
+
+  MemoryAllocations after = getAllocationsAfterSetup();
+  out.printf("new after setup,%u,%u bytes,last from 0x%08x\n", (unsigned)after.count,
+             (unsigned)after.bytes, (unsigned)after.lastCaller);
+}
+
+MemoryAllocations MemoryMonitor::getAllocationsAfterSetup() const {
+  if (!setupDone) {
+    return { 0, 0, 0 };
+  }
+  MemoryAllocations now = allocations();
+  return { now.count - setupNew.count, now.bytes - setupNew.bytes,
+           now.count != setupNew.count ? now.lastCaller : 0 };
+}
+
+MemoryHeap MemoryMonitor::heap(uint32_t caps) {
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, caps);
+  return { (uint32_t)info.total_free_bytes, (uint32_t)info.minimum_free_bytes,
+           (uint32_t)info.largest_free_block, (uint32_t)info.allocated_blocks };
+}
+
+MemoryAllocations MemoryMonitor::allocations() {
+  return { newCount.load(std::memory_order_relaxed), newBytes.load(std::memory_order_relaxed),
+           newCaller.load(std::memory_order_relaxed) };
+}
@@ -0,0 +1,123 @@
+/**
+ * @file memory_hx.h
+ * @brief Runtime monitor of the heap, the PSRAM and the task stacks.
+ * @details This file contains the `MemoryMonitor` class, which reports the stack high-water
+ *          marks of the firmware tasks, the free and largest blocks of the internal heap and the
+ *          PSRAM, and the allocations made after `setup()`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef MEMORY_HX_H
+#define MEMORY_HX_H
+
+#include <Arduino.h>
+#include "globals_hx.h"
+
+/**
+ * @brief Allocation counters of `operator new`.
+ */
+typedef struct {
+  uint32_t count;        ///< Number of allocations.
+  uint32_t bytes;        ///< Requested bytes.
+  uintptr_t lastCaller;  ///< Return address of the last allocating call.
+} MemoryAllocations;
+
+/**
+ * @brief Heap figures of one memory type.
+ */
+typedef struct {
+  uint32_t free;          ///< Free bytes.
+  uint32_t minimumFree;   ///< Lowest free bytes since boot.
+  uint32_t largestBlock;  ///< Largest allocatable block in bytes.
+  uint32_t blocks;        ///< Allocated blocks.
+} MemoryHeap;
+
+/**
+ * @brief Monitor of the heap, the PSRAM and the task stacks.
+ * @details The firmware follows a no-allocation-after-setup policy: all buffers are allocated
+ *          in `setup()`, so the heap cannot fragment during a run. `markSetupDone()` takes a
+ *          snapshot of the heap and the `operator new` counters; every allocation after it
+ *          is counted. `update()` warns through the logger when this count grows or a task has
+ *          less than `_MEMORY_STACK_MARGIN` bytes of stack left. Plain `malloc()` calls are not
+ *          counted individually but show up in the block count of the heap.
+ *
+ *          The stacks of the loop task and the tasks of the logger, the run log and the
+ *          telemetry are checked. On the ESP32 the high-water mark is in bytes.
+ *
+ * ### Example Usage
+ * ```cpp
+ * void setup() {
+ *   ...
+ *   memoryMonitor.markSetupDone();
+ * }
+ *
+ * void loop() {
+ *   memoryMonitor.update();
+ * }
+ * ```
+ */
+class MemoryMonitor {
+private:
+  MemoryHeap setupInternal;       /**< Internal heap at the end of `setup()`. */
+  MemoryHeap setupPsram;          /**< PSRAM at the end of `setup()`. */
+  MemoryAllocations setupNew;     /**< `operator new` counters at the end of `setup()`. */
+  bool setupDone;                 /**< True after `markSetupDone()`. */
+  uint32_t reportedAllocations;   /**< Allocations after setup at the last warning. */
+  uint32_t reportedStacks;        /**< Bit per task that was reported as low. */
+  unsigned long lastCheckMillis;  /**< Time of the last check. */
+
+public:
+  /**
+   * @brief Constructor: Initializes the monitor.
+   */
+  MemoryMonitor();
+
+  /**
+   * @brief Takes the snapshot that later allocations are compared with.
+   */
+  void markSetupDone();
+
+  /**
+   * @brief Checks the allocations and stacks every `_MEMORY_CHECK_INTERVAL`.
+   */
+  void update();
+
+  /**
+   * @brief Prints the stacks, the heaps and the allocations after setup.
+   * @param out Destination, e.g. `Serial`.
+   */
+  void print(Print &out) const;
+
+  /**
+   * @brief Gets the allocations by `operator new` after `markSetupDone()`.
+   * @return Counters, all zero before `markSetupDone()`.
+   */
+  MemoryAllocations getAllocationsAfterSetup() const;
+
+  /**
+   * @brief Gets the figures of a heap.
+   * @param caps Capabilities, `MALLOC_CAP_INTERNAL` or `MALLOC_CAP_SPIRAM`.
+   * @return Heap figures.
+   */
+  static MemoryHeap heap(uint32_t caps);
+
+  /**
+   * @brief Gets the `operator new` counters since boot.
+   * @return Counters.
+   */
+  static MemoryAllocations allocations();
+};
+
+
+#endif  // MEMORY_HX_H
@@ -0,0 +1,134 @@
+/**
+ * @file notify_hx.cpp
+ * @brief Implementation of the alert notifier.
+ * @details Contains the alert patterns, the WS2812 encoding for the RMT peripheral and the
+ *          worker task of `Notifier`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Buzzer on the fixed LEDC channel `_NOTIFY_BUZZER_CHANNEL`
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "notify_hx.h"
+#include "log_hx.h"
+
+// Rising three-tone chime in green
+static const NotifyStep runFinishedSteps[] = {
+  { 0, 64, 0, 1047, 150 },
+  { 0, 64, 0, 1319, 150 },
+  { 0, 64, 0, 1568, 300 },
+  { 0, 0, 0, 0, 200 },
+};
+// Two short beeps in yellow
+static const NotifyStep doorOpenSteps[] = {
+  { 64, 48, 0, 2000, 100 },
+  { 0, 0, 0, 0, 100 },
+  { 64, 48, 0, 2000, 100 },
+  { 0, 0, 0, 0, 700 },
+};
+// Alternating alarm in red
+static const NotifyStep faultSteps[] = {
+  { 96, 0, 0, 2500, 250 },
+  { 0, 0, 0, 1800, 250 },
+};
+
+#define PATTERN(steps, repeat) { steps, sizeof(steps) / sizeof(steps[0]), repeat }
+
+const NotifyPattern notifyPatterns[NOTIFY_COUNT] = {
+  PATTERN(runFinishedSteps, 2),
+  PATTERN(doorOpenSteps, 2),
+  PATTERN(faultSteps, 4),
+};
+
+// WS2812 bit timing in ticks of 100 ns: a 0 is 0.4 µs high and 0.8 µs low, a 1 the reverse
+#define WS2812_T0H 4
+#define WS2812_T0L 8
+#define WS2812_T1H 8
+#define WS2812_T1L 4
+
+Notifier::Notifier(uint8_t led, uint8_t buzzer)
+  : ledPin(led), buzzerPin(buzzer), queue(nullptr), task(nullptr), played(0), dropped(0) {
+  memset(symbols, 0, sizeof(symbols));
+}
+
+bool Notifier::begin() {
+  if (!rmtInit(ledPin, RMT_TX_MODE, RMT_MEM_NUM_BLOCKS_1, _NOTIFY_RMT_FREQUENCY)) {
+    HX_LOG_ERROR("Notify: cannot set up RMT on pin %u", ledPin);
+    return false;
+  }
+  // A timer of its own, the tones must not retune the heater PWM
+  if (!ledcAttachChannel(buzzerPin, _NOTIFY_BUZZER_FREQUENCY, _NOTIFY_BUZZER_RESOLUTION, _NOTIFY_BUZZER_CHANNEL)) {
+    HX_LOG_ERROR("Notify: cannot attach LEDC channel %u on pin %u", _NOTIFY_BUZZER_CHANNEL, buzzerPin);
+    return false;
+  }
+  ledcWriteTone(buzzerPin, 0);
+  setLed(0, 0, 0);
+
+  queue = xQueueCreate(_NOTIFY_QUEUE_LENGTH, sizeof(uint8_t));
+  if (queue == nullptr
+      || xTaskCreatePinnedToCore(workerTask, "notify", _NOTIFY_TASK_STACK, this, _NOTIFY_TASK_PRIORITY, &task, 0)
+           != pdPASS) {
+    HX_LOG_ERROR("Notify: cannot start worker task");
+    task = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool Notifier::notify(enumNotification event) {
+  uint8_t item = event;
+  if (task == nullptr || xQueueSend(queue, &item, 0) != pdTRUE) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+void Notifier::setLed(uint8_t red, uint8_t green, uint8_t blue) {
+  // The previous frame is 30 µs long, the steps are milliseconds apart
+  while (!rmtTransmitCompleted(ledPin)) {
+    taskYIELD();
+  }
+  uint32_t grb = ((uint32_t)green << 16) | ((uint32_t)red << 8) | blue;
+  for (uint8_t i = 0; i < 24; i++) {
+    bool one = grb & (1UL << (23 - i));
+    symbols[i].level0 = 1;
+    symbols[i].duration0 = one ? WS2812_T1H : WS2812_T0H;
+    symbols[i].level1 = 0;
+    symbols[i].duration1 = one ? WS2812_T1L : WS2812_T0L;
+  }
+  rmtWriteAsync(ledPin, symbols, 24);
+}
+
+void Notifier::play(const NotifyPattern &pattern) {
+  for (uint8_t r = 0; r < pattern.repeat; r++) {
+    for (uint8_t i = 0; i < pattern.count; i++) {
+      const NotifyStep &step = pattern.steps[i];
+      setLed(step.red, step.green, step.blue);
+      ledcWriteTone(buzzerPin, step.tone);
+      vTaskDelay(pdMS_TO_TICKS(step.time));
+    }
+  }
+  ledcWriteTone(buzzerPin, 0);
+  setLed(0, 0, 0);
+  played.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Notifier::workerTask(void *parameter) {
+  Notifier *notifier = (Notifier *)parameter;
+  uint8_t event;
+  for (;;) {
+    if (xQueueReceive(notifier->queue, &event, portMAX_DELAY) == pdTRUE && event < NOTIFY_COUNT) {
+      notifier->play(notifyPatterns[event]);
+    }
+  }
+}
@@ -0,0 +1,144 @@
+/**
+ * @file notify_hx.h
+ * @brief Alerts on the onboard RGB LED and the buzzer.
+ * @details This file contains the `Notifier` class, which plays light and tone patterns for
+ *          events such as a finished run, an open door or a fault without loading the loop.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef NOTIFY_HX_H
+#define NOTIFY_HX_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "globals_hx.h"
+
+/** Events with an alert pattern. */
+enum enumNotification {
+  NOTIFY_RUN_FINISHED,  ///< The run reached its target time.
+  NOTIFY_DOOR_OPEN,     ///< The temperature fell far below the setpoint during a hold.
+  NOTIFY_FAULT,         ///< No valid sensor data or a stuck I2C bus.
+  NOTIFY_COUNT          ///< Number of events.
+};
+
+/**
+ * @brief One step of an alert pattern.
+ */
+typedef struct {
+  uint8_t red;    ///< Red level of the LED.
+  uint8_t green;  ///< Green level of the LED.
+  uint8_t blue;   ///< Blue level of the LED.
+  uint16_t tone;  ///< Buzzer frequency in Hz, 0 for silence.
+  uint16_t time;  ///< Duration of the step in milliseconds.
+} NotifyStep;
+
+/**
+ * @brief Alert pattern of one event.
+ */
+typedef struct {
+  const NotifyStep *steps;  ///< Steps played in order.
+  uint8_t count;            ///< Number of steps.
+  uint8_t repeat;           ///< Number of times the steps are played.
+} NotifyPattern;
+
+/**
+ * @brief Table of the alert patterns, indexed by `enumNotification`.
+ */
+extern const NotifyPattern notifyPatterns[NOTIFY_COUNT];
+
+/**
+ * @brief Player of the alert patterns on the WS2812 LED and the buzzer.
+ * @details `notify()` only queues the event and may be called from any task. A worker task
+ *          on core 0 plays the patterns one after the other and sleeps between the steps.
+ *          The waveforms come from the peripherals:
+ *          - The WS2812 frame is sent by the RMT peripheral from a symbol buffer. The common
+ *            bit-banged driver disables the interrupts for the 30 µs of a frame, which would
+ *            delay the sensor reads and the I2C driver; the RMT transmits with interrupts on
+ *            and without the CPU.
+ *          - The buzzer tone is a square wave of the LEDC peripheral, changed once per step.
+ *
+ *          A full queue drops the event instead of blocking the caller. Without the worker
+ *          task, e.g. when its creation failed, the events are dropped as well.
+ *
+ * ### Example Usage
+ * ```cpp
+ * Notifier notifier(_PIN_RGB_LED, _PIN_BUZZER);
+ *
+ * void setup() {
+ *   notifier.begin();
+ * }
+ *
+ * void onRunFinished() {
+ *   notifier.notify(NOTIFY_RUN_FINISHED);
+ * }
+ * ```
+ */
+class Notifier {
+private:
+  const uint8_t ledPin;          /**< Data pin of the WS2812. */
+  const uint8_t buzzerPin;       /**< Pin of the passive buzzer. */
+  rmt_data_t symbols[24];        /**< RMT symbols of the current LED frame, read by the peripheral. */
+  QueueHandle_t queue;           /**< Events waiting to be played. */
+  TaskHandle_t task;             /**< Worker task, nullptr if not started. */
+  std::atomic<uint32_t> played;  /**< Patterns played since boot. */
+  std::atomic<uint32_t> dropped; /**< Events dropped on a full queue or without worker. */
+
+  void setLed(uint8_t red, uint8_t green, uint8_t blue);
+  void play(const NotifyPattern &pattern);
+
+  static void workerTask(void *parameter);
+
+public:
+  /**
+   * @brief Constructor: Initializes the notifier.
+   * @param led Data pin of the WS2812.
+   * @param buzzer Pin of the passive buzzer.
+   */
+  Notifier(uint8_t led, uint8_t buzzer);
+
+  /**
+   * @brief Sets up the RMT and LEDC channels, turns both outputs off and starts the worker task.
+   * @return true if the notifier is ready.
+   */
+  bool begin();
+
+  /**
+   * @brief Queues the pattern of an event; returns at once.
+   * @param event Event to announce.
+   * @return false if the event was dropped.
+   */
+  bool notify(enumNotification event);
+
+  /**
+   * @brief Gets the number of played patterns.
+   * @return Patterns since boot.
+   */
+  uint32_t getPlayed() const {
+    return played;
+  }
+
+  /**
+   * @brief Gets the number of dropped events.
+   * @return Dropped events since boot.
+   */
+  uint32_t getDropped() const {
+    return dropped;
+  }
+};
+
+
+#endif  // NOTIFY_HX_H
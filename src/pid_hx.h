@@ -6,6 +6,11 @@
  *
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Optional external input rate for the derivative term
+ * - **2026-10-19**: Getters for the tuning parameters
+ * - **2026-10-19**: Getter for the sample time
+ * - **2026-10-19**: Sample time measured on the loop pass time `loopMillis()`
+ * - **2026-10-19**: Integral and input difference scaled to the elapsed time of a late computation
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -20,6 +25,7 @@
 #define PID_HX_H
 
 #include <Arduino.h>
+#include "input_hx.h"
 
 /**
  * @brief PID controller class for controlling systems based on feedback.
@@ -58,7 +64,10 @@ private:
   unsigned long lastTime;        /**< Timestamp of the last computation. */
   float input, output, setpoint; /**< Process variable, output, and setpoint values. */
   float outputSum, lastInput;    /**< Integral term and previous process variable value. */
+  float inputRate;               /**< External input rate per second, used if `useInputRate` is set. */
+  bool useInputRate;             /**< Flag to take the derivative from `inputRate` instead of the input difference. */
   float kp, ki, kd;              /**< PID tuning parameters. */
+  float dispKp, dispKi, dispKd;  /**< Tuning parameters as set by the user. */
   int sampleTime;                /**< Sample time in milliseconds. */
   float outMin, outMax;          /**< Minimum and maximum output limits. */
   bool inAuto;                   /**< Flag indicating if the controller is in automatic mode. */
@@ -76,7 +85,7 @@ public:
    */
   PID_heatX(float Kp, float Ki, float Kd, int ControllerDirection)
     : kp(Kp), ki(Ki), kd(Kd), sampleTime(100), inAuto(false), lastTime(0),
-      outputSum(0), lastInput(0), pOnE(true), pOnM(false),
+      outputSum(0), lastInput(0), inputRate(0), useInputRate(false), pOnE(true), pOnM(false),
       controllerDirection(ControllerDirection), setpoint(0),
       input(0), output(0), outMin(0), outMax(255) {
     SetTunings(Kp, Ki, Kd);
@@ -88,24 +97,28 @@ public:
    * @details Computes the PID output based on the current setpoint and input.  
    *          This function should be called frequently, preferably in the loop function.  
    *          New computations are performed only after the specified sample time has elapsed.
+   *          If more time has elapsed, e.g. because the input is only updated once per sensor
+   *          sample, the integral and the input difference are scaled to the elapsed time, so the
+   *          gains stay those of `SetTunings()` at any input rate.
    * @return 1 if a new output is computed, 0 otherwise.
    */
   int Compute() {
     if (!inAuto) return 0;  // No computation if not in automatic mode
 
-    unsigned long now = millis();
+    unsigned long now = loopMillis();
     int timeChange = now - lastTime;
 
     if (timeChange >= sampleTime) {
       // Calculate error and derivative
       float error = setpoint - input;
-      float dInput = input - lastInput;
+      float elapsed = (float)timeChange / (float)sampleTime;  // Sample times since the last computation
+      float dInput = useInputRate ? inputRate * ((float)sampleTime / 1000.0f) : (input - lastInput) / elapsed;
 
       // Update the integral term
-      outputSum += (ki * error);
+      outputSum += (ki * error * elapsed);
 
       // Adjust for proportional on measurement (if enabled)
-      if (pOnM) outputSum -= pOnMKp * dInput;
+      if (pOnM) outputSum -= pOnMKp * dInput * elapsed;
 
       // Clamp the output sum to prevent windup
       if (outputSum > outMax) outputSum = outMax;
@@ -140,6 +153,10 @@ public:
   void SetTunings(float Kp, float Ki, float Kd) {
     if (Kp < 0 || Ki < 0 || Kd < 0) return;
 
+    dispKp = Kp;
+    dispKi = Ki;
+    dispKd = Kd;
+
     float sampleTimeInSec = ((float)sampleTime) / 1000.0f;
     kp = Kp;
     ki = Ki * sampleTimeInSec;
@@ -216,8 +233,10 @@ public:
 
   /**
    * @brief Initializes the PID controller state.
+   * @details The next `Compute()` runs at once and counts as one sample time.
    */
   void Initialize() {
+    lastTime = loopMillis() - sampleTime;
     outputSum = output;
     if (outputSum > outMax) outputSum = outMax;
     else if (outputSum < outMin) outputSum = outMin;
@@ -239,6 +258,20 @@ public:
    */
   void SetInput(float newInput) {
     input = newInput;
+    useInputRate = false;
+  }
+
+  /**
+   * @brief Sets the process variable input together with its rate of change.
+   * @details Use this when a filter estimates the rate (e.g. `Kalman_heatX`). The derivative
+   *          term then uses this rate instead of differentiating the input between samples.
+   * @param newInput Current process variable value.
+   * @param newInputRate Rate of change of the process variable per second.
+   */
+  void SetInput(float newInput, float newInputRate) {
+    input = newInput;
+    inputRate = newInputRate;
+    useInputRate = true;
   }
 
   /**
@@ -265,6 +298,38 @@ public:
     return output;
   }
 
+  /**
+   * @brief Gets the proportional gain as set by `SetTunings()`.
+   * @return Proportional gain.
+   */
+  float GetKp() const {
+    return dispKp;
+  }
+
+  /**
+   * @brief Gets the integral gain as set by `SetTunings()`.
+   * @return Integral gain.
+   */
+  float GetKi() const {
+    return dispKi;
+  }
+
+  /**
+   * @brief Gets the derivative gain as set by `SetTunings()`.
+   * @return Derivative gain.
+   */
+  float GetKd() const {
+    return dispKd;
+  }
+
+  /**
+   * @brief Gets the sample time as set by `SetSampleTime()`.
+   * @return Sample time in milliseconds.
+   */
+  int GetSampleTime() const {
+    return sampleTime;
+  }
+
   /**
    * @brief Gets the current setpoint value.
    * @return Current setpoint value.
@@ -0,0 +1,258 @@
+/**
+ * @file preset_hx.cpp
+ * @brief Implementation of the material preset store.
+ * @details Contains the JSON import, the binary index handling and the preset lookup of `PresetStore`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "preset_hx.h"
+#include "globals_hx.h"
+#include "log_hx.h"
+
+#include <FFat.h>
+#include <ArduinoJson.h>
+#include <esp_rom_crc.h>
+
+#define _PRESET_INDEX_MAGIC 0x49505848  ///< "HXPI" in little endian
+#define _PRESET_INDEX_VERSION 1         ///< Layout version of `PresetRecord`
+
+static_assert(sizeof(PresetRecord) == 20, "PresetRecord is part of the index file layout");
+static_assert(sizeof(PresetIndexHeader) == 20, "PresetIndexHeader is part of the index file layout");
+
+static const char *const dryingProfileNames[] = { "standard", "gentle", "hygroscopic" };
+
+PresetStore::PresetStore()
+  : header({ 0, 0, 0, 0, 0, 0 }), count(0), fromFile(false) {
+  loadBuiltIn();
+}
+
+bool PresetStore::begin() {
+  if (!FFat.begin()) {
+    HX_LOG_WARN("Presets: FAT not mounted, using built-in presets");
+    return false;
+  }
+
+  if (!FFat.exists(_PRESET_FILE_JSON) && !writeJsonTemplate()) {
+    HX_LOG_WARN("Presets: cannot write template, using built-in presets");
+    return false;
+  }
+
+  uint32_t jsonSize;
+  uint32_t jsonCrc;
+  if (!checksumFile(_PRESET_FILE_JSON, jsonSize, jsonCrc)) {
+    return false;
+  }
+
+  if (loadIndex(jsonSize, jsonCrc)) {
+    fromFile = true;
+    HX_LOG_INFO("Presets: %d loaded from index", count);
+    return true;
+  }
+
+  if (buildIndex(jsonSize, jsonCrc)) {
+    fromFile = true;
+    HX_LOG_INFO("Presets: %d compiled from JSON", count);
+    return true;
+  }
+
+  HX_LOG_WARN("Presets: invalid JSON, using built-in presets");
+  loadBuiltIn();
+  return false;
+}
+
+MaterialPreset PresetStore::get(size_t index) const {
+  if (index >= count) {
+    index = 0;
+  }
+  const PresetRecord &record = records[index];
+  return { record.name, record.temperature, record.humidity, record.hours, (enumDryingProfile)record.profile };
+}
+
+int PresetStore::find(const char *name) const {
+  int low = 0;
+  int high = (int)count - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    int cmp = strncmp(name, records[mid].name, _PRESET_NAME_LENGTH);
+    if (cmp == 0) return mid;
+    if (cmp < 0) high = mid - 1;
+    else low = mid + 1;
+  }
+  return -1;
+}
+
+bool PresetStore::checksumFile(const char *path, uint32_t &size, uint32_t &crc) {
+  File file = FFat.open(path, FILE_READ);
+  if (!file) {
+    return false;
+  }
+
+  // Checksumming the raw bytes is much cheaper than parsing them
+  uint8_t buffer[256];
+  size = 0;
+  crc = 0;
+  size_t len;
+  while ((len = file.read(buffer, sizeof(buffer))) > 0) {
+    crc = esp_rom_crc32_le(crc, buffer, len);
+    size += len;
+  }
+  file.close();
+  return true;
+}
+
+bool PresetStore::loadIndex(uint32_t jsonSize, uint32_t jsonCrc) {
+  File file = FFat.open(_PRESET_FILE_INDEX, FILE_READ);
+  if (!file) {
+    return false;
+  }
+
+  PresetIndexHeader fileHeader;
+  bool valid = file.read((uint8_t *)&fileHeader, sizeof(fileHeader)) == sizeof(fileHeader)
+               && fileHeader.magic == _PRESET_INDEX_MAGIC
+               && fileHeader.version == _PRESET_INDEX_VERSION
+               && fileHeader.count > 0 && fileHeader.count <= _PRESET_MAX_COUNT
+               && fileHeader.jsonSize == jsonSize
+               && fileHeader.jsonCrc == jsonCrc;
+
+  // One read of the complete record image, the records are used as they are
+  size_t recordBytes = fileHeader.count * sizeof(PresetRecord);
+  valid = valid && file.read((uint8_t *)records, recordBytes) == recordBytes
+          && esp_rom_crc32_le(0, (const uint8_t *)records, recordBytes) == fileHeader.recordCrc;
+  file.close();
+
+  if (!valid) {
+    loadBuiltIn();
+    return false;
+  }
+  header = fileHeader;
+  count = fileHeader.count;
+  return true;
+}
+
+bool PresetStore::buildIndex(uint32_t jsonSize, uint32_t jsonCrc) {
+  File file = FFat.open(_PRESET_FILE_JSON, FILE_READ);
+  if (!file) {
+    return false;
+  }
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, file);
+  file.close();
+  if (error) {
+    HX_LOG_ERROR("Presets: JSON error %s", error.c_str());
+    return false;
+  }
+
+  count = 0;
+  memset(records, 0, sizeof(records));
+  int position = 0;
+  for (JsonObject preset : doc["presets"].as<JsonArray>()) {
+    position++;
+    const char *name = preset["name"] | "";
+    int temperature = preset["temperature"] | 0;
+    int humidity = preset["humidity"] | _HUM_PRESET;
+    int hours = preset["hours"] | _TIME_PRESET;
+    const char *profileName = preset["profile"] | dryingProfileNames[DRYING_STANDARD];
+
+    if (name[0] == '\0' || strlen(name) >= _PRESET_NAME_LENGTH
+        || temperature < _TEMP_MIN || temperature > _TEMP_MAX
+        || humidity < _HUM_MIN || humidity > _HUM_MAX
+        || hours < _TIME_MIN || hours > _TIME_MAX) {
+      HX_LOG_WARN("Presets: skipping invalid preset %d", position);  // The name dies with the document
+      continue;
+    }
+    if (count >= _PRESET_MAX_COUNT) {
+      HX_LOG_WARN("Presets: more than %d presets, rest ignored", _PRESET_MAX_COUNT);
+      break;
+    }
+
+    PresetRecord &record = records[count++];
+    strncpy(record.name, name, _PRESET_NAME_LENGTH - 1);
+    record.temperature = temperature;
+    record.humidity = humidity;
+    record.hours = hours;
+    record.profile = DRYING_STANDARD;
+    for (uint8_t i = 0; i < sizeof(dryingProfileNames) / sizeof(dryingProfileNames[0]); i++) {
+      if (strcmp(profileName, dryingProfileNames[i]) == 0) record.profile = i;
+    }
+  }
+  if (count == 0) {
+    return false;
+  }
+  sortRecords();
+
+  size_t recordBytes = count * sizeof(PresetRecord);
+  header = { _PRESET_INDEX_MAGIC, _PRESET_INDEX_VERSION, count, jsonSize, jsonCrc,
+             esp_rom_crc32_le(0, (const uint8_t *)records, recordBytes) };
+
+  // A failed write only costs a rebuild on the next boot
+  FFat.remove(_PRESET_FILE_INDEX);
+  File index = FFat.open(_PRESET_FILE_INDEX, FILE_WRITE);
+  if (!index
+      || index.write((const uint8_t *)&header, sizeof(header)) != sizeof(header)
+      || index.write((const uint8_t *)records, recordBytes) != recordBytes) {
+    HX_LOG_ERROR("Presets: cannot write index");
+  }
+  if (index) index.close();
+  return true;
+}
+
+bool PresetStore::writeJsonTemplate() {
+  JsonDocument doc;
+  JsonArray presets = doc["presets"].to<JsonArray>();
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    JsonObject preset = presets.add<JsonObject>();
+    preset["name"] = materialPresets[i].name;
+    preset["temperature"] = materialPresets[i].temperature;
+    preset["humidity"] = materialPresets[i].humidity;
+    preset["hours"] = materialPresets[i].hours;
+    preset["profile"] = dryingProfileNames[materialPresets[i].profile];
+  }
+
+  File file = FFat.open(_PRESET_FILE_JSON, FILE_WRITE);
+  if (!file) {
+    return false;
+  }
+  bool written = serializeJsonPretty(doc, file) > 0;
+  file.close();
+  return written;
+}
+
+void PresetStore::loadBuiltIn() {
+  fromFile = false;
+  memset(records, 0, sizeof(records));
+  count = 0;
+  for (size_t i = 0; i < _MATERIAL_COUNT && i < _PRESET_MAX_COUNT; i++) {
+    PresetRecord &record = records[count++];
+    strncpy(record.name, materialPresets[i].name, _PRESET_NAME_LENGTH - 1);
+    record.temperature = materialPresets[i].temperature;
+    record.humidity = materialPresets[i].humidity;
+    record.hours = materialPresets[i].hours;
+    record.profile = materialPresets[i].profile;
+  }
+  sortRecords();
+}
+
+void PresetStore::sortRecords() {
+  // Insertion sort, the table is small and mostly sorted
+  for (uint16_t i = 1; i < count; i++) {
+    PresetRecord record = records[i];
+    int j = i - 1;
+    while (j >= 0 && strncmp(records[j].name, record.name, _PRESET_NAME_LENGTH) > 0) {
+      records[j + 1] = records[j];
+      j--;
+    }
+    records[j + 1] = record;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+/**
+ * @file preset_hx.h
+ * @brief User-extensible material preset store on the FAT partition.
+ * @details This file contains the `PresetStore` class, which loads the material presets
+ *          from a JSON file and caches them in a compact binary index.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Added `PresetNameList` for menu item lists
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef PRESET_HX_H
+#define PRESET_HX_H
+
+#include <Arduino.h>
+#include "globals_hx.h"
+
+/**
+ * @brief One fixed-size preset record of the binary index.
+ */
+typedef struct {
+  char name[_PRESET_NAME_LENGTH];  ///< Zero terminated material name.
+  int16_t temperature;             ///< Preset temperature value (°C).
+  uint8_t humidity;                ///< Preset target humidity (%).
+  uint8_t hours;                   ///< Default drying time (hours).
+  uint8_t profile;                 ///< Drying profile, see `enumDryingProfile`.
+  uint8_t reserved[3];             ///< Padding, always zero.
+} PresetRecord;
+
+/**
+ * @brief Header of the binary index file.
+ */
+typedef struct {
+  uint32_t magic;      ///< File identifier `_PRESET_INDEX_MAGIC`.
+  uint16_t version;    ///< Layout version `_PRESET_INDEX_VERSION`.
+  uint16_t count;      ///< Number of records following the header.
+  uint32_t jsonSize;   ///< Size of the JSON file the index was built from.
+  uint32_t jsonCrc;    ///< CRC32 of the JSON file the index was built from.
+  uint32_t recordCrc;  ///< CRC32 of all records.
+} PresetIndexHeader;
+
+/**
+ * @brief Material preset store backed by a JSON file and a binary index on FAT.
+ * @details Users can add or change materials by editing `_PRESET_FILE_JSON` on the FAT
+ *          partition. Parsing JSON on every boot would cost time, so the store compiles the
+ *          file once into `_PRESET_FILE_INDEX`: a header plus fixed-size records sorted by
+ *          name and protected by a CRC.
+ *
+ *          On boot only the raw bytes of the JSON file are checksummed and compared with the
+ *          header. If they match, the records are loaded with a single read into a static
+ *          image and used in place. The index is rebuilt only when the JSON file changed or
+ *          the index is missing or corrupt.
+ *
+ *          If the JSON file does not exist, it is created from the built-in `materialPresets`
+ *          so users have a template to edit. If the partition cannot be mounted or the JSON is
+ *          invalid, the store serves the built-in presets.
+ *
+ * ### JSON Format
+ * ```json
+ * {
+ *   "presets": [
+ *     { "name": "PLA", "temperature": 50, "humidity": 20, "hours": 4, "profile": "gentle" }
+ *   ]
+ * }
+ * ```
+ * `profile` is one of `"standard"`, `"gentle"` or `"hygroscopic"`.
+ *
+ * ### Example Usage
+ * ```cpp
+ * PresetStore presets;
+ *
+ * void setup() {
+ *   presets.begin();
+ *   int pla = presets.find("PLA");
+ *   if (pla >= 0) {
+ *     ApplyTemperature(presets.get(pla).temperature);
+ *   }
+ * }
+ * ```
+ */
+class PresetStore {
+private:
+  PresetIndexHeader header;                /**< Header of the loaded index. */
+  PresetRecord records[_PRESET_MAX_COUNT]; /**< Record image, sorted by name. */
+  uint16_t count;                          /**< Number of valid records. */
+  bool fromFile;                           /**< True if the records come from the FAT partition. */
+
+  bool checksumFile(const char *path, uint32_t &size, uint32_t &crc);
+  bool loadIndex(uint32_t jsonSize, uint32_t jsonCrc);
+  bool buildIndex(uint32_t jsonSize, uint32_t jsonCrc);
+  bool writeJsonTemplate();
+  void loadBuiltIn();
+  void sortRecords();
+
+public:
+  /**
+   * @brief Constructor: Initializes the store with the built-in presets.
+   */
+  PresetStore();
+
+  /**
+   * @brief Mounts the FAT partition and loads the presets.
+   * @details Uses the binary index if it matches the JSON file, rebuilds it otherwise.
+   * @return true if the presets come from the FAT partition, false if the built-in presets are used.
+   */
+  bool begin();
+
+  /**
+   * @brief Gets the number of presets.
+   * @return Number of available presets.
+   */
+  size_t size() const {
+    return count;
+  }
+
+  /**
+   * @brief Gets a preset.
+   * @param index Preset index, sorted by name.
+   * @return The preset; its name points into the store and stays valid.
+   */
+  MaterialPreset get(size_t index) const;
+
+  /**
+   * @brief Gets the name of a preset.
+   * @param index Preset index, sorted by name.
+   * @return The name, or an empty string if the index is out of range.
+   */
+  const char *getName(size_t index) const {
+    return (index < count) ? records[index].name : "";
+  }
+
+  /**
+   * @brief Looks up a preset by name with a binary search.
+   * @param name Material name, case sensitive.
+   * @return Preset index, or -1 if the name is unknown.
+   */
+  int find(const char *name) const;
+
+  /**
+   * @brief Checks where the presets come from.
+   * @return true if the presets were loaded from the FAT partition.
+   */
+  bool isFromFile() const {
+    return fromFile;
+  }
+};
+
+/**
+ * @brief Read-only view of the preset names for menu item lists.
+ * @details Indexes the names like `PresetStore::get()`, sorted by name and including the user
+ *          presets, so a menu position can be passed to `get()` as is. The names are returned
+ *          as pointers into the store, nothing is copied or allocated.
+ *
+ * ### Example Usage
+ * ```cpp
+ * PresetNameList materialNames{ presetStore };
+ *
+ * for (size_t i = 0; i < materialNames.size(); i++) {
+ *   lcd.print(materialNames[i]);
+ * }
+ * ```
+ */
+struct PresetNameList {
+  const PresetStore &store;  ///< Store the names come from.
+
+  /**
+   * @brief Gets the number of names.
+   * @return Number of presets in the store.
+   */
+  size_t size() const {
+    return store.size();
+  }
+
+  /**
+   * @brief Gets a preset name.
+   * @param index Preset index, sorted by name.
+   * @return The name, or an empty string if the index is out of range.
+   */
+  const char *operator[](size_t index) const {
+    return store.getName(index);
+  }
+};
+
+
+#endif  // PRESET_HX_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+/**
+ * @file runlog_format_hx.h
+ * @brief File format of the run log, shared by the firmware and the host analyzer.
+ * @details This file defines the block layout, the record encoding and the index entries of the
+ *          run log written by `RunLogger`. It depends only on the C++ standard headers, so the
+ *          analyzer in `tools/analyze` uses it unchanged.
+ *
+ * ### File Layout
+ * The data file is a sequence of blocks, each a `RunLogBlockHeader` followed by `length` bytes
+ * of records. A block holds records of one run only. The header carries the first record in
+ * full, every further record is encoded relative to its predecessor:
+ * - varint `(dt << 1) | modeChanged`, `dt` in ms
+ * - the new mode as one byte, only if `modeChanged` is set
+ * - zigzag varints of the temperature, humidity and duty differences
+ *
+ * The index file holds one `RunLogIndexEntry` per block. `RunLogger` writes one data file and
+ * one index file per run; a data file of the older single-file layout holds several runs.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version, moved from `runlog_hx.h`
+ * - **2026-10-19**: One data file per run
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef RUNLOG_FORMAT_HX_H
+#define RUNLOG_FORMAT_HX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define _RUNLOG_MAGIC 0x4C525848  ///< "HXRL" in little endian
+#define _RUNLOG_VERSION 1         ///< Layout version of the log blocks
+#define _RUNLOG_RECORD_MAX 15     ///< Maximum size of one encoded record in bytes
+
+/**
+ * @brief One sample of a run.
+ */
+typedef struct {
+  uint32_t time;        ///< Sample time (ms since boot).
+  int16_t temperature;  ///< Temperature (0.01 °C).
+  int16_t humidity;     ///< Relative humidity (0.01 %).
+  uint16_t duty;        ///< Heater duty cycle (0.01 %).
+  uint8_t mode;         ///< Control phase, see `enumSensorProfile`.
+} RunLogRecord;
+
+/**
+ * @brief Header of one block of the log file.
+ */
+typedef struct {
+  uint32_t magic;       ///< Block identifier `_RUNLOG_MAGIC`.
+  uint32_t runId;       ///< Run the block belongs to.
+  uint32_t time;        ///< Time of the first record (ms since boot).
+  int16_t temperature;  ///< Temperature of the first record (0.01 °C).
+  int16_t humidity;     ///< Humidity of the first record (0.01 %).
+  uint16_t duty;        ///< Duty cycle of the first record (0.01 %).
+  uint8_t mode;         ///< Mode of the first record.
+  uint8_t version;      ///< Layout version `_RUNLOG_VERSION`.
+  uint16_t count;       ///< Number of records including the first one.
+  uint16_t length;      ///< Size of the payload following the header in bytes.
+  uint32_t crc;         ///< CRC32 of the header up to this field and of the payload.
+} RunLogBlockHeader;
+
+/**
+ * @brief Entry of the index file, one per block.
+ */
+typedef struct {
+  uint32_t runId;   ///< Run the block belongs to.
+  uint32_t offset;  ///< Position of the block in the data file.
+  uint32_t time;    ///< Time of the first record of the block (ms since boot).
+} RunLogIndexEntry;
+
+static_assert(sizeof(RunLogBlockHeader) == 28, "RunLogBlockHeader is part of the log file layout");
+static_assert(sizeof(RunLogIndexEntry) == 12, "RunLogIndexEntry is part of the index file layout");
+
+/**
+ * @brief Computes the CRC-32 of a block (IEEE 802.3, reflected polynomial 0xEDB88320).
+ * @details Gives the same result as `esp_rom_crc32_le()`, which the firmware uses instead.
+ * @param data Bytes to check.
+ * @param length Number of bytes.
+ * @param crc Running CRC, for checksums over several parts.
+ * @return CRC of the bytes.
+ */
+inline uint32_t runLogCrc32(const uint8_t *data, size_t length, uint32_t crc = 0) {
+  crc = ~crc;
+  while (length--) {
+    crc ^= *data++;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+/**
+ * @brief Encodes a record relative to its predecessor.
+ * @param out Destination, at least `_RUNLOG_RECORD_MAX` bytes.
+ * @param record Record to encode; `time` must not be before the time of `previous`.
+ * @param previous Previous record of the block.
+ * @return Number of bytes written.
+ */
+inline size_t runLogEncodeRecord(uint8_t *out, const RunLogRecord &record, const RunLogRecord &previous) {
+  uint8_t *start = out;
+  auto putVarint = [&out](uint32_t value) {
+    while (value >= 0x80) {
+      *out++ = (uint8_t)value | 0x80;
+      value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+  };
+  auto putZigzag = [&putVarint](int32_t value) {
+    putVarint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+  };
+
+  bool modeChanged = record.mode != previous.mode;
+  putVarint(((record.time - previous.time) << 1) | modeChanged);
+  if (modeChanged) *out++ = record.mode;
+  putZigzag(record.temperature - previous.temperature);
+  putZigzag(record.humidity - previous.humidity);
+  putZigzag((int32_t)record.duty - previous.duty);
+  return out - start;
+}
+
+/**
+ * @brief Decodes a record and advances the input.
+ * @param in Read position, advanced past the record.
+ * @param end End of the payload.
+ * @param record Receives the record.
+ * @param previous Previous record of the block, the first one is taken from the header.
+ * @return false if the record is truncated or malformed.
+ */
+inline bool runLogDecodeRecord(const uint8_t *&in, const uint8_t *end, RunLogRecord &record,
+                               const RunLogRecord &previous) {
+  auto getVarint = [&in, end](uint32_t &value) {
+    value = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+      if (in >= end) return false;
+      uint8_t byte = *in++;
+      value |= (uint32_t)(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return true;
+    }
+    return false;
+  };
+  auto getZigzag = [&getVarint](int32_t &value) {
+    uint32_t raw;
+    if (!getVarint(raw)) return false;
+    value = (int32_t)(raw >> 1) ^ -(int32_t)(raw & 1);
+    return true;
+  };
+
+  uint32_t head;
+  int32_t temperature, humidity, duty;
+  if (!getVarint(head)) return false;
+  record.time = previous.time + (head >> 1);
+  record.mode = previous.mode;
+  if (head & 1) {
+    if (in >= end) return false;
+    record.mode = *in++;
+  }
+  if (!getZigzag(temperature) || !getZigzag(humidity) || !getZigzag(duty)) return false;
+  record.temperature = previous.temperature + temperature;
+  record.humidity = previous.humidity + humidity;
+  record.duty = previous.duty + duty;
+  return true;
+}
+
+
+#endif  // RUNLOG_FORMAT_HX_H
@@ -0,0 +1,272 @@
+/**
+ * @file runlog_hx.cpp
+ * @brief Implementation of the binary run log.
+ * @details Contains the buffer handover and the writer task of `RunLogger`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ * - **2026-10-19**: Block writes traced
+ * - **2026-10-19**: Record encoding moved to `runlog_format_hx.h`
+ * - **2026-10-19**: One segment per run, the oldest runs deleted before an append beyond `_RUNLOG_MAX_SIZE`
+ * - **2026-10-19**: Free space of the file system checked before an append
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "runlog_hx.h"
+#include "log_hx.h"
+#include "storage_hx.h"
+#include "trace_hx.h"
+
+#include <esp_rom_crc.h>
+#include <stdlib.h>
+
+// Path of a segment file of a run, e.g. "/runlog/00000012.bin"
+static void segmentPath(char *path, size_t size, uint32_t run, const char *extension) {
+  snprintf(path, size, _RUNLOG_DIR "/%08u.%s", (unsigned)run, extension);
+}
+
+RunLogger::RunLogger()
+  : active(0), length(sizeof(RunLogBlockHeader)), count(0), last({ 0, 0, 0, 0, 0 }), blockStart(0),
+    runId(0), running(false), fs(nullptr), queue(nullptr), dropped(0), writeErrors(0), written(0),
+    size(0), evicted(0), oldestRun(1), fullRun(0) {
+  busy[0] = false;
+  busy[1] = false;
+}
+
+bool RunLogger::begin(fs::FS &fileSystem) {
+  fs = &fileSystem;
+
+  fs->mkdir(_RUNLOG_DIR);
+
+  // The log of the single-file layout becomes run 0, the first one to be deleted
+  if (fs->exists(_RUNLOG_LEGACY_DATA)) {
+    char path[32];
+    segmentPath(path, sizeof(path), 0, "bin");
+    fs->rename(_RUNLOG_LEGACY_DATA, path);
+    segmentPath(path, sizeof(path), 0, "idx");
+    fs->rename(_RUNLOG_LEGACY_INDEX, path);
+    HX_LOG_INFO("Run log: single-file log kept as run 0");
+  }
+
+  scanSegments();
+
+  queue = xQueueCreate(2, sizeof(uint8_t));
+  if (queue == nullptr
+      || xTaskCreatePinnedToCore(writerTask, "runlog", _RUNLOG_TASK_STACK, this, _RUNLOG_TASK_PRIORITY, nullptr, 0) != pdPASS) {
+    HX_LOG_ERROR("Run log: cannot start writer task");
+    fs = nullptr;
+    return false;
+  }
+  HX_LOG_INFO("Run log: last run %u, %u bytes", (unsigned)runId, (unsigned)size);
+  return true;
+}
+
+void RunLogger::startRun() {
+  if (fs == nullptr) {
+    return;
+  }
+  // A block never mixes two runs
+  if (count > 0 && !submit()) {
+    dropped += count;
+    length = sizeof(RunLogBlockHeader);
+    count = 0;
+  }
+  runId++;
+  running = true;
+  HX_LOG_INFO("Run log: run %u started", (unsigned)runId);
+}
+
+void RunLogger::stopRun() {
+  running = false;
+}
+
+void RunLogger::add(const RunLogRecord &record) {
+  if (!running) {
+    return;
+  }
+  if (length + _RUNLOG_RECORD_MAX > _RUNLOG_BLOCK_SIZE && !submit()) {
+    dropped++;
+    return;
+  }
+
+  uint8_t *buffer = buffers[active];
+  if (count == 0) {
+    // The first record of a block is stored in full in the header
+    RunLogBlockHeader *header = (RunLogBlockHeader *)buffer;
+    header->runId = runId;
+    header->time = record.time;
+    header->temperature = record.temperature;
+    header->humidity = record.humidity;
+    header->duty = record.duty;
+    header->mode = record.mode;
+    blockStart = millis();
+  } else {
+    length += runLogEncodeRecord(buffer + length, record, last);
+  }
+  count++;
+  last = record;
+}
+
+void RunLogger::update() {
+  if (count > 0 && (!running || millis() - blockStart >= _RUNLOG_FLUSH_INTERVAL)) {
+    submit();
+  }
+}
+
+void RunLogger::scanSegments() {
+  uint32_t newest = 0;
+  bool found = false;
+  File dir = fs->open(_RUNLOG_DIR, FILE_READ);
+  if (dir && dir.isDirectory()) {
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+      const char *name = strrchr(file.name(), '/');
+      name = name ? name + 1 : file.name();
+      char *end;
+      uint32_t run = strtoul(name, &end, 10);
+      if (end != name && *end == '.') {
+        size += file.size();
+        oldestRun = !found || run < oldestRun ? run : oldestRun;
+        newest = !found || run > newest ? run : newest;
+        found = true;
+      }
+      file.close();
+    }
+  }
+  if (dir) dir.close();
+  if (!found) {
+    return;
+  }
+
+  // The run ID continues from the last index entry; run 0 holds several runs
+  runId = newest;
+  char path[32];
+  segmentPath(path, sizeof(path), newest, "idx");
+  File index = fs->open(path, FILE_READ);
+  if (index) {
+    RunLogIndexEntry entry;
+    if (index.size() >= sizeof(entry)
+        && index.seek(index.size() - index.size() % sizeof(entry) - sizeof(entry))
+        && index.read((uint8_t *)&entry, sizeof(entry)) == sizeof(entry) && entry.runId > runId) {
+      runId = entry.runId;
+    }
+    index.close();
+  }
+}
+
+bool RunLogger::makeRoom(uint32_t run, size_t need) {
+  // The capture shares the file system, so its free space counts as well as the log size
+  bool fits = size + need <= _RUNLOG_MAX_SIZE && storageFree(*fs) >= need;
+  while (!fits && oldestRun < run) {
+    removeRun(oldestRun++);
+    fits = size + need <= _RUNLOG_MAX_SIZE && storageFree(*fs) >= need;
+  }
+  if (fits) {
+    return true;
+  }
+  if (fullRun != run) {
+    fullRun = run;
+    HX_LOG_WARN("Run log: run %u fills the log alone, dropping its records", (unsigned)run);
+  }
+  return false;
+}
+
+void RunLogger::removeRun(uint32_t run) {
+  static const char *const extensions[] = { "bin", "idx" };
+  bool removed = false;
+  for (const char *extension : extensions) {
+    char path[32];
+    segmentPath(path, sizeof(path), run, extension);
+    File file = fs->open(path, FILE_READ);
+    if (!file) {
+      continue;
+    }
+    uint32_t fileSize = file.size();
+    file.close();
+    if (fs->remove(path)) {
+      size -= fileSize < size ? fileSize : size.load();
+      removed = true;
+    }
+  }
+  if (removed) {
+    evicted++;
+    HX_LOG_INFO("Run log: run %u deleted to make room", (unsigned)run);
+  }
+}
+
+bool RunLogger::submit() {
+  uint8_t next = active ^ 1;
+  if (busy[next]) {
+    return false;
+  }
+
+  RunLogBlockHeader *header = (RunLogBlockHeader *)buffers[active];
+  header->magic = _RUNLOG_MAGIC;
+  header->version = _RUNLOG_VERSION;
+  header->count = count;
+  header->length = length - sizeof(RunLogBlockHeader);
+  uint32_t crc = esp_rom_crc32_le(0, buffers[active], offsetof(RunLogBlockHeader, crc));
+  header->crc = esp_rom_crc32_le(crc, buffers[active] + sizeof(RunLogBlockHeader), header->length);
+
+  busy[active] = true;
+  xQueueSend(queue, &active, 0);  // Never full, at most two buffers are in flight
+
+  active = next;
+  length = sizeof(RunLogBlockHeader);
+  count = 0;
+  return true;
+}
+
+void RunLogger::writeBlock(uint8_t buffer) {
+  HX_TRACE_SCOPE(TRACE_RUNLOG);
+  const RunLogBlockHeader *header = (const RunLogBlockHeader *)buffers[buffer];
+  size_t blockSize = sizeof(RunLogBlockHeader) + header->length;
+  RunLogIndexEntry entry = { header->runId, 0, header->time };
+
+  if (!makeRoom(header->runId, blockSize + sizeof(entry))) {
+    dropped += header->count;
+    return;
+  }
+
+  char path[32];
+  segmentPath(path, sizeof(path), header->runId, "bin");
+  File data = fs->open(path, FILE_APPEND);
+  if (!data) {
+    writeErrors++;
+    return;
+  }
+  entry.offset = data.size();
+  bool ok = data.write(buffers[buffer], blockSize) == blockSize;
+  data.close();
+
+  segmentPath(path, sizeof(path), header->runId, "idx");
+  File index = fs->open(path, FILE_APPEND);
+  ok = ok && index && index.write((const uint8_t *)&entry, sizeof(entry)) == sizeof(entry);
+  if (index) index.close();
+
+  if (ok) {
+    size += blockSize + sizeof(entry);
+    written += blockSize + sizeof(entry);
+  } else {
+    writeErrors++;
+  }
+}
+
+void RunLogger::writerTask(void *parameter) {
+  RunLogger *logger = (RunLogger *)parameter;
+  uint8_t buffer;
+  for (;;) {
+    if (xQueueReceive(logger->queue, &buffer, portMAX_DELAY) == pdTRUE) {
+      logger->writeBlock(buffer);
+      logger->busy[buffer] = false;
+    }
+  }
+}
@@ -0,0 +1,193 @@
+/**
+ * @file runlog_hx.h
+ * @brief Append-only binary log of the drying runs.
+ * @details This file contains the `RunLogger` class, which records every sample of a run in
+ *          delta-encoded blocks and writes them from a background task to the FAT partition
+ *          or an SD card. The file format is defined in `runlog_format_hx.h`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: File format moved to `runlog_format_hx.h`
+ * - **2026-10-19**: One segment per run, the oldest runs are deleted when the log is full
+ * - **2026-10-19**: Free space of the file system shared with the capture
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef RUNLOG_HX_H
+#define RUNLOG_HX_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "globals_hx.h"
+#include "runlog_format_hx.h"
+
+/**
+ * @brief Run logger with double-buffered writes from a background task.
+ * @details Records are encoded into one of two block buffers in RAM. When a block is full,
+ *          or `_RUNLOG_FLUSH_INTERVAL` has passed, it is handed to a low-priority writer task
+ *          and encoding continues in the other buffer. Each run is a segment in `_RUNLOG_DIR`:
+ *          the writer appends the block to `<run>.bin` and an entry to `<run>.idx`, so a reader
+ *          can seek to a time by scanning the small index instead of the log.
+ *
+ *          The loop task never waits for the file system. If both buffers are busy because a
+ *          write is slow, records are dropped and counted.
+ *
+ *          The log is append-only. Each block is protected by a CRC, so a block torn by a power
+ *          loss is detected by the reader. Before a block is appended, the size of all segments
+ *          is checked against `_RUNLOG_MAX_SIZE` and the free space against `storageFree()`;
+ *          if the block does not fit, the oldest runs are deleted as a whole until it does. The
+ *          run being written is never deleted: if it alone fills the log, its further records
+ *          are dropped and counted.
+ *
+ *          Segments of the single-file layout (`_RUNLOG_LEGACY_DATA`) are kept as the oldest
+ *          segment, run 0, and deleted first.
+ *
+ * ### Example Usage
+ * ```cpp
+ * RunLogger runLog;
+ *
+ * void setup() {
+ *   FFat.begin();
+ *   runLog.begin(FFat);
+ *   runLog.startRun();
+ * }
+ *
+ * void loop() {
+ *   runLog.add({ millis(), temperature, humidity, duty, mode });
+ *   runLog.update();
+ * }
+ * ```
+ */
+class RunLogger {
+private:
+  uint8_t buffers[2][_RUNLOG_BLOCK_SIZE]; /**< Block buffers, header followed by the payload. */
+  std::atomic<bool> busy[2];              /**< True while a buffer is owned by the writer task. */
+  uint8_t active;                         /**< Buffer being filled. */
+  size_t length;                          /**< Bytes used in the active buffer. */
+  uint16_t count;                         /**< Records in the active buffer. */
+  RunLogRecord last;                      /**< Previous record, base of the deltas. */
+  unsigned long blockStart;               /**< Time the active block was started (ms). */
+  uint32_t runId;                         /**< Current or last run. */
+  bool running;                           /**< True between `startRun()` and `stopRun()`. */
+  fs::FS *fs;                             /**< File system of the log. */
+  QueueHandle_t queue;                    /**< Buffers waiting for the writer task. */
+  std::atomic<uint32_t> dropped;          /**< Records dropped because both buffers were busy. */
+  std::atomic<uint32_t> writeErrors;      /**< Blocks that could not be written. */
+  std::atomic<uint32_t> written;          /**< Bytes written since boot. */
+  std::atomic<uint32_t> size;             /**< Size of all segments in bytes. */
+  std::atomic<uint32_t> evicted;          /**< Runs deleted to make room since boot. */
+  uint32_t oldestRun;                     /**< Oldest run that may have a segment. */
+  uint32_t fullRun;                       /**< Run that filled the log alone, 0 if none. */
+
+  bool submit();
+  bool makeRoom(uint32_t run, size_t need);
+  void removeRun(uint32_t run);
+  void scanSegments();
+  void writeBlock(uint8_t buffer);
+  static void writerTask(void *parameter);
+
+public:
+  /**
+   * @brief Constructor: Initializes an idle logger.
+   */
+  RunLogger();
+
+  /**
+   * @brief Prepares the log files and starts the writer task.
+   * @param fs Mounted file system, e.g. `FFat` or `SD`.
+   * @return true if the logger is ready.
+   */
+  bool begin(fs::FS &fs);
+
+  /**
+   * @brief Starts a new run with the next run ID.
+   */
+  void startRun();
+
+  /**
+   * @brief Ends the run; the last block is written by `update()`.
+   */
+  void stopRun();
+
+  /**
+   * @brief Adds a record to the current run; ignored if no run is active.
+   * @param record Sample to log.
+   */
+  void add(const RunLogRecord &record);
+
+  /**
+   * @brief Hands over due blocks to the writer task; call it regularly from the main loop.
+   */
+  void update();
+
+  /**
+   * @brief Checks if a run is being logged.
+   * @return true between `startRun()` and `stopRun()`.
+   */
+  bool isRunning() const {
+    return running;
+  }
+
+  /**
+   * @brief Gets the ID of the current or last run.
+   * @return Run ID, 0 if no run was logged yet.
+   */
+  uint32_t getRunId() const {
+    return runId;
+  }
+
+  /**
+   * @brief Gets the number of dropped records.
+   * @return Records dropped since boot.
+   */
+  uint32_t getDropped() const {
+    return dropped;
+  }
+
+  /**
+   * @brief Gets the number of failed block writes.
+   * @return Failed writes since boot.
+   */
+  uint32_t getWriteErrors() const {
+    return writeErrors;
+  }
+
+  /**
+   * @brief Gets the number of bytes written.
+   * @return Bytes written to the log since boot.
+   */
+  uint32_t getWritten() const {
+    return written;
+  }
+
+  /**
+   * @brief Gets the size of the log.
+   * @return Bytes of all segments on the file system.
+   */
+  uint32_t getSize() const {
+    return size;
+  }
+
+  /**
+   * @brief Gets the number of runs deleted to make room.
+   * @return Deleted runs since boot.
+   */
+  uint32_t getEvicted() const {
+    return evicted;
+  }
+};
+
+
+#endif  // RUNLOG_HX_H
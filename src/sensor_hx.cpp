@@ -1,10 +1,22 @@
 /**
  * @file sensor_hx.cpp
- * @brief ...
- * @details ...
+ * @brief Implementation of the BME280 sensor supervision.
+ * @details Contains the probing, validation and reconnection logic of `SensorSupervisor`
+ *          the Kalman based fusion of `SensorFusion` and the profile selection of `SensorProfileManager`.
  * 
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Added `SensorSupervisor` implementation
+ * - **2026-10-19**: Added `SensorFusion` implementation, lighter chip filter
+ * - **2026-10-19**: Added sampling profiles and `SensorProfileManager` implementation
+ * - **2026-10-19**: Fixed-point measurement path
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ * - **2026-10-19**: Measurement and read traced instead of debug pin 4
+ * - **2026-10-19**: I2C transaction times recorded in the latency monitor
+ * - **2026-10-19**: Inputs and time read through the capture port `input_hx.h`
+ * - **2026-10-19**: Reads and presence checks arbitrated by `I2cBus`
+ * - **2026-10-19**: Transaction results classified, no reads while the bus is faulted
+ * - **2026-10-19**: Fusion fed by the reference sensor only, offsets of the fallback sensors tracked
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -16,4 +28,335 @@
  */
 
 #include "sensor_hx.h"
-#include "globals_hx.h"
\ No newline at end of file
+#include "globals_hx.h"
+#include "latency_hx.h"
+#include "log_hx.h"
+#include "trace_hx.h"
+
+const SensorProfile sensorProfiles[PROFILE_COUNT] = {
+  // Light chip filtering, the noise is handled by the Kalman filter of SensorFusion
+  { "fast", Adafruit_BME280::SAMPLING_X2, Adafruit_BME280::SAMPLING_X1,
+    Adafruit_BME280::FILTER_X2, Adafruit_BME280::STANDBY_MS_62_5, 75 },
+  // Heavy oversampling and a long standby for multi-hour holds
+  { "hold", Adafruit_BME280::SAMPLING_X16, Adafruit_BME280::SAMPLING_X16,
+    Adafruit_BME280::FILTER_X4, Adafruit_BME280::STANDBY_MS_1000, 1080 }
+};
+
+bool CustomBME280::readFixed(int32_t &temperature, int32_t &humidity) {
+  if (i2c_dev == NULL) {
+    return false;
+  }
+
+  // Burst read temp_msb..hum_lsb, so both values belong to the same measurement
+  uint8_t reg = BME280_REGISTER_TEMPDATA;
+  uint8_t buffer[5];
+  bool read = false;
+  if (i2cBus.lock(i2c_dev->address())) {
+    read = i2c_dev->write_then_read(&reg, 1, buffer, sizeof(buffer));
+    i2cBus.unlock(1 + sizeof(buffer), read ? I2C_OK : I2C_ERROR_READ);
+  }
+  if (!read) {
+    captureI2cRead(i2c_dev->address(), reg, nullptr, sizeof(buffer));
+    return false;
+  }
+  captureI2cRead(i2c_dev->address(), reg, buffer, sizeof(buffer));
+
+  int32_t adcT = ((int32_t)buffer[0] << 12) | ((int32_t)buffer[1] << 4) | (buffer[2] >> 4);
+  int32_t adcH = ((int32_t)buffer[3] << 8) | buffer[4];
+  if (adcT == 0x80000 || adcH == 0x8000) {  // Value in case measurement was disabled
+    return false;
+  }
+
+  // Temperature compensation, BME280 datasheet section 4.2.3
+  const bme280_calib_data &c = _bme280_calib;
+  int32_t var1 = ((((adcT >> 3) - ((int32_t)c.dig_T1 << 1))) * ((int32_t)c.dig_T2)) >> 11;
+  int32_t var2 = (((((adcT >> 4) - ((int32_t)c.dig_T1)) * ((adcT >> 4) - ((int32_t)c.dig_T1))) >> 12) * ((int32_t)c.dig_T3)) >> 14;
+  t_fine = var1 + var2 + t_fine_adjust;
+  temperature = (t_fine * 5 + 128) >> 8;
+
+  // Humidity compensation in Q22.10 %RH
+  int32_t v = t_fine - ((int32_t)76800);
+  v = (((((adcH << 14) - (((int32_t)c.dig_H4) << 20) - (((int32_t)c.dig_H5) * v)) + ((int32_t)16384)) >> 15)
+       * (((((((v * ((int32_t)c.dig_H6)) >> 10) * (((v * ((int32_t)c.dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152))
+             * ((int32_t)c.dig_H2)
+           + 8192)
+          >> 14));
+  v = (v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)c.dig_H1)) >> 4));
+  v = (v < 0) ? 0 : v;
+  v = (v > 419430400) ? 419430400 : v;
+  humidity = (((v >> 12) * _CENTI) + 512) >> 10;
+  return true;
+}
+
+SensorSupervisor::SensorSupervisor(CustomBME280 &bme, const uint8_t *addressList, uint8_t count, TwoWire *bus)
+  : sensor(bme), wire(bus), addresses(addressList), addressCount(count), activeAddress(0),
+    data({ 0, 0, 0, 0, false }), badSamples(0), lastMeasuring(false), hasReference(false),
+    lastPollMillis(0), lastSampleMillis(0), lastValidMillis(0), reconnectMillis(0),
+    reconnectBackoff(_SENSOR_RECONNECT_MIN), profile(PROFILE_FAST), pendingProfile(PROFILE_FAST) {
+}
+
+bool SensorSupervisor::begin() {
+  reconnectMillis = loopMillis();
+  if (probe()) {
+    return true;
+  }
+  HX_LOG_WARN("Not find BMx280");
+  return false;
+}
+
+bool SensorSupervisor::update() {
+  unsigned long now = loopMillis();
+
+  // Reconnect in the background while no sensor is bound
+  if (!data.isActive) {
+    if (now - reconnectMillis >= reconnectBackoff) {
+      reconnectMillis = now;
+      if (!probe()) {
+        reconnectBackoff *= 2;
+        if (reconnectBackoff > _SENSOR_RECONNECT_MAX) reconnectBackoff = _SENSOR_RECONNECT_MAX;
+      }
+    }
+    return false;
+  }
+
+  if (now - lastPollMillis < _SENSOR_POLL_INTERVAL) {
+    return false;
+  }
+  lastPollMillis = now;
+
+  // No completed measurement within the timeout counts as a missed sample
+  if (now - lastSampleMillis >= sensorProfiles[profile].samplePeriod + _SENSOR_SAMPLE_TIMEOUT) {
+    registerBadSample(now, "timeout");
+    if (!data.isActive) {
+      return false;
+    }
+  }
+
+  uint32_t start = micros();
+  bool measuring = sensor.readRegister(BME280_REGISTER_STATUS) & 0x08;  // Bit 3: Measuring
+  latency.record(LATENCY_I2C, micros() - start);
+  bool completed = lastMeasuring && !measuring;
+  if (measuring && !lastMeasuring) {
+    HX_TRACE_BEGIN(TRACE_BME_MEASURE);
+  }
+  lastMeasuring = measuring;
+  if (!completed) {
+    return false;
+  }
+  HX_TRACE_END(TRACE_BME_MEASURE);
+
+  int32_t temperature;
+  int32_t humidity;
+  bool read;
+  {
+    HX_TRACE_SCOPE(TRACE_BME_READ);
+    start = micros();
+    read = sensor.readFixed(temperature, humidity);
+    latency.record(LATENCY_I2C, micros() - start);
+  }
+
+  // The sensor is in standby now, so a new profile takes effect without losing a sample
+  if (pendingProfile != profile) {
+    profile = pendingProfile;
+    configure();
+  }
+
+  if (!read || !validate(temperature, humidity, now)) {
+    registerBadSample(now, "implausible");
+    return false;
+  }
+
+  data.temperature = temperature;
+  data.humidity = humidity;
+  hasReference = true;
+  badSamples = 0;
+  lastSampleMillis = now;
+  lastValidMillis = now;
+  return true;
+}
+
+bool SensorSupervisor::probe() {
+  for (uint8_t i = 0; i < addressCount; i++) {
+    // Cheap presence check, so an absent device never pays the init delay of begin()
+    bool present = false;
+    if (i2cBus.lock(addresses[i])) {
+      wire->beginTransmission(addresses[i]);
+      enumI2cError error = I2cBus::classify(wire->endTransmission());
+      i2cBus.unlock(0, error);
+      present = error == I2C_OK;
+    }
+    // The library calls run outside the manager, TwoWire locks each of their transactions
+    present = present && sensor.begin(addresses[i], wire);
+    captureI2cPresence(addresses[i], present);
+    if (!present) {
+      continue;
+    }
+    captureCalibration(addresses[i], &sensor.getCalibration(), sizeof(bme280_calib_data));
+
+    profile = pendingProfile;
+    configure();
+    unsigned long now = loopMillis();
+    activeAddress = addresses[i];
+    data.isActive = true;
+    badSamples = 0;
+    lastMeasuring = false;
+    hasReference = false;
+    lastPollMillis = now;
+    lastSampleMillis = now;
+    reconnectBackoff = _SENSOR_RECONNECT_MIN;
+    HX_LOG_INFO("BMx280 found at 0x%02X", activeAddress);
+    return true;
+  }
+  return false;
+}
+
+void SensorSupervisor::configure() {
+  const SensorProfile &config = sensorProfiles[profile];
+  sensor.setSampling(Adafruit_BME280::MODE_NORMAL,
+                     config.tempSampling,             // temperature
+                     Adafruit_BME280::SAMPLING_NONE,  // pressure
+                     config.humSampling,              // humidity
+                     config.filter,
+                     config.standby);
+}
+
+bool SensorSupervisor::validate(int32_t temperature, int32_t humidity, unsigned long now) const {
+  if (temperature < _SENSOR_TEMP_VALID_MIN || temperature > _SENSOR_TEMP_VALID_MAX) {
+    return false;
+  }
+  if (humidity < _SENSOR_HUM_VALID_MIN || humidity > _SENSOR_HUM_VALID_MAX) {
+    return false;
+  }
+  if (hasReference) {
+    int64_t maxStep = (int64_t)_SENSOR_TEMP_MAX_RATE * (int64_t)(now - lastValidMillis) / 1000;
+    if (abs(temperature - data.temperature) > maxStep) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SensorSupervisor::registerBadSample(unsigned long now, const char *reason) {
+  badSamples++;
+  lastSampleMillis = now;
+  HX_LOG_WARN("BMx280 0x%02X bad sample (%s) %d/%d", activeAddress, reason, badSamples, _SENSOR_MAX_BAD_SAMPLES);
+  if (badSamples >= _SENSOR_MAX_BAD_SAMPLES) {
+    disconnect(now, reason);
+  }
+}
+
+void SensorSupervisor::disconnect(unsigned long now, const char *reason) {
+  HX_LOG_ERROR("BMx280 0x%02X lost (%s)", activeAddress, reason);
+  data.isActive = false;
+  activeAddress = 0;
+  hasReference = false;
+  reconnectMillis = now;
+  reconnectBackoff = _SENSOR_RECONNECT_MIN;
+}
+
+
+SensorFusion::SensorFusion(SensorSupervisor *const *supervisorList, const float *varianceList, uint8_t sensorCount, float processNoise)
+  : supervisors(supervisorList), variances(varianceList),
+    count(sensorCount < _SENSOR_FUSION_MAX ? sensorCount : _SENSOR_FUSION_MAX), filter(processNoise),
+    data({ 0, 0, 0, 0, false }), rate(0), lastFilterMillis(0), reference(-1) {
+  for (uint8_t i = 0; i < _SENSOR_FUSION_MAX; i++) {
+    offsets[i] = 0;
+    hasOffset[i] = false;
+  }
+}
+
+bool SensorFusion::begin() {
+  bool found = false;
+  for (uint8_t i = 0; i < count; i++) {
+    found |= supervisors[i]->begin();
+  }
+  return found;
+}
+
+bool SensorFusion::update() {
+  bool updated = false;
+  bool newSamples[_SENSOR_FUSION_MAX];
+  int8_t newReference = -1;
+
+  for (uint8_t i = 0; i < count; i++) {
+    newSamples[i] = supervisors[i]->update();
+    if (newReference < 0 && supervisors[i]->isActive()) {
+      newReference = i;
+    }
+  }
+  data.isActive = newReference >= 0;
+  if (newReference != reference) {
+    reference = newReference;
+    if (reference >= 0) {
+      HX_LOG_INFO("Sensor fusion: reference sensor %d, offset %ld (0.01 °C)", reference, (long)getOffset(reference));
+    }
+  }
+  if (!data.isActive) {
+    filter.Invalidate();
+    return false;
+  }
+  // Humidity is not comparable between places, it comes from the reference only
+  data.humidity = supervisors[reference]->getData().humidity;
+
+  unsigned long now = loopMillis();
+  for (uint8_t i = reference; i < count; i++) {
+    if (!newSamples[i] || !supervisors[i]->isActive()) {
+      continue;
+    }
+    float measurement = (float)supervisors[i]->getData().temperature / _CENTI;
+
+    if (i != reference) {
+      // A fallback only tracks its offset to the estimate
+      if (!filter.IsInitialized()) {
+        continue;
+      }
+      float deviation = measurement - filter.GetTemperature();
+      offsets[i] += hasOffset[i] ? _SENSOR_OFFSET_GAIN * (deviation - offsets[i]) : deviation - offsets[i];
+      hasOffset[i] = true;
+      continue;
+    }
+
+    measurement -= offsets[i];
+    if (!filter.IsInitialized()) {
+      filter.Reset(measurement);
+    } else {
+      filter.Predict((float)(now - lastFilterMillis) / 1000.0f);
+      filter.Update(measurement, variances[i]);
+    }
+    lastFilterMillis = now;
+    updated = true;
+  }
+
+  if (updated) {
+    data.temperature = lroundf(filter.GetTemperature() * _CENTI);
+    rate = lroundf(filter.GetRate() * _CENTI);
+  }
+  return updated;
+}
+
+
+SensorProfileManager::SensorProfileManager(SensorFusion &sensorFusion)
+  : fusion(sensorFusion), profile(PROFILE_FAST), lastSetpoint(0), bandMillis(0), inBand(false) {
+}
+
+void SensorProfileManager::update(int32_t setpoint, int32_t input) {
+  unsigned long now = loopMillis();
+  enumSensorProfile newProfile = PROFILE_FAST;
+
+  // A setpoint change or a large control error means ramp phase
+  if (setpoint != lastSetpoint || abs(setpoint - input) > _PROFILE_HOLD_BAND) {
+    inBand = false;
+  } else if (!inBand) {
+    inBand = true;
+    bandMillis = now;
+  } else if (now - bandMillis >= _PROFILE_HOLD_DELAY) {
+    newProfile = PROFILE_HOLD;
+  }
+  lastSetpoint = setpoint;
+
+  if (newProfile != profile) {
+    profile = newProfile;
+    fusion.setProfile(profile);
+    HX_LOG_INFO("Sensor profile: %s", getProfileName());
+  }
+}
@@ -6,6 +6,15 @@
  *          high-frequency polling of the `BME280_REGISTER_STATUS` register.
  * ### Changelog
  * - **2024-11-08**: Initial version created by Kevin Hinrichs
+ * - **2026-10-19**: Added `SensorSupervisor` with address failover and reconnection
+ * - **2026-10-19**: Added `SensorFusion` for two sensors with a Kalman filter
+ * - **2026-10-19**: Added sampling profiles and `SensorProfileManager`
+ * - **2026-10-19**: Fixed-point burst read with integer compensation
+ * - **2026-10-19**: Register reads recorded by the input capture, `getCalibration()`
+ * - **2026-10-19**: Register reads take the bus from `I2cBus` with sensor priority
+ * - **2026-10-19**: Failed and skipped register reads reported to `I2cBus` and the capture
+ * - **2026-10-19**: Fusion fed by one reference sensor, the others are offset-corrected fallbacks
+ * - **2026-10-19**: Filter state in °C for the PID
  *
  * @version 0.0.1
  * @date 2024-11-08
@@ -20,6 +29,10 @@
 #define SENSOR_HX_H
 
 #include <Adafruit_BME280.h>
+#include "globals_hx.h"
+#include "filter_hx.h"
+#include "i2c_bus_hx.h"
+#include "input_hx.h"
 
 /**
  * @brief Custom BME280 sensor class for efficient status polling.
@@ -40,7 +53,7 @@ public:
    * @details This function is intended for high-frequency polling of registers, 
    *          such as `BME280_REGISTER_STATUS` to monitor the sensor's state.
    * @param reg The register address to read.
-   * @return The value read from the specified register.
+   * @return The value read from the specified register, 0 if the read failed or was skipped.
    *
    * ### Example Usage
    * ```cpp
@@ -75,7 +88,399 @@ public:
    * ```
    */
   uint8_t readRegister(uint8_t reg) {
-    return read8(reg);
+    uint8_t value = 0;
+    bool read = false;
+    if (i2cBus.lock(i2c_dev->address())) {
+      read = i2c_dev->write_then_read(&reg, 1, &value, 1);
+      i2cBus.unlock(2, read ? I2C_OK : I2C_ERROR_READ);
+    }
+    captureI2cRead(i2c_dev->address(), reg, read ? &value : nullptr, 1);
+    return read ? value : 0;
+  }
+
+  /**
+   * @brief Reads temperature and humidity as fixed-point values.
+   * @details Reads both raw values with a single burst transaction and compensates them with
+   *          the integer formulas of the BME280 datasheet. Unlike `readTemperature()` and
+   *          `readHumidity()` this needs one I2C transaction instead of three, keeps both values
+   *          from the same measurement and uses no floating point.
+   * @param temperature Receives the temperature in 0.01 °C.
+   * @param humidity Receives the relative humidity in 0.01 %.
+   * @return true on success, false if the bus transaction failed or a value was skipped.
+   */
+  bool readFixed(int32_t &temperature, int32_t &humidity);
+
+  /**
+   * @brief Gets the calibration data read by `begin()`.
+   * @return Calibration coefficients of the sensor.
+   */
+  const bme280_calib_data &getCalibration() const {
+    return _bme280_calib;
+  }
+};
+
+/** Sensor sampling profiles. */
+enum enumSensorProfile {
+  PROFILE_FAST,  ///< Low latency sampling for ramps and setpoint changes.
+  PROFILE_HOLD,  ///< Heavy oversampling with long standby for long holds.
+  PROFILE_COUNT  ///< Number of profiles.
+};
+
+/**
+ * @brief Describes one sampling configuration of the BME280.
+ */
+typedef struct {
+  const char *name;                               ///< Profile name for reporting.
+  Adafruit_BME280::sensor_sampling tempSampling;  ///< Temperature oversampling.
+  Adafruit_BME280::sensor_sampling humSampling;   ///< Humidity oversampling.
+  Adafruit_BME280::sensor_filter filter;          ///< IIR filter coefficient.
+  Adafruit_BME280::standby_duration standby;      ///< Standby time between measurements.
+  unsigned long samplePeriod;                     ///< Expected sample period in milliseconds.
+} SensorProfile;
+
+/**
+ * @brief Table of all sampling profiles, indexed by `enumSensorProfile`.
+ */
+extern const SensorProfile sensorProfiles[PROFILE_COUNT];
+
+/**
+ * @brief Supervises a BME280 sensor and keeps its data trustworthy.
+ * @details The supervisor owns the complete life cycle of one sensor slot:
+ *          - Probes a list of I2C addresses (e.g. 0x76 and 0x77) and binds to the first one that answers.
+ *          - Polls the status register and reads a new sample when a measurement completes.
+ *          - Validates each sample against the plausible range and a maximum rate of change.
+ *          - Counts bad or missed samples and drops the sensor after `_SENSOR_MAX_BAD_SAMPLES`.
+ *          - Reconnects in the background with exponential backoff while the sensor is inactive.
+ *
+ *          All work is done in `update()`, which never waits for the sensor. An absent device is
+ *          detected with a single address-only I2C transaction before `begin()` is called, so only a
+ *          device that actually answers pays the library's initialisation delay.
+ *
+ *          While `isActive()` returns false the data must not be used for control. Since missed samples
+ *          are counted every sample period of the active profile plus `_SENSOR_SAMPLE_TIMEOUT`, a stale
+ *          sensor is dropped after at most `_SENSOR_MAX_BAD_SAMPLES` of these intervals.
+ *
+ *          A new sampling profile requested with `setProfile()` is applied right after the next
+ *          completed measurement. The sensor is in standby then, so no sample gets lost.
+ *
+ * ### Example Usage
+ * ```cpp
+ * CustomBME280 bme;
+ * const uint8_t addresses[] = { 0x76, 0x77 };
+ * SensorSupervisor supervisor(bme, addresses, 2);
+ *
+ * void setup() {
+ *   supervisor.begin();
+ * }
+ *
+ * void loop() {
+ *   if (supervisor.update()) {
+ *     ApplyTemperature(supervisor.getData().temperature);  // New, validated sample in 0.01 °C
+ *   } else if (!supervisor.isActive()) {
+ *     SwitchHeaterOff();  // No trustworthy data
+ *   }
+ * }
+ * ```
+ */
+class SensorSupervisor {
+private:
+  CustomBME280 &sensor;             /**< Supervised sensor instance. */
+  TwoWire *wire;                    /**< I2C bus the sensor is connected to. */
+  const uint8_t *addresses;         /**< Candidate I2C addresses in order of preference. */
+  uint8_t addressCount;             /**< Number of candidate addresses. */
+  uint8_t activeAddress;            /**< Address of the bound sensor, 0 if none. */
+  SensorData data;                  /**< Last validated sample and activity flag. */
+  uint8_t badSamples;               /**< Consecutive bad or missed samples. */
+  bool lastMeasuring;               /**< Measuring bit of the previous status poll. */
+  bool hasReference;                /**< True if `data` holds a sample for the rate check. */
+  unsigned long lastPollMillis;     /**< Time of the last status poll. */
+  unsigned long lastSampleMillis;   /**< Time of the last sample or missed-sample count. */
+  unsigned long lastValidMillis;    /**< Time of the last validated sample. */
+  unsigned long reconnectMillis;    /**< Time of the last reconnect attempt. */
+  unsigned long reconnectBackoff;   /**< Current reconnect backoff in milliseconds. */
+  enumSensorProfile profile;        /**< Applied sampling profile. */
+  enumSensorProfile pendingProfile; /**< Requested sampling profile. */
+
+  bool probe();
+  void configure();
+  bool validate(int32_t temperature, int32_t humidity, unsigned long now) const;
+  void registerBadSample(unsigned long now, const char *reason);
+  void disconnect(unsigned long now, const char *reason);
+
+public:
+  /**
+   * @brief Constructor to initialize the supervisor.
+   * @param bme The sensor instance to supervise.
+   * @param addressList Candidate I2C addresses in order of preference.
+   * @param count Number of entries in `addressList`.
+   * @param bus The I2C bus the sensor is connected to.
+   */
+  SensorSupervisor(CustomBME280 &bme, const uint8_t *addressList, uint8_t count, TwoWire *bus = &Wire);
+
+  /**
+   * @brief Probes all candidate addresses once.
+   * @return true if a sensor was found and configured, false otherwise.
+   */
+  bool begin();
+
+  /**
+   * @brief Runs the supervisor. Call cyclically from the loop.
+   * @details Polls the sensor, validates new samples, tracks stale data and performs
+   *          reconnect attempts when their backoff has elapsed.
+   * @return true if a new validated sample is available in `getData()`, false otherwise.
+   */
+  bool update();
+
+  /**
+   * @brief Gets the last validated sample.
+   * @return Sensor data; `isActive` tells if it may be used for control.
+   */
+  const SensorData &getData() const {
+    return data;
+  }
+
+  /**
+   * @brief Checks if the sensor delivers trustworthy data.
+   * @return true if the sensor is connected and its data is valid and fresh.
+   */
+  bool isActive() const {
+    return data.isActive;
+  }
+
+  /**
+   * @brief Gets the I2C address of the bound sensor.
+   * @return The active address, or 0 if no sensor is bound.
+   */
+  uint8_t getAddress() const {
+    return activeAddress;
+  }
+
+  /**
+   * @brief Requests a sampling profile.
+   * @details The profile is applied after the next completed measurement, or on connect.
+   * @param newProfile The requested profile.
+   */
+  void setProfile(enumSensorProfile newProfile) {
+    pendingProfile = newProfile;
+  }
+
+  /**
+   * @brief Gets the applied sampling profile.
+   * @return The profile the sensor is currently configured with.
+   */
+  enumSensorProfile getProfile() const {
+    return profile;
+  }
+
+  /**
+   * @brief Gets the number of consecutive bad or missed samples.
+   * @return Bad sample counter, reset by every valid sample.
+   */
+  uint8_t getBadSamples() const {
+    return badSamples;
+  }
+};
+
+/**
+ * @brief Fuses the temperature of several supervised sensors with a Kalman filter.
+ * @details Each sensor is handled by its own `SensorSupervisor`. The sensors measure at
+ *          different places, e.g. at the spool and at the heater outlet, so their readings
+ *          differ by more than their noise. Only the reference sensor, the first active one in
+ *          the list, feeds the `Kalman_heatX` filter with its variance. The filter provides the
+ *          temperature and its rate of change; both are meant as controller input instead of
+ *          the raw readings.
+ *
+ *          The other sensors are fallbacks. Each sample of an active fallback moves its offset
+ *          to the estimate by `_SENSOR_OFFSET_GAIN`. When the reference is lost, the next
+ *          sensor continues the filter with its offset subtracted, so the estimate neither
+ *          jumps nor takes the bias of the other place. A fallback that has not been compared
+ *          with the estimate yet takes its offset from its first sample. The first sensor has
+ *          no offset, its place defines the temperature.
+ *
+ *          Inputs and outputs are fixed-point in 0.01 units like `SensorData`, only the filter
+ *          itself runs in single precision on the FPU. The controller takes the filter state
+ *          in °C from `getTemperature()` and `getTemperatureRate()`, so the estimate is not
+ *          rounded to 0.01 °C on its way from the filter to the PID.
+ *
+ *          Humidity is taken from the first active sensor in the list (the spool sensor), because
+ *          relative humidity is not comparable between places of different temperature.
+ *
+ *          The fusion stays active as long as at least one sensor is active. If all sensors are
+ *          lost the filter is invalidated and restarts with the next valid sample.
+ *
+ * ### Example Usage
+ * ```cpp
+ * SensorSupervisor *supervisors[] = { &spoolSupervisor, &outletSupervisor };
+ * const float variances[] = { 0.01, 0.04 };
+ * SensorFusion fusion(supervisors, variances, 2, 0.01);
+ *
+ * void loop() {
+ *   if (fusion.update()) {
+ *     pid.SetInput(fusion.getTemperature(), fusion.getTemperatureRate());
+ *   }
+ * }
+ * ```
+ */
+class SensorFusion {
+private:
+  SensorSupervisor *const *supervisors; /**< Supervised sensors in order of preference. */
+  const float *variances;               /**< Measurement variance per sensor in °C². */
+  uint8_t count;                        /**< Number of sensors. */
+  Kalman_heatX filter;                  /**< Temperature and rate estimator. */
+  SensorData data;                      /**< Fused sample and activity flag. */
+  int32_t rate;                         /**< Fused temperature rate in 0.01 °C per second. */
+  unsigned long lastFilterMillis;       /**< Time of the last filter step. */
+  float offsets[_SENSOR_FUSION_MAX];    /**< Reading minus estimate per sensor in °C. */
+  bool hasOffset[_SENSOR_FUSION_MAX];   /**< True once the offset of a sensor was taken from a sample. */
+  int8_t reference;                     /**< Sensor feeding the filter, -1 if none is active. */
+
+public:
+  /**
+   * @brief Constructor to initialize the fusion.
+   * @param supervisorList Supervised sensors in order of preference.
+   * @param varianceList Measurement variance per sensor in °C².
+   * @param sensorCount Number of entries in both lists, at most `_SENSOR_FUSION_MAX`.
+   * @param processNoise Spectral density of the temperature rate noise in °C²/s³.
+   */
+  SensorFusion(SensorSupervisor *const *supervisorList, const float *varianceList, uint8_t sensorCount, float processNoise);
+
+  /**
+   * @brief Probes all sensors once.
+   * @return true if at least one sensor was found, false otherwise.
+   */
+  bool begin();
+
+  /**
+   * @brief Runs all supervisors and fuses their new samples. Call cyclically from the loop.
+   * @return true if the fused state was updated, false otherwise.
+   */
+  bool update();
+
+  /**
+   * @brief Gets the fused sample.
+   * @return Sensor data with the filtered temperature; `isActive` tells if it may be used for control.
+   */
+  const SensorData &getData() const {
+    return data;
+  }
+
+  /**
+   * @brief Gets the estimated rate of change of the temperature.
+   * @return Temperature rate in 0.01 °C per second.
+   */
+  int32_t getRate() const {
+    return rate;
+  }
+
+  /**
+   * @brief Gets the temperature estimate of the filter.
+   * @return Temperature in °C, valid after `update()` returned true.
+   */
+  float getTemperature() const {
+    return filter.GetTemperature();
+  }
+
+  /**
+   * @brief Gets the rate estimate of the filter.
+   * @return Temperature rate in °C per second, valid after `update()` returned true.
+   */
+  float getTemperatureRate() const {
+    return filter.GetRate();
+  }
+
+  /**
+   * @brief Checks if at least one sensor delivers trustworthy data.
+   * @return true if the fused data may be used for control.
+   */
+  bool isActive() const {
+    return data.isActive;
+  }
+
+  /**
+   * @brief Gets the sensor feeding the filter.
+   * @return Index in the sensor list, -1 if no sensor is active.
+   */
+  int8_t getReference() const {
+    return reference;
+  }
+
+  /**
+   * @brief Gets the offset of a sensor to the estimate.
+   * @param sensor Index in the sensor list.
+   * @return Offset in 0.01 °C, 0 for the first sensor.
+   */
+  int32_t getOffset(uint8_t sensor) const {
+    return sensor < count ? lroundf(offsets[sensor] * _CENTI) : 0;
+  }
+
+  /**
+   * @brief Requests a sampling profile for all sensors.
+   * @param profile The requested profile.
+   */
+  void setProfile(enumSensorProfile profile) {
+    for (uint8_t i = 0; i < count; i++) {
+      supervisors[i]->setProfile(profile);
+    }
+  }
+};
+
+/**
+ * @brief Selects the sensor sampling profile by control phase.
+ * @details During ramps and after setpoint changes the sensors run the low latency
+ *          `PROFILE_FAST`. Once the temperature stayed within `_PROFILE_HOLD_BAND` of the
+ *          setpoint for `_PROFILE_HOLD_DELAY`, the manager switches to `PROFILE_HOLD`, which
+ *          samples less often with heavy oversampling. This saves I2C bandwidth and reduces
+ *          self-heating of the sensors during multi-hour holds.
+ *
+ *          Every profile change is reported on the serial interface.
+ *
+ * ### Example Usage
+ * ```cpp
+ * SensorProfileManager profileManager(fusion);
+ *
+ * void loop() {
+ *   if (fusion.update()) {
+ *     profileManager.update(targetTemperature, fusion.getData().temperature);
+ *   }
+ * }
+ * ```
+ */
+class SensorProfileManager {
+private:
+  SensorFusion &fusion;      /**< Sensors to configure. */
+  enumSensorProfile profile; /**< Selected profile. */
+  int32_t lastSetpoint;      /**< Setpoint of the previous update. */
+  unsigned long bandMillis;  /**< Time the temperature entered the hold band. */
+  bool inBand;               /**< True while the temperature is inside the hold band. */
+
+public:
+  /**
+   * @brief Constructor to initialize the manager with the fast profile.
+   * @param sensorFusion The sensors to configure.
+   */
+  SensorProfileManager(SensorFusion &sensorFusion);
+
+  /**
+   * @brief Evaluates the control phase and switches the profile if needed.
+   * @param setpoint Current temperature setpoint in 0.01 °C.
+   * @param input Current temperature in 0.01 °C.
+   */
+  void update(int32_t setpoint, int32_t input);
+
+  /**
+   * @brief Gets the selected profile.
+   * @return The profile requested from the sensors.
+   */
+  enumSensorProfile getProfile() const {
+    return profile;
+  }
+
+  /**
+   * @brief Gets the name of the selected profile.
+   * @return Profile name, e.g. "fast" or "hold".
+   */
+  const char *getProfileName() const {
+    return sensorProfiles[profile].name;
   }
 };
 
@@ -0,0 +1,200 @@
+/**
+ * @file settings_hx.cpp
+ * @brief Implementation of the persistent settings store.
+ * @details Contains the slot handling, the rate limiting and the JSON import and export of
+ *          `SettingsStore`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "settings_hx.h"
+#include "log_hx.h"
+
+#include <ArduinoJson.h>
+#include <esp_rom_crc.h>
+
+#define _SETTINGS_MAGIC 0x53505848  ///< "HXPS" in little endian
+#define _SETTINGS_VERSION 1         ///< Layout version of `Settings`
+
+static void slotKey(char *key, size_t length, uint32_t sequence) {
+  snprintf(key, length, "slot%u", (unsigned)(sequence % _SETTINGS_SLOTS));
+}
+
+SettingsStore::SettingsStore()
+  : current(defaults()), sequence(0), opened(false), configDirty(false), runDirty(false),
+    lastChange(0), lastSave(0) {}
+
+bool SettingsStore::begin() {
+  opened = prefs.begin(_SETTINGS_NAMESPACE, false);
+  if (!opened) {
+    HX_LOG_WARN("Settings: NVS not available, using defaults");
+    return false;
+  }
+
+  bool found = false;
+  for (uint32_t slot = 0; slot < _SETTINGS_SLOTS; slot++) {
+    char key[8];
+    slotKey(key, sizeof(key), slot);
+    SettingsRecord record;
+    if (prefs.getBytes(key, &record, sizeof(record)) != sizeof(record)
+        || record.magic != _SETTINGS_MAGIC
+        || record.version != _SETTINGS_VERSION
+        || record.crc != checksum(record)) {
+      continue;
+    }
+    // Sequence numbers wrap, compare the distance instead of the value
+    if (!found || (int32_t)(record.sequence - sequence) > 0) {
+      current = record.settings;
+      sequence = record.sequence;
+      found = true;
+    }
+  }
+
+  if (found) {
+    HX_LOG_INFO("Settings: record %u loaded", (unsigned)sequence);
+  } else {
+    HX_LOG_INFO("Settings: no valid record, using defaults");
+  }
+  return found;
+}
+
+bool SettingsStore::update(const Settings &settings) {
+  unsigned long now = millis();
+
+  // Start and stop are saved at once, the resume decision depends on them
+  bool runEdge = settings.run.running != current.run.running;
+  if (!sameConfig(settings, current)) {
+    configDirty = true;
+    lastChange = now;
+  }
+  if (settings.run.elapsedSeconds != current.run.elapsedSeconds) {
+    runDirty = true;
+  }
+  current = settings;
+
+  if (runEdge
+      || (configDirty && now - lastChange >= _SETTINGS_SAVE_DELAY)
+      || (runDirty && now - lastSave >= _SETTINGS_RUN_SAVE_INTERVAL)) {
+    return save(now);
+  }
+  return false;
+}
+
+bool SettingsStore::flush() {
+  if (!configDirty && !runDirty) {
+    return true;
+  }
+  return save(millis());
+}
+
+bool SettingsStore::save(unsigned long now) {
+  lastSave = now;
+  if (!opened) {
+    return false;
+  }
+
+  SettingsRecord record;
+  memset(&record, 0, sizeof(record));
+  record.magic = _SETTINGS_MAGIC;
+  record.version = _SETTINGS_VERSION;
+  record.sequence = sequence + 1;
+  record.settings = current;
+  record.crc = checksum(record);
+
+  // The next slot holds the oldest record, the current one stays intact if this write is torn
+  char key[8];
+  slotKey(key, sizeof(key), record.sequence);
+  if (prefs.putBytes(key, &record, sizeof(record)) != sizeof(record)) {
+    HX_LOG_ERROR("Settings: write failed");
+    return false;
+  }
+  sequence = record.sequence;
+  configDirty = false;
+  runDirty = false;
+  return true;
+}
+
+uint32_t SettingsStore::checksum(const SettingsRecord &record) {
+  return esp_rom_crc32_le(0, (const uint8_t *)&record, offsetof(SettingsRecord, crc));
+}
+
+bool SettingsStore::sameConfig(const Settings &a, const Settings &b) {
+  return a.target.temperature == b.target.temperature
+         && a.target.humidity == b.target.humidity
+         && a.countdown.hours == b.countdown.hours
+         && a.countdown.minutes == b.countdown.minutes
+         && a.kp == b.kp && a.ki == b.ki && a.kd == b.kd;
+}
+
+void SettingsStore::exportJson(Print &out) const {
+  JsonDocument doc;
+  doc["temperature"] = (float)current.target.temperature / _CENTI;
+  doc["humidity"] = (float)current.target.humidity / _CENTI;
+  doc["hours"] = current.countdown.hours;
+  doc["minutes"] = current.countdown.minutes;
+  doc["kp"] = current.kp;
+  doc["ki"] = current.ki;
+  doc["kd"] = current.kd;
+  doc["running"] = current.run.running;
+  doc["elapsed"] = current.run.elapsedSeconds;
+  serializeJson(doc, out);
+  out.println();
+}
+
+bool SettingsStore::importJson(const char *json, Settings &settings) {
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, json);
+  if (error) {
+    HX_LOG_WARN("Settings: JSON error %s", error.c_str());
+    return false;
+  }
+
+  float temperature = doc["temperature"] | (float)settings.target.temperature / _CENTI;
+  float humidity = doc["humidity"] | (float)settings.target.humidity / _CENTI;
+  int hours = doc["hours"] | settings.countdown.hours;
+  int minutes = doc["minutes"] | settings.countdown.minutes;
+  float kp = doc["kp"] | settings.kp;
+  float ki = doc["ki"] | settings.ki;
+  float kd = doc["kd"] | settings.kd;
+
+  if (temperature < _TEMP_MIN || temperature > _TEMP_MAX
+      || humidity < _HUM_MIN || humidity > _HUM_MAX
+      || hours < _TIME_MIN || hours > _TIME_MAX
+      || minutes < 0 || minutes > 59
+      || kp < 0 || ki < 0 || kd < 0) {
+    HX_LOG_WARN("Settings: value out of range");
+    return false;
+  }
+
+  // The run state is owned by the device and not imported
+  settings.target.temperature = lroundf(temperature * _CENTI);
+  settings.target.humidity = lroundf(humidity * _CENTI);
+  settings.countdown.hours = hours;
+  settings.countdown.minutes = minutes;
+  settings.kp = kp;
+  settings.ki = ki;
+  settings.kd = kd;
+  return true;
+}
+
+Settings SettingsStore::defaults() {
+  return {
+    { _TEMP_PRESET * _CENTI, _HUM_PRESET * _CENTI },
+    { _TIME_PRESET, 0 },
+    _PID_TEMP_KP_PRESET,
+    _PID_TEMP_KI_PRESET,
+    _PID_TEMP_KD_PRESET,
+    { false, 0 }
+  };
+}
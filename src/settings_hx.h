@@ -0,0 +1,157 @@
+/**
+ * @file settings_hx.h
+ * @brief Persistent settings and run state.
+ * @details This file contains the `SettingsStore` class, which keeps the user settings and the
+ *          progress of a drying run in NVS so both survive a reset or power loss.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef SETTINGS_HX_H
+#define SETTINGS_HX_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "globals_hx.h"
+
+/**
+ * @brief Settings and run state that are kept across resets.
+ */
+typedef struct {
+  HeatingValues target;  ///< Target temperature and humidity (0.01 units).
+  Countdown countdown;   ///< Target drying time.
+  float kp;              ///< Proportional gain of the heating PID.
+  float ki;              ///< Integral gain of the heating PID.
+  float kd;              ///< Derivative gain of the heating PID.
+  RunState run;          ///< State of the drying run.
+} Settings;
+
+/**
+ * @brief One settings record as stored in an NVS slot.
+ */
+typedef struct {
+  uint32_t magic;     ///< Record identifier `_SETTINGS_MAGIC`.
+  uint16_t version;   ///< Layout version `_SETTINGS_VERSION`.
+  uint16_t reserved;  ///< Padding, always zero.
+  uint32_t sequence;  ///< Write counter, the highest valid sequence is the current record.
+  Settings settings;  ///< Payload.
+  uint32_t crc;       ///< CRC32 of all preceding bytes.
+} SettingsRecord;
+
+/**
+ * @brief Settings store with wear-aware, power-fail safe writes to NVS.
+ * @details The store writes complete records round-robin into `_SETTINGS_SLOTS` NVS slots.
+ *          Each record carries a sequence number and a CRC, so a record torn by a power loss
+ *          is simply ignored on boot and the previous one is used. The current record is never
+ *          overwritten.
+ *
+ *          Writes are rate limited: changed settings are saved once they have been stable for
+ *          `_SETTINGS_SAVE_DELAY`, so turning the encoder does not cause a write per step.
+ *          The progress of a running run is saved every `_SETTINGS_RUN_SAVE_INTERVAL`, starting
+ *          or stopping a run is saved at once.
+ *
+ *          The settings can be exported and imported as JSON, e.g. through the serial console.
+ *
+ * ### JSON Format
+ * ```json
+ * { "temperature": 50.0, "humidity": 20.0, "hours": 4, "minutes": 0,
+ *   "kp": 2.0, "ki": 5.0, "kd": 1.0, "running": false, "elapsed": 0 }
+ * ```
+ *
+ * ### Example Usage
+ * ```cpp
+ * SettingsStore settings;
+ *
+ * void setup() {
+ *   if (settings.begin()) {
+ *     ApplySettings(settings.get());
+ *   }
+ * }
+ *
+ * void loop() {
+ *   settings.update(CollectSettings());
+ * }
+ * ```
+ */
+class SettingsStore {
+private:
+  Preferences prefs;        /**< NVS handle. */
+  Settings current;         /**< Settings as last passed to `update()`. */
+  uint32_t sequence;        /**< Sequence number of the last stored record. */
+  bool opened;              /**< True if the NVS namespace is open. */
+  bool configDirty;         /**< True if settings changed since the last save. */
+  bool runDirty;            /**< True if the run progress changed since the last save. */
+  unsigned long lastChange; /**< Time of the last settings change (ms). */
+  unsigned long lastSave;   /**< Time of the last save (ms). */
+
+  bool save(unsigned long now);
+  static uint32_t checksum(const SettingsRecord &record);
+  static bool sameConfig(const Settings &a, const Settings &b);
+
+public:
+  /**
+   * @brief Constructor: Initializes the store with the default settings.
+   */
+  SettingsStore();
+
+  /**
+   * @brief Opens the NVS namespace and loads the newest valid record.
+   * @return true if stored settings were found, false if the defaults are used.
+   */
+  bool begin();
+
+  /**
+   * @brief Gets the current settings.
+   * @return The loaded settings, or the settings last passed to `update()`.
+   */
+  const Settings &get() const {
+    return current;
+  }
+
+  /**
+   * @brief Passes the current settings to the store; call it regularly from the main loop.
+   * @param settings Current settings and run state.
+   * @return true if a record has been written.
+   */
+  bool update(const Settings &settings);
+
+  /**
+   * @brief Writes pending changes at once, e.g. before a planned restart.
+   * @return true if nothing was pending or the record has been written.
+   */
+  bool flush();
+
+  /**
+   * @brief Writes the current settings as JSON.
+   * @param out Destination, e.g. `Serial`.
+   */
+  void exportJson(Print &out) const;
+
+  /**
+   * @brief Parses and validates settings from JSON.
+   * @details Missing keys keep the value of `settings`, out-of-range values reject the import.
+   * @param json JSON text.
+   * @param settings Settings to modify; unchanged if the import fails.
+   * @return true if the JSON is valid.
+   */
+  static bool importJson(const char *json, Settings &settings);
+
+  /**
+   * @brief Gets the default settings.
+   * @return Settings built from the preset macros.
+   */
+  static Settings defaults();
+};
+
+
+#endif  // SETTINGS_HX_H
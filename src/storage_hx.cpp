@@ -0,0 +1,41 @@
+/**
+ * @file storage_hx.cpp
+ * @brief Implementation of the space budget of the recorders.
+ * @details Contains the free space query of the file systems used by the firmware.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "storage_hx.h"
+
+#include <FFat.h>
+#ifdef _RUNLOG_SD
+#include <SD.h>
+#endif
+
+size_t storageFree(fs::FS &fileSystem) {
+  uint64_t free = SIZE_MAX;
+  if (&fileSystem == &FFat) {
+    free = FFat.freeBytes();
+  }
+#ifdef _RUNLOG_SD
+  if (&fileSystem == &SD) {
+    free = SD.totalBytes() - SD.usedBytes();
+  }
+#endif
+  if (free <= _STORAGE_RESERVE) {
+    return 0;
+  }
+  free -= _STORAGE_RESERVE;
+  return free < SIZE_MAX ? (size_t)free : SIZE_MAX;
+}
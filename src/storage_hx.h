@@ -0,0 +1,38 @@
+/**
+ * @file storage_hx.h
+ * @brief Shared space budget of the recorders on the FAT partition.
+ * @details This file declares `storageFree()`, which the run log and the input capture check
+ *          before every append, so the two never fill the file system between them.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef STORAGE_HX_H
+#define STORAGE_HX_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "globals_hx.h"
+
+/**
+ * @brief Gets the bytes that may still be appended to a file system.
+ * @details The free space reported by the file system minus `_STORAGE_RESERVE`, which is kept
+ *          for the presets, the settings and the directory entries. The query may take a few
+ *          milliseconds on a FAT volume, so it is meant for the writer tasks, not the loop.
+ * @param fileSystem `FFat`, or `SD` with `_RUNLOG_SD`; any other file system counts as unlimited.
+ * @return Bytes available for logs, 0 if the reserve is reached.
+ */
+size_t storageFree(fs::FS &fileSystem);
+
+
+#endif  // STORAGE_HX_H
@@ -0,0 +1,89 @@
+/**
+ * @file telemetry_hx.cpp
+ * @brief Implementation of the binary telemetry sender.
+ * @details Contains the frame encoding and the transmit task of `Telemetry`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Diagnostics through the asynchronous logger
+ * - **2026-10-19**: Frame transmission traced
+ * - **2026-10-19**: Frame encoding moved to `encode()`
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "telemetry_hx.h"
+#include "log_hx.h"
+#include "trace_hx.h"
+
+Telemetry::Telemetry()
+  : port(nullptr), queue(nullptr), sequence(0), enabled(false), sent(0), dropped(0) {}
+
+bool Telemetry::begin(Print &output) {
+  port = &output;
+  queue = xQueueCreate(_TELEMETRY_QUEUE_LENGTH, sizeof(TelemetryFrame));
+  if (queue == nullptr
+      || xTaskCreatePinnedToCore(transmitTask, "telemetry", _TELEMETRY_TASK_STACK, this, _TELEMETRY_TASK_PRIORITY, nullptr, 0) != pdPASS) {
+    HX_LOG_ERROR("Telemetry: cannot start transmit task");
+    queue = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool Telemetry::send(enumTelemetryType type, const void *message, size_t length) {
+  if (!enabled || queue == nullptr) {
+    return false;
+  }
+
+  TelemetryFrame frame;
+  if (encode(frame, type, sequence, message, length) == 0) {
+    return false;
+  }
+  sequence++;
+  if (xQueueSend(queue, &frame, 0) != pdTRUE) {
+    dropped++;
+    return false;
+  }
+  return true;
+}
+
+size_t Telemetry::encode(TelemetryFrame &frame, enumTelemetryType type, uint16_t sequence, const void *message,
+                         size_t length) {
+  if (sizeof(TelemetryHeader) + length + sizeof(uint16_t) > TELEMETRY_PAYLOAD_MAX) {
+    return 0;
+  }
+
+  uint8_t payload[TELEMETRY_PAYLOAD_MAX];
+  TelemetryHeader header = { TELEMETRY_VERSION, (uint8_t)type, sequence };
+  memcpy(payload, &header, sizeof(header));
+  memcpy(payload + sizeof(header), message, length);
+  size_t size = sizeof(header) + length;
+  uint16_t crc = telemetryCrc16(payload, size);
+  payload[size++] = crc & 0xFF;
+  payload[size++] = crc >> 8;
+
+  frame.data[0] = 0;
+  frame.length = cobsEncode(payload, size, frame.data + 1) + 1;
+  frame.data[frame.length++] = 0;
+  return frame.length;
+}
+
+void Telemetry::transmitTask(void *parameter) {
+  Telemetry *telemetry = (Telemetry *)parameter;
+  TelemetryFrame frame;
+  for (;;) {
+    if (xQueueReceive(telemetry->queue, &frame, portMAX_DELAY) == pdTRUE) {
+      HX_TRACE_SCOPE(TRACE_TELEMETRY);
+      telemetry->port->write(frame.data, frame.length);
+      telemetry->sent++;
+    }
+  }
+}
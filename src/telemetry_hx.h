@@ -0,0 +1,148 @@
+/**
+ * @file telemetry_hx.h
+ * @brief Binary telemetry stream on the serial port.
+ * @details This file contains the `Telemetry` class, which encodes telemetry messages into
+ *          COBS frames and sends them from a background task.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Frame encoding in `encode()`, shared with the host benchmark
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef TELEMETRY_HX_H
+#define TELEMETRY_HX_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "globals_hx.h"
+#include "telemetry_protocol_hx.h"
+
+/**
+ * @brief One encoded frame waiting for transmission.
+ */
+typedef struct {
+  uint8_t length;                    ///< Number of bytes in `data`.
+  uint8_t data[TELEMETRY_FRAME_MAX];  ///< Frame including both delimiters.
+} TelemetryFrame;
+
+/**
+ * @brief Telemetry sender with a transmit task.
+ * @details `send()` encodes a message into a frame on the stack, see `telemetry_protocol_hx.h`,
+ *          and passes it to a queue of `_TELEMETRY_QUEUE_LENGTH` preallocated frames. A
+ *          low-priority task writes each frame to the port in one call, so frames are never
+ *          split by text output of other tasks. If the queue is full, the frame is dropped and
+ *          the sequence number still advances, so the host sees the loss.
+ *
+ *          Compared to formatted text, a control message costs 24 bytes on the wire and no
+ *          float formatting in the loop task. The stream is decoded on the host with the
+ *          library in `tools/telemetry`.
+ *
+ * ### Example Usage
+ * ```cpp
+ * Telemetry telemetry;
+ *
+ * void setup() {
+ *   Serial.begin(115200);
+ *   telemetry.begin(Serial);
+ *   telemetry.setEnabled(true);
+ * }
+ *
+ * void loop() {
+ *   TelemetryControl message = { millis(), setpoint, temperature, rate, humidity, duty, flags, profile };
+ *   telemetry.send(TELEMETRY_CONTROL, &message, sizeof(message));
+ * }
+ * ```
+ */
+class Telemetry {
+private:
+  Print *port;                    /**< Port the frames are written to. */
+  QueueHandle_t queue;            /**< Frames waiting for the transmit task. */
+  uint16_t sequence;              /**< Sequence number of the next frame. */
+  bool enabled;                   /**< True if messages are sent. */
+  std::atomic<uint32_t> sent;     /**< Frames sent since boot. */
+  std::atomic<uint32_t> dropped;  /**< Frames dropped because the queue was full. */
+
+  static void transmitTask(void *parameter);
+
+public:
+  /**
+   * @brief Constructor: Initializes a disabled sender.
+   */
+  Telemetry();
+
+  /**
+   * @brief Creates the frame queue and starts the transmit task.
+   * @param port Port to write to, e.g. `Serial`.
+   * @return true if the sender is ready.
+   */
+  bool begin(Print &port);
+
+  /**
+   * @brief Encodes a message and queues it; returns at once.
+   * @param type Message type, see `enumTelemetryType`.
+   * @param message Message struct.
+   * @param length Size of the message struct.
+   * @return true if the frame has been queued.
+   */
+  bool send(enumTelemetryType type, const void *message, size_t length);
+
+  /**
+   * @brief Encodes a message into a delimited frame: header, message and CRC-16, COBS encoded
+   *        between zero bytes.
+   * @param frame Receives the frame.
+   * @param type Message type, see `enumTelemetryType`.
+   * @param sequence Sequence number of the frame.
+   * @param message Message struct.
+   * @param length Size of the message struct.
+   * @return Length of the frame, 0 if the message does not fit.
+   */
+  static size_t encode(TelemetryFrame &frame, enumTelemetryType type, uint16_t sequence, const void *message,
+                       size_t length);
+
+  /**
+   * @brief Switches the stream on or off.
+   * @param on true to send messages.
+   */
+  void setEnabled(bool on) {
+    enabled = on;
+  }
+
+  /**
+   * @brief Checks if the stream is on.
+   * @return true if messages are sent.
+   */
+  bool isEnabled() const {
+    return enabled;
+  }
+
+  /**
+   * @brief Gets the number of sent frames.
+   * @return Frames sent since boot.
+   */
+  uint32_t getSent() const {
+    return sent;
+  }
+
+  /**
+   * @brief Gets the number of dropped frames.
+   * @return Frames dropped since boot.
+   */
+  uint32_t getDropped() const {
+    return dropped;
+  }
+};
+
+
+#endif  // TELEMETRY_HX_H
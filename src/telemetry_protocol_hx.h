@@ -0,0 +1,195 @@
+/**
+ * @file telemetry_protocol_hx.h
+ * @brief Binary telemetry protocol shared by the firmware and the host tools.
+ * @details This file defines the frame layout, the message schema, the CRC16 and the COBS
+ *          framing of the telemetry stream. It depends only on the C++ standard headers, so
+ *          the host decoder in `tools/telemetry` uses it unchanged.
+ *
+ * ### Frame Layout
+ * ```
+ * 0x00 | COBS( version | type | sequence | message | crc16 ) | 0x00
+ * ```
+ * - `version`: `TELEMETRY_VERSION`, one byte
+ * - `type`: `enumTelemetryType`, one byte
+ * - `sequence`: frame counter, `uint16_t` little endian, gaps show lost frames
+ * - `message`: one of the message structs below, little endian
+ * - `crc16`: CRC-16/CCITT-FALSE of all preceding payload bytes, little endian
+ *
+ * Each frame is enclosed in zero bytes, so text on the same port is separated from the frames
+ * and rejected by the decoder.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Latency statistics message
+ * - **2026-10-19**: I2C error counters message
+ * - **2026-10-19**: Control message at a fixed rate
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef TELEMETRY_PROTOCOL_HX_H
+#define TELEMETRY_PROTOCOL_HX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TELEMETRY_VERSION 1        ///< Version of the message schema
+#define TELEMETRY_PAYLOAD_MAX 60   ///< Maximum payload size including header and CRC in bytes
+#define TELEMETRY_I2C_ERRORS 7     ///< Error classes in `TelemetryI2c`, see `enumI2cError`
+#define TELEMETRY_FRAME_MAX (TELEMETRY_PAYLOAD_MAX + TELEMETRY_PAYLOAD_MAX / 254 + 3)  ///< Maximum encoded frame size
+
+/**
+ * @brief Message types.
+ */
+enum enumTelemetryType {
+  TELEMETRY_CONTROL = 1,  ///< `TelemetryControl`, one per `_TELEMETRY_CONTROL_INTERVAL`.
+  TELEMETRY_LATENCY = 2,  ///< `TelemetryLatency`, one channel per `_LATENCY_TELEMETRY_INTERVAL`.
+  TELEMETRY_I2C = 3,      ///< `TelemetryI2c`, one device per `_I2C_TELEMETRY_INTERVAL`.
+};
+
+/**
+ * @brief Bits of `TelemetryControl::flags`.
+ */
+enum enumTelemetryFlags {
+  TELEMETRY_FLAG_RUNNING = 0x01,  ///< A drying run is active.
+  TELEMETRY_FLAG_HEATING = 0x02,  ///< The heating PID is in automatic mode.
+  TELEMETRY_FLAG_FAN = 0x04,      ///< The heater fan is on.
+  TELEMETRY_FLAG_SENSOR = 0x08,   ///< Valid sensor data is available.
+};
+
+/**
+ * @brief Header in front of every message.
+ */
+typedef struct {
+  uint8_t version;    ///< Schema version `TELEMETRY_VERSION`.
+  uint8_t type;       ///< Message type, see `enumTelemetryType`.
+  uint16_t sequence;  ///< Frame counter.
+} TelemetryHeader;
+
+/**
+ * @brief State of the heating control loop.
+ */
+typedef struct {
+  uint32_t time;        ///< Sample time (ms since boot).
+  int16_t setpoint;     ///< Target temperature (0.01 °C).
+  int16_t temperature;  ///< Fused temperature (0.01 °C).
+  int16_t rate;         ///< Temperature rate (0.01 °C/s).
+  int16_t humidity;     ///< Relative humidity (0.01 %).
+  uint16_t duty;        ///< Heater duty cycle (0.01 %).
+  uint8_t flags;        ///< State bits, see `enumTelemetryFlags`.
+  uint8_t profile;      ///< Sensor profile, see `enumSensorProfile`.
+} TelemetryControl;
+
+/**
+ * @brief Latency statistics of one channel since boot or the last reset.
+ */
+typedef struct {
+  uint8_t channel;          ///< Channel, see `enumLatencyChannel`.
+  uint8_t reserved[3];      ///< Zero.
+  uint32_t count;           ///< Number of recorded values.
+  uint32_t p50;             ///< Median (µs).
+  uint32_t p99;             ///< 99th percentile (µs).
+  uint32_t max;             ///< Maximum (µs).
+  uint32_t deadlineMisses;  ///< PID periods longer than the deadline.
+} TelemetryLatency;
+
+/**
+ * @brief Bus statistics of one I2C device since boot or the last reset.
+ */
+typedef struct {
+  uint8_t address;                        ///< 7 bit address of the device.
+  uint8_t faulted;                        ///< 1 while the bus is stuck and transactions are skipped.
+  uint16_t recoveries;                    ///< Bus recoveries since boot, for all devices.
+  uint32_t transactions;                  ///< Transactions of the device.
+  uint32_t errors[TELEMETRY_I2C_ERRORS];  ///< Failed transactions per class, `enumI2cError` minus one.
+} TelemetryI2c;
+
+static_assert(sizeof(TelemetryHeader) == 4, "TelemetryHeader is part of the wire format");
+static_assert(sizeof(TelemetryControl) == 16, "TelemetryControl is part of the wire format");
+static_assert(sizeof(TelemetryLatency) == 24, "TelemetryLatency is part of the wire format");
+static_assert(sizeof(TelemetryI2c) == 36, "TelemetryI2c is part of the wire format");
+
+/**
+ * @brief Computes the CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+ * @param data Bytes to check.
+ * @param length Number of bytes.
+ * @param crc Running CRC, for checksums over several blocks.
+ * @return CRC of the bytes.
+ */
+inline uint16_t telemetryCrc16(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF) {
+  while (length--) {
+    crc ^= (uint16_t)(*data++) << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief Encodes bytes with Consistent Overhead Byte Stuffing.
+ * @details The output contains no zero bytes; the delimiters are not written.
+ * @param input Bytes to encode.
+ * @param length Number of input bytes.
+ * @param output Destination, at least `length + length / 254 + 1` bytes.
+ * @return Number of bytes written.
+ */
+inline size_t cobsEncode(const uint8_t *input, size_t length, uint8_t *output) {
+  size_t code = 0;  // Position of the current code byte
+  size_t out = 1;
+  uint8_t run = 1;
+  for (size_t i = 0; i < length; i++) {
+    if (input[i] == 0) {
+      output[code] = run;
+      code = out++;
+      run = 1;
+    } else {
+      output[out++] = input[i];
+      if (++run == 0xFF) {
+        output[code] = run;
+        code = out++;
+        run = 1;
+      }
+    }
+  }
+  output[code] = run;
+  return out;
+}
+
+/**
+ * @brief Decodes a COBS frame without its delimiters.
+ * @param input Encoded bytes.
+ * @param length Number of encoded bytes.
+ * @param output Destination.
+ * @param capacity Size of `output`; `length` bytes are always enough.
+ * @return Number of decoded bytes, 0 if the frame is malformed or too long.
+ */
+inline size_t cobsDecode(const uint8_t *input, size_t length, uint8_t *output, size_t capacity) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < length) {
+    uint8_t code = input[in++];
+    if (code == 0 || in + code - 1 > length || out + code > capacity + 1) {
+      return 0;
+    }
+    memcpy(output + out, input + in, code - 1);
+    out += code - 1;
+    in += code - 1;
+    if (code != 0xFF && in < length) {
+      if (out >= capacity) return 0;
+      output[out++] = 0;
+    }
+  }
+  return out;
+}
+
+
+#endif  // TELEMETRY_PROTOCOL_HX_H
@@ -0,0 +1,136 @@
+/**
+ * @file trace_hx.cpp
+ * @brief Implementation of the trace recorder.
+ * @details Contains the per-core ring buffers, the task numbers and the streamed text dump of
+ *          `Tracer`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Task numbers, dump printed in chunks from the loop
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "trace_hx.h"
+
+static const char *const spanNames[TRACE_SPAN_COUNT] = {
+  "bme_measure", "bme_read", "fusion", "control", "pid", "lcd", "log", "runlog", "telemetry"
+};
+
+const char *traceSpanName(uint8_t span) {
+  return (span < TRACE_SPAN_COUNT) ? spanNames[span] : "unknown";
+}
+
+#ifdef _TRACE_ENABLED
+
+#include <esp_cpu.h>
+
+static_assert((_TRACE_RING_SIZE & (_TRACE_RING_SIZE - 1)) == 0, "_TRACE_RING_SIZE must be a power of two");
+
+Tracer tracer;
+
+Tracer::Tracer()
+  : paused(false), dumpPort(nullptr), dumpTask(-1), dumpCore(0), dumpIndex(0) {
+  heads[0] = 0;
+  heads[1] = 0;
+  for (uint8_t i = 0; i < _TRACE_TASKS; i++) {
+    tasks[i] = nullptr;
+    taskNames[i][0] = '\0';
+  }
+}
+
+void Tracer::record(uint8_t span, uint8_t phase) {
+  if (paused.load(std::memory_order_relaxed)) {
+    return;
+  }
+  uint32_t cycles = esp_cpu_get_cycle_count();
+  uint8_t core = xPortGetCoreID() & 0x01;
+  uint8_t task = taskNumber();
+  uint32_t index = heads[core].fetch_add(1, std::memory_order_relaxed) & (_TRACE_RING_SIZE - 1);
+  events[core][index] = { cycles, span, phase, task };
+}
+
+uint8_t Tracer::taskNumber() {
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  for (uint8_t i = 0; i < _TRACE_TASKS; i++) {
+    TaskHandle_t known = tasks[i].load(std::memory_order_acquire);
+    if (known == current) {
+      return i;
+    }
+    // The first event of a task claims the next free number, a task that loses the race searches on
+    if (known == nullptr && tasks[i].compare_exchange_strong(known, current, std::memory_order_acq_rel)) {
+      strncpy(taskNames[i], pcTaskGetName(nullptr), configMAX_TASK_NAME_LEN - 1);
+      return i;
+    }
+  }
+  return _TRACE_TASKS;
+}
+
+uint32_t Tracer::firstIndex(uint8_t core) const {
+  uint32_t head = heads[core];
+  return head - ((head < _TRACE_RING_SIZE) ? head : _TRACE_RING_SIZE);
+}
+
+bool Tracer::startDump(Print &out) {
+  if (dumpPort != nullptr) {
+    return false;
+  }
+  // Records in progress on the other core are finished by the first update() in the next loop pass
+  paused = true;
+  dumpPort = &out;
+  dumpTask = -1;
+  dumpCore = 0;
+  dumpIndex = firstIndex(0);
+  return true;
+}
+
+void Tracer::update() {
+  if (dumpPort == nullptr) {
+    return;
+  }
+  for (uint8_t i = 0; i < _TRACE_DUMP_CHUNK && dumpPort->availableForWrite() >= _TRACE_DUMP_LINE; i++) {
+    if (!printLine()) {
+      dumpPort = nullptr;
+      paused = false;
+      return;
+    }
+  }
+}
+
+bool Tracer::printLine() {
+  if (dumpTask < 0) {
+    dumpPort->printf("# heatX trace v2 cpu_mhz=%u\n", (unsigned)getCpuFrequencyMhz());
+    dumpTask = 0;
+    return true;
+  }
+  while (dumpTask < _TRACE_TASKS) {
+    uint8_t task = dumpTask++;
+    if (tasks[task].load() != nullptr) {
+      dumpPort->printf("# task %u %s\n", task, taskNames[task]);
+      return true;
+    }
+  }
+  while (dumpCore < 2) {
+    if (dumpIndex != heads[dumpCore]) {
+      const TraceEvent &event = events[dumpCore][dumpIndex++ & (_TRACE_RING_SIZE - 1)];
+      dumpPort->printf("T %u %u %u %c %s\n", dumpCore, event.task, (unsigned)event.cycles,
+                       event.phase == TRACE_PHASE_BEGIN ? 'B' : 'E', traceSpanName(event.span));
+      return true;
+    }
+    heads[dumpCore] = 0;
+    if (++dumpCore < 2) {
+      dumpIndex = firstIndex(dumpCore);
+    }
+  }
+  dumpPort->println("# end");
+  return false;
+}
+
+#endif  // _TRACE_ENABLED
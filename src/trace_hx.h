@@ -0,0 +1,219 @@
+/**
+ * @file trace_hx.h
+ * @brief Cycle-accurate trace instrumentation.
+ * @details This file contains the `HX_TRACE_*` macros and the `Tracer` class, which record the
+ *          begin and end of code spans with the CPU cycle counter into one ring buffer per core.
+ *          They replace the logic analyzer pins of earlier versions.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Task of each event recorded, dump streamed from the loop
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef TRACE_HX_H
+#define TRACE_HX_H
+
+#include <Arduino.h>
+#include "globals_hx.h"
+
+/**
+ * @brief Traced code spans.
+ */
+enum enumTraceSpan {
+  TRACE_BME_MEASURE,  ///< BME280 conversion in progress (was debug pin 4).
+  TRACE_BME_READ,     ///< Burst read and compensation of a BME280 sample.
+  TRACE_FUSION,       ///< Sensor fusion update.
+  TRACE_CONTROL,      ///< Processing of a fused sample (was debug pin 5).
+  TRACE_PID,          ///< PID computation and PWM update (was debug pin 6).
+  TRACE_LCD,          ///< LCD update.
+  TRACE_LOG,          ///< Formatting of the log records.
+  TRACE_RUNLOG,       ///< Writing a run log block.
+  TRACE_TELEMETRY,    ///< Transmission of a telemetry frame.
+  TRACE_SPAN_COUNT    ///< Number of spans.
+};
+
+/**
+ * @brief Phase of a trace event.
+ */
+enum enumTracePhase {
+  TRACE_PHASE_BEGIN,  ///< Span started.
+  TRACE_PHASE_END,    ///< Span ended.
+};
+
+#ifdef _TRACE_ENABLED
+
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * @brief One trace event.
+ */
+typedef struct {
+  uint32_t cycles;  ///< CPU cycle counter of the core.
+  uint8_t span;     ///< Span, see `enumTraceSpan`.
+  uint8_t phase;    ///< Phase, see `enumTracePhase`.
+  uint8_t task;     ///< Recording task, index in the task table of `Tracer`.
+} TraceEvent;
+
+/**
+ * @brief Trace recorder with one ring buffer per core.
+ * @details An event costs a cycle counter read, a lookup of the task, an atomic increment and
+ *          an 8 byte store, so spans of a few microseconds can be measured. Each core writes
+ *          only to its own ring, so the cores never contend; tasks on the same core share the
+ *          ring through the atomic index. The rings keep the last `_TRACE_RING_SIZE` events per
+ *          core.
+ *
+ *          Every event carries the task that recorded it, so the spans of tasks that interleave
+ *          on one core are matched per task. A task gets its number with its first event; the
+ *          first `_TRACE_TASKS` tasks are told apart, all later ones share the number
+ *          `_TRACE_TASKS`.
+ *
+ *          `startDump()` pauses the recording, and `update()` prints the events as text in the
+ *          following loop passes, at most `_TRACE_DUMP_CHUNK` lines per pass and only while the
+ *          port has `_TRACE_DUMP_LINE` bytes free, so the loop never waits for the port. The
+ *          recording resumes after the last line. The host tool `tools/trace/hx_trace2json`
+ *          converts a captured dump into Chrome trace JSON, which is opened in Perfetto or
+ *          `chrome://tracing`.
+ *
+ *          The cycle counters of the two cores are not synchronized, so spans can only be
+ *          compared exactly within one core. The 32 bit counters wrap after about 17 s at
+ *          240 MHz; the converter unwraps them under the assumption that consecutive events of
+ *          a core are less than one wrap apart.
+ *
+ * ### Example Usage
+ * ```cpp
+ * void controlHeating() {
+ *   HX_TRACE_SCOPE(TRACE_PID);
+ *   pid.Compute();
+ * }
+ *
+ * void commandTrace(const char *args) {
+ *   tracer.startDump(Serial);
+ * }
+ *
+ * void loop() {
+ *   tracer.update();
+ * }
+ * ```
+ */
+class Tracer {
+private:
+  TraceEvent events[2][_TRACE_RING_SIZE];                 /**< Ring buffer per core. */
+  std::atomic<uint32_t> heads[2];                         /**< Next write position per core. */
+  std::atomic<bool> paused;                               /**< True while the rings are dumped. */
+  std::atomic<TaskHandle_t> tasks[_TRACE_TASKS];          /**< Tasks by number, nullptr if free. */
+  char taskNames[_TRACE_TASKS][configMAX_TASK_NAME_LEN];  /**< Names of the numbered tasks. */
+  Print *dumpPort;                                        /**< Destination of the running dump, nullptr if none. */
+  int8_t dumpTask;                                        /**< Next task name to print, -1 for the header. */
+  uint8_t dumpCore;                                       /**< Core of the next event to print. */
+  uint32_t dumpIndex;                                     /**< Ring position of the next event to print. */
+
+  uint8_t taskNumber();
+  uint32_t firstIndex(uint8_t core) const;
+  bool printLine();
+
+public:
+  /**
+   * @brief Constructor: Initializes empty rings.
+   */
+  Tracer();
+
+  /**
+   * @brief Records an event on the calling core.
+   * @param span Span, see `enumTraceSpan`.
+   * @param phase Phase, see `enumTracePhase`.
+   */
+  void record(uint8_t span, uint8_t phase);
+
+  /**
+   * @brief Pauses the recording and starts a dump of the recorded events.
+   * @details The dump is printed by `update()` and clears the rings. Output format, the task
+   *          names and one event per line after the header:
+   *          ```
+   *          # heatX trace v2 cpu_mhz=240
+   *          # task <task> <task name>
+   *          T <core> <task> <cycles> <B|E> <span name>
+   *          # end
+   *          ```
+   * @param out Destination, e.g. `Serial`.
+   * @return false if a dump is already running.
+   */
+  bool startDump(Print &out);
+
+  /**
+   * @brief Prints the next lines of a running dump. Call cyclically from the loop.
+   */
+  void update();
+
+  /**
+   * @brief Checks if a dump is running.
+   * @return true until the last line of the dump has been printed.
+   */
+  bool isDumping() const {
+    return dumpPort != nullptr;
+  }
+};
+
+/**
+ * @brief Global tracer used by the `HX_TRACE_*` macros.
+ */
+extern Tracer tracer;
+
+/**
+ * @brief Records the begin of a span on construction and its end on destruction.
+ */
+class TraceScope {
+private:
+  uint8_t span; /**< Traced span. */
+
+public:
+  /**
+   * @brief Constructor: Records the begin of the span.
+   * @param span Span, see `enumTraceSpan`.
+   */
+  explicit TraceScope(uint8_t span)
+    : span(span) {
+    tracer.record(span, TRACE_PHASE_BEGIN);
+  }
+
+  /**
+   * @brief Destructor: Records the end of the span.
+   */
+  ~TraceScope() {
+    tracer.record(span, TRACE_PHASE_END);
+  }
+};
+
+#define HX_TRACE_CONCAT_(a, b) a##b
+#define HX_TRACE_CONCAT(a, b) HX_TRACE_CONCAT_(a, b)
+#define HX_TRACE_SCOPE(span) TraceScope HX_TRACE_CONCAT(traceScope, __LINE__)(span)  ///< Traces the rest of the block
+#define HX_TRACE_BEGIN(span) tracer.record(span, TRACE_PHASE_BEGIN)                    ///< Records the begin of a span
+#define HX_TRACE_END(span) tracer.record(span, TRACE_PHASE_END)                        ///< Records the end of a span
+
+#else
+
+#define HX_TRACE_SCOPE(span) do {} while (0)
+#define HX_TRACE_BEGIN(span) do {} while (0)
+#define HX_TRACE_END(span) do {} while (0)
+
+#endif  // _TRACE_ENABLED
+
+/**
+ * @brief Gets the name of a span.
+ * @param span Span, see `enumTraceSpan`.
+ * @return Name without spaces, e.g. `"pid"`.
+ */
+const char *traceSpanName(uint8_t span);
+
+
+#endif  // TRACE_HX_H
@@ -0,0 +1,853 @@
+/**
+ * @file hx_analyze.cpp
+ * @brief Offline analysis of recorded runs: KPIs, plant identification and recommended gains.
+ * @details Reads run logs (the `.bin` segments in `_RUNLOG_DIR` of `RunLogger`) and raw telemetry streams as
+ *          recorded from the serial port, any number of them, typically one file per box. The
+ *          type of every file is detected from its first bytes. The files are memory-mapped
+ *          and processed in two parallel stages on a `WorkStealingPool`:
+ *          1. Index: every file is cut into chunks that are scanned independently. A chunk of a
+ *             run log yields its valid blocks, a chunk of a telemetry stream the frames where
+ *             the run state changes. The chunk results are joined into runs.
+ *          2. Runs: every run is one task that streams its samples twice, first for the
+ *             setpoint and the humidity floor, then for the KPIs and the model fits. A run
+ *             keeps no samples, so the memory does not grow with the length of the logs.
+ *
+ *          The KPIs follow `closed_loop.h`, so logged runs and simulated runs compare
+ *          directly. The run log has no setpoint, it is taken from the mean temperature of the
+ *          hold phase. The material is the preset whose temperature matches the setpoint;
+ *          presets with the same temperature cannot be told apart and share one class, unless
+ *          `--material` names it. The chamber humidity reaches the preset humidity right after
+ *          the heat-up and says nothing about the moisture left in the spools, so no drying time
+ *          is derived from it; the lowest humidity is listed instead.
+ *
+ *          The models of `plant_fit.h` are fitted on a uniform grid of cell means of the values
+ *          held between the samples. Only the fast profile phases enter the fits: heat-up,
+ *          setpoint changes and recoveries. In the hold phase the controller keeps the
+ *          temperature flat and the data describes the controller rather than the dryer. The
+ *          ambient temperature of the fits is anchored to the samples before the first heater
+ *          duty. The hold phase gives the steady-state gain, the temperature rise over the mean
+ *          duty; fits whose gain is off from it by more than a factor of `gainTolerance` are
+ *          rejected, as closed-loop data can trade the gain against the time constant.
+ *
+ *          Per material the median FOPDT parameters of all runs give the recommended gains by
+ *          the SIMC rules for a PI with the closed-loop time constant equal to the dead time.
+ *          The gains are in the units of `PID_heatX` with the heater output in PWM counts up to
+ *          `_PWM_MAX_VALUE`; the derivative stays 0. The median time constants of the two-node
+ *          model are listed with them for comparison with the heater and air nodes of
+ *          `DryerParams`.
+ *
+ *          The runs are written as CSV to stdout or `--runs`, the gains as CSV to stdout or
+ *          `--gains`, counters and throughput to stderr.
+ *
+ * ### Example Usage
+ * ```sh
+ * hx_analyze box1/runlog/<run>.bin box2/runlog/<run>.bin --material PETG box3/telemetry.bin --gains gains.csv
+ * hx_analyze --threads 4 --step 5 --max-dead-time 300 runlog/00000042.bin
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Run logs read as one segment per run
+ * - **2026-10-19**: Fits anchored to the pre-step ambient and checked against the steady-state gain
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "plant_fit.h"
+#include "telemetry_decoder.h"
+#include "thread_pool.h"
+
+#include "globals_hx.h"
+#include "runlog_format_hx.h"
+#include "sensor_hx.h"
+
+/**
+ * @brief Command line options.
+ */
+struct Options {
+  size_t threads = 0;               ///< Worker threads, 0 for all cores.
+  double step = 2;                  ///< Grid step of the model fits in s.
+  double maxDeadTime = 120;         ///< Longest dead time tried by the fits in s.
+  double heaterWatts = 250;         ///< Heater power at full duty in W, as in `DryerParams`.
+  double gapSeconds = 60;           ///< Longer gaps between samples split the fits and are not counted.
+  size_t chunkSize = 4 << 20;       ///< Bytes per index task.
+  const char *runsPath = nullptr;   ///< Run CSV, stdout if not set.
+  const char *gainsPath = nullptr;  ///< Gain CSV, stdout if not set.
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+private:
+  const uint8_t *bytes; /**< Mapped contents, nullptr if empty or not mapped. */
+  size_t length;        /**< File size in bytes. */
+
+public:
+  MappedFile() : bytes(nullptr), length(0) {}
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile() {
+    if (bytes != nullptr) munmap((void *)bytes, length);
+  }
+
+  /**
+   * @brief Maps a file.
+   * @param path File to map.
+   * @return false if the file cannot be opened or mapped.
+   */
+  bool open(const char *path) {
+    int fd = ::open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+      if (fd >= 0) close(fd);
+      return false;
+    }
+    length = info.st_size;
+    if (length > 0) {
+      void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        close(fd);
+        return false;
+      }
+      madvise(mapping, length, MADV_SEQUENTIAL);
+      bytes = (const uint8_t *)mapping;
+    }
+    close(fd);
+    return true;
+  }
+
+  /**
+   * @brief Gets the contents.
+   * @return First byte of the mapping.
+   */
+  const uint8_t *data() const {
+    return bytes;
+  }
+
+  /**
+   * @brief Gets the size.
+   * @return File size in bytes.
+   */
+  size_t size() const {
+    return length;
+  }
+};
+
+/**
+ * @brief One input file.
+ */
+struct Input {
+  std::string path;     ///< Path as given on the command line.
+  int material = -1;    ///< Preset index from `--material`, -1 to classify by setpoint.
+  bool runLog = false;  ///< True for a run log, false for a telemetry stream.
+  MappedFile file;      ///< Contents.
+};
+
+/**
+ * @brief Valid block of a run log.
+ */
+struct BlockRef {
+  size_t offset;   ///< Position in the file.
+  uint32_t runId;  ///< Run of the block.
+};
+
+/**
+ * @brief Telemetry frame at which the run state changes.
+ */
+struct Mark {
+  size_t offset;  ///< Position of the frame delimiter in the file.
+  uint32_t time;  ///< Sample time (ms since boot).
+  bool running;   ///< Run flag of the frame.
+};
+
+/**
+ * @brief Result of one index task.
+ */
+struct ChunkIndex {
+  std::vector<BlockRef> blocks;  ///< Blocks starting in the chunk, run logs only.
+  std::vector<Mark> marks;       ///< Run state changes in the chunk, telemetry only.
+  size_t badBlocks = 0;          ///< Block headers with a wrong CRC.
+  TelemetryStats frames;         ///< Frame counters, telemetry only.
+};
+
+/**
+ * @brief One run of one input.
+ */
+struct Span {
+  size_t input;  ///< Index of the input.
+  uint32_t run;  ///< Run ID of the log, or the number of the run in a telemetry stream.
+  size_t begin;  ///< First block of the run log or first byte of the telemetry stream.
+  size_t end;    ///< End of the blocks or the bytes, exclusive.
+};
+
+/**
+ * @brief One sample of a run, from either source.
+ */
+struct Sample {
+  uint32_t time;        ///< Sample time (ms since boot).
+  int32_t setpoint;     ///< Target temperature (0.01 °C), `INT32_MIN` if not logged.
+  int32_t temperature;  ///< Temperature (0.01 °C).
+  int32_t humidity;     ///< Relative humidity (0.01 %).
+  int32_t duty;         ///< Heater duty (0.01 %).
+  uint8_t mode;         ///< Control phase, see `enumSensorProfile`.
+};
+
+/**
+ * @brief Results of one run.
+ */
+struct RunResult {
+  double startS = 0;         ///< Time of the first sample in s since boot.
+  double durationS = 0;      ///< Time from the first to the last sample in s.
+  size_t samples = 0;        ///< Number of samples.
+  std::string material;      ///< Material class, "custom" if the setpoint matches no preset.
+  double setpointC = -1;     ///< Setpoint in °C, -1 if unknown.
+  double riseS = -1;         ///< Rise time from 10 % to 90 % in s.
+  double overshootC = -1;    ///< Overshoot in °C.
+  double settlingS = -1;     ///< Settling time into the hold band in s.
+  double rmsC = -1;          ///< RMS control error in the second half of the run in °C.
+  double dutyMean = 0;       ///< Time-weighted mean duty in %.
+  double dutyP95 = 0;        ///< 95th percentile of the duty in %.
+  double dutySaturated = 0;  ///< Share of the time at full duty.
+  double energyWh = 0;       ///< Heater energy in Wh.
+  double humidityMin = -1;   ///< Lowest humidity in %.
+  double ambientC = 0;       ///< Mean temperature before the first heater duty in °C.
+  double steadyGain = -1;    ///< Hold temperature rise over the hold duty in °C per %, -1 without hold.
+  FopdtModel fopdt;          ///< First order fit.
+  TwoNodeModel twoNode;      ///< Two-node fit.
+};
+
+/** Setpoints this close to a preset temperature belong to its material, in 0.01 °C. */
+static constexpr int32_t materialTolerance = 200;
+
+/** Duty at or above this counts as saturated, in 0.01 %. */
+static constexpr int32_t saturatedDuty = 9950;
+
+/** A fitted gain off the steady-state gain by more than this factor is rejected. */
+static constexpr double gainTolerance = 2;
+
+/** Bins of the duty histogram, 0.1 % each. */
+static constexpr size_t dutyBins = 1001;
+
+static bool readBlock(const Input &input, size_t offset, RunLogBlockHeader &header, bool &torn) {
+  const uint8_t *data = input.file.data();
+  torn = false;
+  if (offset + sizeof(header) > input.file.size()) return false;
+  memcpy(&header, data + offset, sizeof(header));
+  if (header.magic != _RUNLOG_MAGIC || header.version != _RUNLOG_VERSION || header.count == 0) return false;
+  if (offset + sizeof(header) + header.length > input.file.size()) {
+    torn = true;
+    return false;
+  }
+  uint32_t crc = runLogCrc32(data + offset, offsetof(RunLogBlockHeader, crc));
+  torn = runLogCrc32(data + offset + sizeof(header), header.length, crc) != header.crc;
+  return !torn;
+}
+
+static void indexRunLog(const Input &input, size_t begin, size_t end, ChunkIndex &index) {
+  const uint8_t *data = input.file.data();
+  size_t offset = begin;
+  while (offset < end) {
+    // The first byte of the magic is the cheap filter, the CRC decides
+    const uint8_t *hit = (const uint8_t *)memchr(data + offset, _RUNLOG_MAGIC & 0xFF, end - offset);
+    if (hit == nullptr) break;
+    offset = hit - data;
+    RunLogBlockHeader header;
+    bool torn;
+    if (readBlock(input, offset, header, torn)) {
+      index.blocks.push_back({ offset, header.runId });
+      offset += sizeof(header) + header.length;
+    } else {
+      index.badBlocks += torn;
+      offset++;
+    }
+  }
+}
+
+/**
+ * @brief Decodes the control messages of the frames whose opening delimiter lies in a range.
+ * @param input Telemetry stream.
+ * @param begin First byte of the range.
+ * @param end End of the range; the last frame may extend beyond it.
+ * @param stats Receives the frame counters.
+ * @param handler Called with the delimiter position and the message of every control frame.
+ */
+static void scanTelemetry(const Input &input, size_t begin, size_t end, TelemetryStats &stats,
+                          const std::function<void(size_t, const TelemetryControl &)> &handler) {
+  const uint8_t *data = input.file.data();
+  const uint8_t *stop = data + input.file.size();
+  size_t offset = 0;
+  TelemetryDecoder decoder([&](const TelemetryHeader &header, const uint8_t *message, size_t length) {
+    TelemetryControl control;
+    if (TelemetryDecoder::parse(header, message, length, TELEMETRY_CONTROL, control)) handler(offset, control);
+  });
+
+  const uint8_t *zero = nullptr;
+  if (begin < input.file.size()) zero = (const uint8_t *)memchr(data + begin, 0, stop - data - begin);
+  while (zero != nullptr && (size_t)(zero - data) < end) {
+    const uint8_t *next = (const uint8_t *)memchr(zero + 1, 0, stop - zero - 1);
+    if (next == nullptr) break;
+    offset = zero - data;
+    decoder.decodeFrame(zero + 1, next - zero - 1);
+    zero = next;
+  }
+
+  const TelemetryStats &counters = decoder.stats();
+  stats.frames += counters.frames;
+  stats.crcErrors += counters.crcErrors;
+  stats.malformed += counters.malformed;
+  stats.versionErrors += counters.versionErrors;
+}
+
+static void indexTelemetry(const Input &input, size_t begin, size_t end, ChunkIndex &index) {
+  Mark last = { 0, 0, false };
+  bool first = true;
+  scanTelemetry(input, begin, end, index.frames, [&](size_t offset, const TelemetryControl &control) {
+    bool running = control.flags & TELEMETRY_FLAG_RUNNING;
+    // A time step backwards is a reboot of the box, it ends the run
+    if (first || running != last.running || control.time < last.time) {
+      index.marks.push_back({ offset, control.time, running });
+    }
+    last = { offset, control.time, running };
+    first = false;
+  });
+  // The last frame carries the time on to the next chunk
+  if (!first && index.marks.back().offset != last.offset) index.marks.push_back(last);
+}
+
+static void joinRunLog(size_t inputIndex, std::vector<ChunkIndex> &chunks, std::vector<BlockRef> &blocks,
+                       std::vector<Span> &spans) {
+  for (ChunkIndex &chunk : chunks) {
+    blocks.insert(blocks.end(), chunk.blocks.begin(), chunk.blocks.end());
+    chunk.blocks = std::vector<BlockRef>();
+  }
+  for (size_t i = 0; i < blocks.size(); i++) {
+    if (i == 0 || blocks[i].runId != blocks[i - 1].runId) {
+      spans.push_back({ inputIndex, blocks[i].runId, i, i + 1 });
+    } else {
+      spans.back().end = i + 1;
+    }
+  }
+}
+
+static void joinTelemetry(size_t inputIndex, size_t size, const std::vector<ChunkIndex> &chunks,
+                          std::vector<Span> &spans) {
+  bool running = false;
+  bool started = false;
+  uint32_t lastTime = 0;
+  uint32_t run = 0;
+  size_t begin = 0;
+  for (const ChunkIndex &chunk : chunks) {
+    for (const Mark &mark : chunk.marks) {
+      bool reboot = started && mark.time < lastTime;
+      if (running && (!mark.running || reboot)) {
+        spans.push_back({ inputIndex, ++run, begin, mark.offset });
+        running = false;
+      }
+      if (mark.running && !running) {
+        begin = mark.offset;
+        running = true;
+      }
+      lastTime = mark.time;
+      started = true;
+    }
+  }
+  if (running) spans.push_back({ inputIndex, ++run, begin, size });
+}
+
+/**
+ * @brief Streams the samples of a run.
+ * @param input File of the run.
+ * @param span The run.
+ * @param blocks Blocks of the run log.
+ * @param visit Called for every sample in time order.
+ */
+template<typename Visit>
+static void forEachSample(const Input &input, const Span &span, const std::vector<BlockRef> &blocks, Visit &&visit) {
+  if (!input.runLog) {
+    TelemetryStats ignored;
+    scanTelemetry(input, span.begin, span.end, ignored, [&](size_t, const TelemetryControl &control) {
+      if (control.flags & TELEMETRY_FLAG_RUNNING) {
+        visit(Sample{ control.time, control.setpoint, control.temperature, control.humidity, control.duty,
+                      control.profile });
+      }
+    });
+    return;
+  }
+
+  for (size_t i = span.begin; i < span.end; i++) {
+    const uint8_t *block = input.file.data() + blocks[i].offset;
+    RunLogBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+    RunLogRecord record = { header.time, header.temperature, header.humidity, header.duty, header.mode };
+    const uint8_t *in = block + sizeof(header);
+    const uint8_t *end = in + header.length;
+    for (uint16_t n = 0; n < header.count; n++) {
+      if (n > 0 && !runLogDecodeRecord(in, end, record, record)) break;
+      visit(Sample{ record.time, INT32_MIN, record.temperature, record.humidity, record.duty, record.mode });
+    }
+  }
+}
+
+/**
+ * @brief Finds the material class of a setpoint.
+ * @param setpoint Setpoint in 0.01 °C.
+ * @param forced Preset index from `--material`, -1 to classify.
+ * @param label Receives the class name, presets of the same temperature joined by '/'.
+ * @param temperature Receives the preset temperature in 0.01 °C.
+ * @return false if no preset matches.
+ */
+static bool classify(int32_t setpoint, int forced, std::string &label, int32_t &temperature) {
+  if (forced >= 0) {
+    label = materialPresets[forced].name;
+    temperature = materialPresets[forced].temperature * _CENTI;
+    return true;
+  }
+  int32_t best = INT32_MAX;
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    best = std::min(best, std::abs(materialPresets[i].temperature * _CENTI - setpoint));
+  }
+  if (best > materialTolerance) {
+    label = "custom";
+    return false;
+  }
+  label.clear();
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    if (std::abs(materialPresets[i].temperature * _CENTI - setpoint) != best) continue;
+    if (!label.empty()) label += "/";
+    label += materialPresets[i].name;
+    temperature = materialPresets[i].temperature * _CENTI;
+  }
+  return true;
+}
+
+static RunResult analyzeRun(const Input &input, const Span &span, const std::vector<BlockRef> &blocks,
+                            const Options &options) {
+  RunResult result;
+
+  // Pass 1: extent, setpoint, humidity floor, ambient and steady state
+  uint32_t firstTime = 0, lastTime = 0;
+  int64_t holdSum = 0, holdDutySum = 0, ambientSum = 0;
+  size_t holdCount = 0, ambientCount = 0;
+  bool stepped = false;
+  int32_t humidityMin = INT32_MAX;
+  int32_t lastSetpoint = INT32_MIN;
+  forEachSample(input, span, blocks, [&](const Sample &sample) {
+    if (result.samples++ == 0) firstTime = sample.time;
+    lastTime = sample.time;
+    if (sample.mode == PROFILE_HOLD) {
+      holdSum += sample.temperature;
+      holdDutySum += sample.duty;
+      holdCount++;
+    }
+    // The first sample is taken before the heater acts, even if its duty is already set
+    stepped = stepped || (sample.duty > 0 && ambientCount > 0);
+    if (!stepped) {
+      ambientSum += sample.temperature;
+      ambientCount++;
+    }
+    humidityMin = std::min(humidityMin, sample.humidity);
+    lastSetpoint = sample.setpoint;
+  });
+  if (result.samples == 0) return result;
+  result.startS = firstTime / 1000.0;
+  result.durationS = (lastTime - firstTime) / 1000.0;
+  result.humidityMin = (double)humidityMin / _CENTI;
+  result.ambientC = (double)ambientSum / (int64_t)ambientCount / _CENTI;
+
+  // The hold phase of the run log lies within the hold band, its mean is the setpoint
+  int32_t setpoint = lastSetpoint;
+  if (input.runLog) setpoint = holdCount > 0 ? (int32_t)(holdSum / (int64_t)holdCount) : INT32_MIN;
+  int32_t presetTemperature = 0;
+  bool matched = (setpoint != INT32_MIN || input.material >= 0)
+                 && classify(setpoint, input.material, result.material, presetTemperature);
+  if (setpoint == INT32_MIN && input.material < 0) result.material = "unknown";
+  if (input.runLog && matched) setpoint = presetTemperature;
+  bool hasSetpoint = setpoint != INT32_MIN;
+  if (hasSetpoint) result.setpointC = (double)setpoint / _CENTI;
+
+  // Pass 2: KPIs, and model fits on the grid cell means of the values held between the samples
+  const uint32_t gapMs = (uint32_t)(options.gapSeconds * 1000);
+  const uint32_t stepMs = (uint32_t)std::lround(options.step * 1000);
+  PlantFit fit(options.step, (size_t)std::lround(options.maxDeadTime / options.step), result.ambientC);
+  std::vector<uint64_t> histogram(dutyBins, 0);
+  uint64_t totalMs = 0, saturatedMs = 0;
+  double dutySum = 0, energy = 0, squareSum = 0, squareMs = 0;
+  double start = 0, overshoot = 0;
+  double t10 = -1, t90 = -1, settled = 0;
+  bool outside = false;
+  uint32_t cellStart = firstTime;
+  double cellTemperature = 0, cellDuty = 0;
+  Sample previous = {};
+  size_t index = 0;
+  forEachSample(input, span, blocks, [&](const Sample &sample) {
+    int32_t target = input.runLog ? setpoint : sample.setpoint;
+    double t = (sample.time - firstTime) / 1000.0;
+    double error = (double)(sample.temperature - target) / _CENTI;
+
+    if (index > 0) {
+      uint32_t dt = sample.time - previous.time;
+      bool gap = dt > gapMs;
+      if (gap) dt = 0;
+
+      // Under closed loop the hold phase carries no excitation, it only fits the controller
+      if (gap || previous.mode == PROFILE_HOLD) {
+        fit.restart();
+        cellStart = sample.time;
+        cellTemperature = cellDuty = 0;
+      } else {
+        uint32_t from = previous.time;
+        while ((int32_t)(sample.time - (cellStart + stepMs)) >= 0) {
+          uint32_t part = cellStart + stepMs - from;
+          cellTemperature += (double)previous.temperature * part;
+          cellDuty += (double)previous.duty * part;
+          fit.add(cellTemperature / stepMs / _CENTI, cellDuty / stepMs / _CENTI);
+          cellTemperature = cellDuty = 0;
+          cellStart += stepMs;
+          from = cellStart;
+        }
+        cellTemperature += (double)previous.temperature * (sample.time - from);
+        cellDuty += (double)previous.duty * (sample.time - from);
+      }
+      size_t bin = std::min<size_t>(std::max(previous.duty, 0) / 10, dutyBins - 1);
+      histogram[bin] += dt;
+      totalMs += dt;
+      if (previous.duty >= saturatedDuty) saturatedMs += dt;
+      dutySum += (double)previous.duty * dt;
+      energy += (double)previous.duty / (100 * _CENTI) * options.heaterWatts * dt / 1000;
+      if (hasSetpoint && t >= result.durationS / 2) {
+        double previousError = (double)(previous.temperature - (input.runLog ? setpoint : previous.setpoint)) / _CENTI;
+        squareSum += previousError * previousError * dt;
+        squareMs += dt;
+      }
+    } else {
+      start = (double)sample.temperature / _CENTI;
+    }
+
+    if (hasSetpoint && target != INT32_MIN) {
+      double rise = (double)target / _CENTI - start;
+      double air = (double)sample.temperature / _CENTI;
+      if (t10 < 0 && air >= start + 0.1 * rise) t10 = t;
+      if (t90 < 0 && air >= start + 0.9 * rise) t90 = t;
+      overshoot = std::max(overshoot, error);
+      // Settling ends with the last sample outside the band
+      bool out = std::abs(sample.temperature - target) > _PROFILE_HOLD_BAND;
+      if (outside && !out) settled = t;
+      outside = out;
+    }
+    previous = sample;
+    index++;
+  });
+
+  if (hasSetpoint) {
+    result.riseS = (t10 >= 0 && t90 >= 0) ? t90 - t10 : -1;
+    result.overshootC = overshoot;
+    result.settlingS = outside ? -1 : settled;
+    result.rmsC = squareMs > 0 ? std::sqrt(squareSum / squareMs) : -1;
+  }
+  if (totalMs > 0) {
+    result.dutyMean = dutySum / totalMs / _CENTI;
+    result.dutySaturated = (double)saturatedMs / totalMs;
+    uint64_t below = 0;
+    for (size_t bin = 0; bin < dutyBins; bin++) {
+      below += histogram[bin];
+      if (below * 20 >= totalMs * 19) {
+        result.dutyP95 = bin * 0.1;
+        break;
+      }
+    }
+  }
+  result.energyWh = energy / 3600;
+  result.fopdt = fit.fitFopdt();
+  result.twoNode = fit.fitTwoNode();
+
+  // The hold phase is the steady state of the plant: its temperature rise over its duty
+  double holdDuty = holdCount > 0 ? (double)holdDutySum / (int64_t)holdCount / _CENTI : 0;
+  if (holdDuty > 0) {
+    result.steadyGain = ((double)holdSum / (int64_t)holdCount / _CENTI - result.ambientC) / holdDuty;
+    auto agrees = [&result](double gain) {
+      return gain > 0 && gain <= result.steadyGain * gainTolerance && gain * gainTolerance >= result.steadyGain;
+    };
+    result.fopdt.valid = result.fopdt.valid && agrees(result.fopdt.gain);
+    result.twoNode.valid = result.twoNode.valid && agrees(result.twoNode.gain);
+  }
+  return result;
+}
+
+/**
+ * @brief Recommended tuning of one material class.
+ */
+struct Recommendation {
+  std::string material;    ///< Material class.
+  size_t runs = 0;         ///< Runs of the class.
+  size_t fitted = 0;       ///< Runs with a valid FOPDT fit.
+  FopdtModel fopdt;        ///< Median FOPDT parameters.
+  TwoNodeModel twoNode;    ///< Median two-node parameters.
+  double kp = 0;           ///< Proportional gain in PWM counts per °C.
+  double ki = 0;           ///< Integral gain in PWM counts per °C and s.
+  double kd = 0;           ///< Derivative gain in PWM counts per °C/s.
+};
+
+static double median(std::vector<double> values) {
+  if (values.empty()) return 0;
+  std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+  return values[values.size() / 2];
+}
+
+static Recommendation recommend(const std::string &material, const std::vector<const RunResult *> &runs,
+                                const Options &options) {
+  Recommendation rec;
+  rec.material = material;
+  rec.runs = runs.size();
+  std::vector<double> gain, tau, theta, gain2, tau1, tau2, theta2;
+  for (const RunResult *run : runs) {
+    if (run->fopdt.valid) {
+      gain.push_back(run->fopdt.gain);
+      tau.push_back(run->fopdt.tau);
+      theta.push_back(run->fopdt.deadTime);
+    }
+    if (run->twoNode.valid) {
+      gain2.push_back(run->twoNode.gain);
+      tau1.push_back(run->twoNode.tau1);
+      tau2.push_back(run->twoNode.tau2);
+      theta2.push_back(run->twoNode.deadTime);
+    }
+  }
+  rec.fitted = gain.size();
+  rec.fopdt.valid = !gain.empty();
+  rec.fopdt.gain = median(gain);
+  rec.fopdt.tau = median(tau);
+  rec.fopdt.deadTime = median(theta);
+  rec.twoNode.valid = !gain2.empty();
+  rec.twoNode.gain = median(gain2);
+  rec.twoNode.tau1 = median(tau1);
+  rec.twoNode.tau2 = median(tau2);
+  rec.twoNode.deadTime = median(theta2);
+
+  if (!rec.fopdt.valid) {
+    return rec;
+  }
+  // SIMC PI with tau_c = theta; the grid cells add half a step of dead time
+  double delay = rec.fopdt.deadTime + options.step / 2;
+  double kc = rec.fopdt.tau / (rec.fopdt.gain * 2 * delay);
+  double tauI = std::min(rec.fopdt.tau, 8 * delay);
+  rec.kp = kc * _PWM_MAX_VALUE / 100;
+  rec.ki = rec.kp / tauI;
+  return rec;
+}
+
+static void writeRuns(FILE *out, const std::vector<std::unique_ptr<Input>> &inputs, const std::vector<Span> &spans,
+                      const std::vector<RunResult> &results) {
+  fprintf(out, "file,run,start_s,duration_s,samples,material,setpoint_c,rise_s,overshoot_c,settling_s,rms_c,"
+               "duty_mean,duty_p95,duty_sat,energy_wh,rh_min,ambient_c,steady_gain_c_per_pct,gain_c_per_pct,"
+               "tau_s,theta_s,fopdt_rmse_c,tau1_s,tau2_s,two_node_theta_s,two_node_rmse_c\n");
+  for (size_t i = 0; i < spans.size(); i++) {
+    const RunResult &r = results[i];
+    const FopdtModel &f = r.fopdt;
+    const TwoNodeModel &n = r.twoNode;
+    fprintf(out, "%s,%u,%.1f,%.1f,%zu,%s,%.2f,%.1f,%.3f,%.1f,%.3f,%.2f,%.1f,%.4f,%.2f,%.2f,%.2f,%.4f,",
+            inputs[spans[i].input]->path.c_str(), (unsigned)spans[i].run, r.startS, r.durationS, r.samples,
+            r.material.c_str(), r.setpointC, r.riseS, r.overshootC, r.settlingS, r.rmsC, r.dutyMean, r.dutyP95,
+            r.dutySaturated, r.energyWh, r.humidityMin, r.ambientC, r.steadyGain);
+    if (f.valid) {
+      fprintf(out, "%.4f,%.1f,%.1f,%.4f,", f.gain, f.tau, f.deadTime, f.rmse);
+    } else {
+      fprintf(out, ",,,,");
+    }
+    if (n.valid) {
+      fprintf(out, "%.1f,%.1f,%.1f,%.4f\n", n.tau1, n.tau2, n.deadTime, n.rmse);
+    } else {
+      fprintf(out, ",,,\n");
+    }
+  }
+}
+
+static void writeGains(FILE *out, const std::vector<Recommendation> &recommendations) {
+  fprintf(out, "material,runs,fitted,gain_c_per_pct,tau_s,theta_s,tau1_s,tau2_s,kp,ki,kd\n");
+  for (const Recommendation &rec : recommendations) {
+    if (!rec.fopdt.valid) {
+      fprintf(out, "%s,%zu,0,,,,,,,,\n", rec.material.c_str(), rec.runs);
+      continue;
+    }
+    fprintf(out, "%s,%zu,%zu,%.4f,%.1f,%.1f,", rec.material.c_str(), rec.runs, rec.fitted, rec.fopdt.gain,
+            rec.fopdt.tau, rec.fopdt.deadTime);
+    if (rec.twoNode.valid) {
+      fprintf(out, "%.1f,%.1f,", rec.twoNode.tau1, rec.twoNode.tau2);
+    } else {
+      fprintf(out, ",,");
+    }
+    fprintf(out, "%.4g,%.4g,%.4g\n", rec.kp, rec.ki, rec.kd);
+  }
+}
+
+static FILE *openOutput(const char *path) {
+  if (path == nullptr) return stdout;
+  FILE *out = fopen(path, "w");
+  if (out == nullptr) perror(path);
+  return out;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: hx_analyze [--threads n] [--step s] [--max-dead-time s] [--heater-watts w]\n"
+                  "                  [--runs file] [--gains file] [--material name|auto] file...\n");
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  std::vector<std::unique_ptr<Input>> inputs;
+  int material = -1;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+      options.threads = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--step") == 0 && hasValue) {
+      options.step = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--max-dead-time") == 0 && hasValue) {
+      options.maxDeadTime = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--heater-watts") == 0 && hasValue) {
+      options.heaterWatts = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--runs") == 0 && hasValue) {
+      options.runsPath = argv[++i];
+    } else if (strcmp(argv[i], "--gains") == 0 && hasValue) {
+      options.gainsPath = argv[++i];
+    } else if (strcmp(argv[i], "--material") == 0 && hasValue) {
+      // Applies to the files that follow
+      const char *name = argv[++i];
+      material = strcmp(name, "auto") == 0 ? -1 : findMaterialPreset(name);
+      if (material < 0 && strcmp(name, "auto") != 0) {
+        fprintf(stderr, "unknown material %s\n", name);
+        return 1;
+      }
+    } else if (argv[i][0] == '-') {
+      usage();
+      return 1;
+    } else {
+      inputs.emplace_back(new Input());
+      inputs.back()->path = argv[i];
+      inputs.back()->material = material;
+    }
+  }
+  if (inputs.empty() || options.step <= 0 || options.maxDeadTime < 0) {
+    usage();
+    return 1;
+  }
+
+  auto wallStart = std::chrono::steady_clock::now();
+  size_t totalBytes = 0;
+  for (std::unique_ptr<Input> &input : inputs) {
+    if (!input->file.open(input->path.c_str())) {
+      perror(input->path.c_str());
+      return 1;
+    }
+    uint32_t magic = 0;
+    if (input->file.size() >= sizeof(magic)) memcpy(&magic, input->file.data(), sizeof(magic));
+    input->runLog = magic == _RUNLOG_MAGIC;
+    totalBytes += input->file.size();
+  }
+
+  WorkStealingPool pool(options.threads);
+
+  // Stage 1: index every chunk of every file
+  std::vector<std::vector<ChunkIndex>> chunks(inputs.size());
+  for (size_t f = 0; f < inputs.size(); f++) {
+    const Input &input = *inputs[f];
+    size_t count = std::max<size_t>(1, (input.file.size() + options.chunkSize - 1) / options.chunkSize);
+    chunks[f].resize(count);
+    for (size_t c = 0; c < count; c++) {
+      size_t begin = c * options.chunkSize;
+      size_t end = std::min(input.file.size(), begin + options.chunkSize);
+      ChunkIndex &index = chunks[f][c];
+      pool.submit([&input, &index, begin, end] {
+        if (input.runLog) {
+          indexRunLog(input, begin, end, index);
+        } else {
+          indexTelemetry(input, begin, end, index);
+        }
+      });
+    }
+  }
+  pool.wait();
+
+  std::vector<std::vector<BlockRef>> blocks(inputs.size());
+  std::vector<Span> spans;
+  size_t blockCount = 0, badBlocks = 0;
+  TelemetryStats frames;
+  for (size_t f = 0; f < inputs.size(); f++) {
+    for (const ChunkIndex &chunk : chunks[f]) {
+      badBlocks += chunk.badBlocks;
+      frames.frames += chunk.frames.frames;
+      frames.crcErrors += chunk.frames.crcErrors;
+      frames.malformed += chunk.frames.malformed;
+    }
+    if (inputs[f]->runLog) {
+      joinRunLog(f, chunks[f], blocks[f], spans);
+      blockCount += blocks[f].size();
+    } else {
+      joinTelemetry(f, inputs[f]->file.size(), chunks[f], spans);
+    }
+  }
+  chunks.clear();
+
+  // Stage 2: one task per run
+  std::vector<RunResult> results(spans.size());
+  for (size_t i = 0; i < spans.size(); i++) {
+    pool.submit([&, i] {
+      results[i] = analyzeRun(*inputs[spans[i].input], spans[i], blocks[spans[i].input], options);
+    });
+  }
+  pool.wait();
+
+  std::map<std::string, std::vector<const RunResult *>> classes;
+  std::vector<const RunResult *> all;
+  for (const RunResult &result : results) {
+    if (result.samples == 0) continue;
+    classes[result.material].push_back(&result);
+    all.push_back(&result);
+  }
+  std::vector<Recommendation> recommendations;
+  for (const auto &entry : classes) recommendations.push_back(recommend(entry.first, entry.second, options));
+  recommendations.push_back(recommend("all", all, options));
+
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  fprintf(stderr, "%zu files, %.1f MB: %zu blocks (%zu torn), %llu frames (%llu bad), %zu runs\n", inputs.size(),
+          totalBytes / 1e6, blockCount, badBlocks, (unsigned long long)frames.frames,
+          (unsigned long long)(frames.crcErrors + frames.malformed), spans.size());
+  fprintf(stderr, "%.3f s on %zu threads: %.1f MB/s\n", wallSeconds, pool.size(), totalBytes / 1e6 / wallSeconds);
+
+  FILE *runsOut = openOutput(options.runsPath);
+  FILE *gainsOut = openOutput(options.gainsPath);
+  if (runsOut == nullptr || gainsOut == nullptr) {
+    return 1;
+  }
+  writeRuns(runsOut, inputs, spans, results);
+  if (runsOut == stdout && gainsOut == stdout) fprintf(stdout, "\n");
+  writeGains(gainsOut, recommendations);
+  if (runsOut != stdout) fclose(runsOut);
+  if (gainsOut != stdout) fclose(gainsOut);
+  return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file plant_fit.cpp
+ * @brief Implementation of the least-squares plant identification.
+ * @details Contains the accumulation of the moments, the Gaussian elimination and the
+ *          conversion of the discrete parameters into gains and time constants.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Series fitted above the anchored ambient temperature
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "plant_fit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+/** Fewer equations than this per parameter leave the fit undetermined. */
+static constexpr size_t minEquationsPerParameter = 10;
+
+PlantFit::PlantFit(double gridStep, size_t maxDelaySteps, double ambientTemperature)
+  : step(gridStep), maxDelay(maxDelaySteps), ambient(ambientTemperature), fopdt(maxDelaySteps + 1),
+    twoNode(maxDelaySteps + 1), temperatures(maxDelaySteps + 4, 0), duties(maxDelaySteps + 4, 0), head(0), filled(0) {}
+
+void PlantFit::restart() {
+  filled = 0;
+}
+
+void PlantFit::add(double temperature, double duty) {
+  temperature -= ambient;
+  size_t size = duties.size();
+  auto y = [&](size_t back) { return temperatures[(head + size - back) % size]; };
+  auto u = [&](size_t back) { return duties[(head + size - back) % size]; };
+
+  // A dead time gets its equations as soon as its history is complete
+  for (size_t d = 0; d <= maxDelay && d + 4 <= filled; d++) {
+    fopdt[d].add({ y(0), u(d) }, { y(1), u(d + 1) }, temperature);
+    twoNode[d].add({ y(0), y(1), u(d), u(d + 1) }, { y(2), y(3), u(d + 2), u(d + 3) }, temperature);
+  }
+
+  // The duty of this point acts from now on, the next equation sees it with dead time 0
+  head = (head + 1) % size;
+  temperatures[head] = temperature;
+  duties[head] = duty;
+  filled++;
+}
+
+template<size_t N>
+bool PlantFit::solve(const Moments<N> &moments, double (&theta)[N], double &sse) {
+  if (moments.count < N * minEquationsPerParameter) {
+    return false;
+  }
+  double a[N][N + 1];
+  for (size_t i = 0; i < N; i++) {
+    for (size_t j = 0; j < N; j++) a[i][j] = moments.zx[i][j];
+    a[i][N] = moments.zy[i];
+  }
+
+  // Gaussian elimination with partial pivoting
+  for (size_t col = 0; col < N; col++) {
+    size_t pivot = col;
+    for (size_t row = col + 1; row < N; row++) {
+      if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) pivot = row;
+    }
+    if (std::fabs(a[pivot][col]) <= 1e-12 * std::fabs(moments.zx[col][col])) {
+      return false;  // A regressor never varied, e.g. constant duty
+    }
+    if (pivot != col) std::swap(a[pivot], a[col]);
+    for (size_t row = col + 1; row < N; row++) {
+      double factor = a[row][col] / a[col][col];
+      for (size_t j = col; j <= N; j++) a[row][j] -= factor * a[col][j];
+    }
+  }
+  for (size_t i = N; i-- > 0;) {
+    double sum = a[i][N];
+    for (size_t j = i + 1; j < N; j++) sum -= a[i][j] * theta[j];
+    theta[i] = sum / a[i][i];
+  }
+
+  // Residual y'y - 2 theta'X'y + theta'X'X theta
+  sse = moments.yy;
+  for (size_t i = 0; i < N; i++) {
+    sse -= 2 * theta[i] * moments.xy[i];
+    for (size_t j = 0; j < N; j++) sse += theta[i] * moments.xx[i][j] * theta[j];
+  }
+  sse = std::max(sse, 0.0);
+  return true;
+}
+
+FopdtModel PlantFit::fitFopdt() const {
+  FopdtModel best;
+  double bestMse = INFINITY;
+  for (size_t d = 0; d <= maxDelay; d++) {
+    double theta[firstOrder], sse;
+    if (!solve(fopdt[d], theta, sse) || sse / fopdt[d].count >= bestMse) continue;
+    double a = theta[0], b = theta[1];
+    if (!(a > 0 && a < 1 && b > 0)) continue;
+    bestMse = sse / fopdt[d].count;
+    best.valid = true;
+    best.gain = b / (1 - a);
+    best.tau = -step / std::log(a);
+    best.deadTime = d * step;
+    best.ambient = ambient;
+    best.rmse = std::sqrt(sse / fopdt[d].count);
+    best.samples = fopdt[d].count;
+  }
+  return best;
+}
+
+TwoNodeModel PlantFit::fitTwoNode() const {
+  TwoNodeModel best;
+  double bestMse = INFINITY;
+  for (size_t d = 0; d <= maxDelay; d++) {
+    double theta[secondOrder], sse;
+    if (!solve(twoNode[d], theta, sse) || sse / twoNode[d].count >= bestMse) continue;
+    double a1 = theta[0], a2 = theta[1], b = theta[2] + theta[3];
+
+    // Poles are the roots of z^2 - a1 z - a2, both must be real and inside (0, 1)
+    double discriminant = a1 * a1 + 4 * a2;
+    if (discriminant < 0 || 1 - a1 - a2 <= 0 || b <= 0) continue;
+    double slow = (a1 + std::sqrt(discriminant)) / 2;
+    double fast = (a1 - std::sqrt(discriminant)) / 2;
+    if (!(slow < 1 && fast > 0)) continue;
+    bestMse = sse / twoNode[d].count;
+    best.valid = true;
+    best.gain = b / (1 - a1 - a2);
+    best.tau1 = -step / std::log(slow);
+    best.tau2 = -step / std::log(fast);
+    best.deadTime = d * step;
+    best.rmse = std::sqrt(sse / twoNode[d].count);
+    best.samples = twoNode[d].count;
+  }
+  return best;
+}
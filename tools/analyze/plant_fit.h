@@ -0,0 +1,163 @@
+/**
+ * @file plant_fit.h
+ * @brief Least-squares identification of the dryer from logged runs.
+ * @details Fits two discrete models to a temperature and heater duty series on a uniform grid,
+ *          `y` being the temperature above the ambient temperature `T0`:
+ *          - first order plus dead time (FOPDT): `y[k+1] = a y[k] + b u[k-d]`
+ *          - two nodes, heater and chamber air: `y[k+1] = a1 y[k] + a2 y[k-1] + b1 u[k-d] + b2 u[k-d-1]`
+ *
+ *          The data comes from closed-loop runs: the sensor noise enters the regressors and, through
+ *          the controller, the duty. Plain least squares is biased by both and underestimates the
+ *          time constant. The equations are therefore solved with instrumental variables, the
+ *          regressors delayed by the model order, which do not correlate with the white noise of
+ *          the equation they belong to.
+ *
+ *          The moments of every dead time `d` up to the limit are accumulated sample by sample,
+ *          so a run of any length is fitted in constant memory and in one pass. The dead time
+ *          with the smallest mean residual wins. `T0` is given, not fitted: on closed-loop data the
+ *          duty stays close to its steady state, and a free offset trades off against the gain
+ *          until the gain is off by an order of magnitude. The caller anchors `T0` to the samples
+ *          before the heater step.
+ *
+ * ### Example Usage
+ * ```cpp
+ * PlantFit fit(5.0, 60, 21.5);
+ * for (const GridPoint &point : grid) fit.add(point.temperature, point.duty);
+ * FopdtModel model = fit.fitFopdt();
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Ambient temperature anchored by the caller instead of fitted
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef PLANT_FIT_H
+#define PLANT_FIT_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief First order plus dead time model.
+ */
+struct FopdtModel {
+  bool valid = false;   ///< False if the data does not identify a stable first order plant.
+  double gain = 0;      ///< Static gain in °C per % duty.
+  double tau = 0;       ///< Time constant in s.
+  double deadTime = 0;  ///< Dead time in s.
+  double ambient = 0;   ///< Temperature at zero duty in °C, as anchored by the caller.
+  double rmse = 0;      ///< One-step prediction error in °C.
+  size_t samples = 0;   ///< Grid points of the fit.
+};
+
+/**
+ * @brief Two-node model: two real time constants in series plus dead time.
+ */
+struct TwoNodeModel {
+  bool valid = false;   ///< False if the poles are not real and stable.
+  double gain = 0;      ///< Static gain in °C per % duty.
+  double tau1 = 0;      ///< Slow time constant in s, the chamber.
+  double tau2 = 0;      ///< Fast time constant in s, the heater.
+  double deadTime = 0;  ///< Dead time in s.
+  double rmse = 0;      ///< One-step prediction error in °C.
+  size_t samples = 0;   ///< Grid points of the fit.
+};
+
+/**
+ * @brief Streaming least-squares fit of both models over a range of dead times.
+ */
+class PlantFit {
+private:
+  static constexpr size_t firstOrder = 2;  /**< Parameters of the FOPDT model. */
+  static constexpr size_t secondOrder = 4; /**< Parameters of the two-node model. */
+
+  /**
+   * @brief Moments of the equations of one model and dead time.
+   */
+  template<size_t N>
+  struct Moments {
+    double zx[N][N] = {};  ///< Sum of the instrument and regressor outer products.
+    double zy[N] = {};     ///< Sum of the instruments times the target.
+    double xx[N][N] = {};  ///< Sum of the regressor outer products, for the residual.
+    double xy[N] = {};     ///< Sum of the regressors times the target, for the residual.
+    double yy = 0;         ///< Sum of the squared targets.
+    size_t count = 0;      ///< Number of equations.
+
+    /**
+     * @brief Adds one equation.
+     * @param x Regressors.
+     * @param z Instruments.
+     * @param y Target.
+     */
+    void add(const double (&x)[N], const double (&z)[N], double y) {
+      for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+          zx[i][j] += z[i] * x[j];
+          xx[i][j] += x[i] * x[j];
+        }
+        zy[i] += z[i] * y;
+        xy[i] += x[i] * y;
+      }
+      yy += y * y;
+      count++;
+    }
+  };
+
+  double step;                              /**< Grid step in s. */
+  size_t maxDelay;                          /**< Longest dead time in grid steps. */
+  double ambient;                           /**< Ambient temperature in °C, the zero of the series. */
+  std::vector<Moments<firstOrder>> fopdt;    /**< FOPDT moments per dead time. */
+  std::vector<Moments<secondOrder>> twoNode; /**< Two-node moments per dead time. */
+  std::vector<double> temperatures;          /**< Ring buffer of the past temperatures. */
+  std::vector<double> duties;                /**< Ring buffer of the past duties. */
+  size_t head;                               /**< Index of the newest grid point. */
+  size_t filled;                             /**< Valid grid points since the last restart. */
+
+  template<size_t N>
+  static bool solve(const Moments<N> &moments, double (&theta)[N], double &sse);
+
+public:
+  /**
+   * @brief Constructor: Initializes an empty fit.
+   * @param gridStep Spacing of the grid points in s.
+   * @param maxDelaySteps Longest dead time to try, in grid steps.
+   * @param ambientTemperature Temperature at zero duty in °C, e.g. before the heater step.
+   */
+  PlantFit(double gridStep, size_t maxDelaySteps, double ambientTemperature);
+
+  /**
+   * @brief Adds the next grid point.
+   * @param temperature Chamber temperature in °C.
+   * @param duty Heater duty in %, held since the previous grid point.
+   */
+  void add(double temperature, double duty);
+
+  /**
+   * @brief Starts a new series, e.g. after a gap in the log; the equations are kept.
+   */
+  void restart();
+
+  /**
+   * @brief Solves the FOPDT model for the best dead time.
+   * @return The model, `valid` is false if there were too few points or the plant is unstable.
+   */
+  FopdtModel fitFopdt() const;
+
+  /**
+   * @brief Solves the two-node model for the best dead time.
+   * @return The model, `valid` is false if there were too few points or the poles are not real.
+   */
+  TwoNodeModel fitTwoNode() const;
+};
+
+
+#endif  // PLANT_FIT_H
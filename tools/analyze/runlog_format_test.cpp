@@ -0,0 +1,100 @@
+/**
+ * @file runlog_format_test.cpp
+ * @brief Host test of the record encoding of the run log.
+ * @details Encodes records with `runLogEncodeRecord()` as `RunLogger` does and decodes them with
+ *          `runLogDecodeRecord()` as `hx_analyze` does. The test covers the varint time deltas,
+ *          the zigzag differences at the limits of their fields, mode changes, truncated input
+ *          and the CRC against its reference value.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "../test/check.h"
+#include "runlog_format_hx.h"
+
+static bool sameRecord(const RunLogRecord &a, const RunLogRecord &b) {
+  return a.time == b.time && a.temperature == b.temperature && a.humidity == b.humidity && a.duty == b.duty
+         && a.mode == b.mode;
+}
+
+static void testCrc() {
+  const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  HX_CHECK(runLogCrc32(check, sizeof(check)) == 0xCBF43926);  // CRC-32 check value
+  HX_CHECK(runLogCrc32(check + 3, 6, runLogCrc32(check, 3)) == 0xCBF43926);
+}
+
+static void testRoundTrip() {
+  // Small steps, mode changes, field limits and long gaps between records
+  const RunLogRecord records[] = {
+    { 1000, 2150, 4000, 0, 0 },
+    { 1150, 2151, 3999, 120, 0 },
+    { 1300, 2149, 4001, 10000, 1 },
+    { 1300, 2149, 4001, 10000, 1 },
+    { 1450, INT16_MAX, 0, 0, 1 },
+    { 1600, INT16_MIN, INT16_MAX, UINT16_MAX, 2 },
+    { 1750, INT16_MAX, INT16_MIN, 0, 0 },
+    { 3600000, -4000, 100, 5000, 0 },
+    { 3600000u + 0x7FFFFFFFu, 0, 0, 0, 255 },  // Largest gap the 31 bits of the time delta hold
+  };
+  const size_t count = sizeof(records) / sizeof(records[0]);
+
+  std::vector<uint8_t> payload;
+  for (size_t i = 1; i < count; i++) {
+    uint8_t out[_RUNLOG_RECORD_MAX + 8];
+    size_t size = runLogEncodeRecord(out, records[i], records[i - 1]);
+    HX_CHECK(size > 0 && size <= _RUNLOG_RECORD_MAX);
+    payload.insert(payload.end(), out, out + size);
+  }
+
+  // The first record comes from the block header, every further one from its predecessor
+  const uint8_t *in = payload.data();
+  const uint8_t *end = in + payload.size();
+  RunLogRecord previous = records[0];
+  for (size_t i = 1; i < count; i++) {
+    RunLogRecord record;
+    HX_CHECK(runLogDecodeRecord(in, end, record, previous));
+    HX_CHECK(sameRecord(record, records[i]));
+    previous = record;
+  }
+  HX_CHECK(in == end);
+}
+
+static void testTruncated() {
+  const RunLogRecord previous = { 1000, 2150, 4000, 0, 0 };
+  const RunLogRecord record = { 200000, -3000, 9000, 10000, 3 };
+  uint8_t out[_RUNLOG_RECORD_MAX];
+  size_t size = runLogEncodeRecord(out, record, previous);
+
+  // Every cut inside the record is detected
+  for (size_t cut = 0; cut < size; cut++) {
+    const uint8_t *in = out;
+    RunLogRecord decoded;
+    HX_CHECK(!runLogDecodeRecord(in, out + cut, decoded, previous));
+  }
+
+  // A varint without an end within five bytes is malformed
+  const uint8_t endless[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+  const uint8_t *in = endless;
+  RunLogRecord decoded;
+  HX_CHECK(!runLogDecodeRecord(in, endless + sizeof(endless), decoded, previous));
+}
+
+int main() {
+  testCrc();
+  testRoundTrip();
+  testTruncated();
+  return checkResult("runlog_format_test");
+}
@@ -0,0 +1,148 @@
+/**
+ * @file bench.h
+ * @brief Minimal microbenchmark harness for the host tools.
+ * @details Runs an operation in batches and reports nanoseconds and, on x86, TSC cycles per
+ *          operation. A warm-up phase estimates the cost of one operation and sizes the batches
+ *          to `batchMs`; every repetition times one batch. Median, minimum, mean and standard
+ *          deviation over the repetitions are reported, the median is the value to compare.
+ *
+ * ### Example Usage
+ * ```cpp
+ * BenchOptions options;
+ * BenchResult result = benchRun("map_float", options, [&](uint64_t i) {
+ *   benchKeep(mapFloat(i & 1023, 0, 1023, 0, 100));
+ * });
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLES 1
+#else
+#define BENCH_HAS_CYCLES 0
+#endif
+
+/**
+ * @brief Settings of a benchmark run.
+ */
+struct BenchOptions {
+  double warmupMs = 50;  ///< Duration of the warm-up in milliseconds.
+  double batchMs = 10;   ///< Target duration of one timed batch in milliseconds.
+  int repetitions = 21;  ///< Number of timed batches.
+};
+
+/**
+ * @brief Statistics of one benchmark.
+ */
+struct BenchResult {
+  std::string name;     ///< Benchmark name.
+  uint64_t iterations;  ///< Operations per batch.
+  int repetitions;      ///< Number of batches.
+  double nsMedian;      ///< Median nanoseconds per operation.
+  double nsMin;         ///< Fastest batch in nanoseconds per operation.
+  double nsMean;        ///< Mean nanoseconds per operation.
+  double nsStddev;      ///< Standard deviation in nanoseconds per operation.
+  double cyclesMedian;  ///< Median TSC cycles per operation, 0 without a cycle counter.
+};
+
+/**
+ * @brief Keeps the compiler from removing a computation whose result is unused.
+ * @param value Result to keep.
+ */
+template<typename T>
+inline void benchKeep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline uint64_t benchCycles() {
+#if BENCH_HAS_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Runs a benchmark.
+ * @param name Benchmark name.
+ * @param options Settings.
+ * @param operation Called with the running operation index, once per operation.
+ * @return Statistics.
+ */
+template<typename Operation>
+BenchResult benchRun(const char *name, const BenchOptions &options, Operation &&operation) {
+  using Clock = std::chrono::steady_clock;
+
+  // Warm-up: caches, branch predictors and the frequency governor settle, the cost is estimated
+  uint64_t index = 0;
+  uint64_t batch = 1;
+  Clock::time_point start = Clock::now();
+  double elapsedNs = 0;
+  while (elapsedNs < options.warmupMs * 1e6) {
+    for (uint64_t i = 0; i < batch; i++) operation(index++);
+    elapsedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    batch *= 2;
+  }
+  double nsPerOperation = elapsedNs / (double)index;
+  uint64_t iterations = std::max<uint64_t>(1, (uint64_t)(options.batchMs * 1e6 / nsPerOperation));
+
+  std::vector<double> ns;
+  std::vector<double> cycles;
+  for (int r = 0; r < options.repetitions; r++) {
+    uint64_t cycleStart = benchCycles();
+    Clock::time_point batchStart = Clock::now();
+    for (uint64_t i = 0; i < iterations; i++) operation(index++);
+    Clock::time_point batchEnd = Clock::now();
+    uint64_t cycleEnd = benchCycles();
+    ns.push_back(std::chrono::duration<double, std::nano>(batchEnd - batchStart).count() / iterations);
+    cycles.push_back((double)(cycleEnd - cycleStart) / iterations);
+  }
+
+  auto median = [](std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return (n % 2) ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+  };
+  double mean = 0;
+  for (double value : ns) mean += value;
+  mean /= ns.size();
+  double variance = 0;
+  for (double value : ns) variance += (value - mean) * (value - mean);
+  variance /= ns.size() > 1 ? ns.size() - 1 : 1;
+
+  BenchResult result;
+  result.name = name;
+  result.iterations = iterations;
+  result.repetitions = options.repetitions;
+  result.nsMedian = median(ns);
+  result.nsMin = *std::min_element(ns.begin(), ns.end());
+  result.nsMean = mean;
+  result.nsStddev = std::sqrt(variance);
+  result.cyclesMedian = BENCH_HAS_CYCLES ? median(cycles) : 0;
+  return result;
+}
+
+
+#endif  // BENCH_H
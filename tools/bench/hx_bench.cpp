@@ -0,0 +1,245 @@
+/**
+ * @file hx_bench.cpp
+ * @brief Microbenchmarks of the firmware hot paths on the host.
+ * @details Builds the firmware sources against the host HAL in `tools/hal` and times the code
+ *          that runs in every control cycle. The results are written as JSON, one benchmark per
+ *          line, together with the git revision. With `--compare` the medians are checked
+ *          against a previous result file and the exit code is 2 if one got slower than the
+ *          threshold allows. An unreadable baseline file or one without results ends the check
+ *          with exit code 1.
+ *
+ *          Host timings do not equal ESP32 timings, but relative changes between two commits
+ *          measured on the same machine show hot path regressions before the firmware is
+ *          flashed.
+ *
+ * ### Example Usage
+ * ```sh
+ * hx_bench --json baseline.json
+ * # ... change the code, rebuild ...
+ * hx_bench --compare baseline.json --threshold 10
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Telemetry benchmark of `Telemetry::encode()`, unreadable baselines fail the comparison
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+#include "LiquidCrystal_AIP31068_I2C.h"
+#include "globals_hx.h"
+#include "gpio_hx.h"
+#include "pid_hx.h"
+#include "sensor_hx.h"
+#include "telemetry_hx.h"
+
+#ifndef HX_REVISION
+#define HX_REVISION "unknown"
+#endif
+
+/**
+ * @brief BME280 with the datasheet calibration and a fixed raw sample.
+ */
+class BenchBME280 : public CustomBME280 {
+public:
+  BenchBME280() {
+    begin(0x76);
+    setRaw(519888, 27000);
+  }
+};
+
+static std::vector<BenchResult> runAll(const BenchOptions &options, const char *filter) {
+  std::vector<BenchResult> results;
+  auto selected = [filter](const char *name) {
+    return filter == nullptr || strstr(name, filter) != nullptr;
+  };
+
+  if (selected("pid_compute")) {
+    PID_heatX pid(_PID_TEMP_KP_PRESET, _PID_TEMP_KI_PRESET, _PID_TEMP_KD_PRESET, 0);
+    pid.SetSampleTime(150);
+    pid.SetOutputLimits(0, _PWM_MAX_VALUE);
+    pid.SetSetpoint(60.0f);
+    pid.SetMode(1);
+    results.push_back(benchRun("pid_compute", options, [&](uint64_t i) {
+      hal::advanceMicros(150000);  // Every call is due
+      pid.SetInput(40.0f + (float)(i & 255) * 0.1f, 0.05f);
+      benchKeep(pid.Compute());
+    }));
+  }
+
+  if (selected("map_float")) {
+    results.push_back(benchRun("map_float", options, [&](uint64_t i) {
+      benchKeep(mapFloat((float)(i & 4095), 0.0f, 4095.0f, _TEMP_MIN, _TEMP_MAX));
+    }));
+  }
+
+  if (selected("bme280_read_fixed")) {
+    BenchBME280 sensor;
+    results.push_back(benchRun("bme280_read_fixed", options, [&](uint64_t i) {
+      int32_t temperature;
+      int32_t humidity;
+      sensor.setRaw(519888 + (int32_t)(i & 1023), 27000 + (int32_t)(i & 511));
+      benchKeep(sensor.readFixed(temperature, humidity));
+      benchKeep(temperature);
+      benchKeep(humidity);
+    }));
+  }
+
+  if (selected("lcd_print_value")) {
+    LiquidCrystal_AIP31068_I2C lcd(_LCD_ADDRESS, _LCD_COLS, _LCD_ROWS);
+    results.push_back(benchRun("lcd_print_value", options, [&](uint64_t i) {
+      lcd.setCursor(1, 0);
+      lcd.printf("%3d", (int)(i % 200));
+    }));
+  }
+
+  if (selected("button_update")) {
+    ButtonActiveLow button(_PIN_START, 50);
+    results.push_back(benchRun("button_update", options, [&](uint64_t i) {
+      hal::setPin(_PIN_START, (i >> 6) & 1);
+      hal::advanceMicros(1000);
+      button.update();
+      benchKeep(button.isPressed());
+    }));
+  }
+
+  if (selected("gpio_off_delay_update")) {
+    GpioOffDelay output(_PIN_FAN, 3000);
+    results.push_back(benchRun("gpio_off_delay_update", options, [&](uint64_t i) {
+      output.control((i >> 12) & 1);
+      hal::advanceMicros(1000);
+      output.update();
+      benchKeep(output.isOn());
+    }));
+  }
+
+  if (selected("telemetry_encode")) {
+    results.push_back(benchRun("telemetry_encode", options, [&](uint64_t i) {
+      TelemetryControl message = { (uint32_t)i, 6000, (int16_t)(5000 + (i & 1023)), 12, 2500, 4200,
+                                   TELEMETRY_FLAG_RUNNING, 0 };
+      TelemetryFrame frame;
+      benchKeep(Telemetry::encode(frame, TELEMETRY_CONTROL, (uint16_t)i, &message, sizeof(message)));
+      benchKeep(frame);
+    }));
+  }
+  return results;
+}
+
+static void writeJson(FILE *out, const std::vector<BenchResult> &results) {
+  fprintf(out, "{\"revision\":\"%s\",\"cycles\":%s,\"benchmarks\":[\n", HX_REVISION,
+          BENCH_HAS_CYCLES ? "\"tsc\"" : "null");
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult &r = results[i];
+    fprintf(out, "{\"name\":\"%s\",\"iterations\":%llu,\"repetitions\":%d,\"ns_median\":%.3f,"
+                 "\"ns_min\":%.3f,\"ns_mean\":%.3f,\"ns_stddev\":%.3f,\"cycles_median\":%.1f}%s\n",
+            r.name.c_str(), (unsigned long long)r.iterations, r.repetitions, r.nsMedian, r.nsMin,
+            r.nsMean, r.nsStddev, r.cyclesMedian, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "]}\n");
+}
+
+// Reads the medians of a file written by writeJson(), one benchmark per line; false if unreadable
+static bool readMedians(const char *path, std::map<std::string, double> &medians) {
+  FILE *in = fopen(path, "r");
+  if (in == nullptr) {
+    perror(path);
+    return false;
+  }
+  char line[512];
+  while (fgets(line, sizeof(line), in) != nullptr) {
+    char name[64];
+    const char *median = strstr(line, "\"ns_median\":");
+    if (sscanf(line, "{\"name\":\"%63[^\"]\"", name) == 1 && median != nullptr) {
+      medians[name] = atof(median + strlen("\"ns_median\":"));
+    }
+  }
+  fclose(in);
+  if (medians.empty()) {
+    fprintf(stderr, "%s: no results\n", path);
+    return false;
+  }
+  return true;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: hx_bench [--filter text] [--repetitions n] [--batch-ms ms] [--json file]\n"
+                  "                [--compare baseline.json] [--threshold percent]\n");
+}
+
+int main(int argc, char **argv) {
+  BenchOptions options;
+  const char *filter = nullptr;
+  const char *jsonPath = nullptr;
+  const char *baselinePath = nullptr;
+  double threshold = 10;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--repetitions") == 0 && hasValue) {
+      options.repetitions = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--batch-ms") == 0 && hasValue) {
+      options.batchMs = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--json") == 0 && hasValue) {
+      jsonPath = argv[++i];
+    } else if (strcmp(argv[i], "--compare") == 0 && hasValue) {
+      baselinePath = argv[++i];
+    } else if (strcmp(argv[i], "--threshold") == 0 && hasValue) {
+      threshold = atof(argv[++i]);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+
+  std::vector<BenchResult> results = runAll(options, filter);
+
+  writeJson(stdout, results);
+  if (jsonPath != nullptr) {
+    FILE *out = fopen(jsonPath, "w");
+    if (out == nullptr) {
+      perror(jsonPath);
+      return 1;
+    }
+    writeJson(out, results);
+    fclose(out);
+  }
+
+  if (baselinePath == nullptr) {
+    return 0;
+  }
+  std::map<std::string, double> baseline;
+  if (!readMedians(baselinePath, baseline)) {
+    return 1;
+  }
+  int regressions = 0;
+  for (const BenchResult &r : results) {
+    auto entry = baseline.find(r.name);
+    if (entry == baseline.end() || entry->second <= 0) {
+      fprintf(stderr, "%-24s %10.2f ns  (no baseline)\n", r.name.c_str(), r.nsMedian);
+      continue;
+    }
+    double change = (r.nsMedian / entry->second - 1) * 100;
+    bool regressed = change > threshold;
+    regressions += regressed;
+    fprintf(stderr, "%-24s %10.2f ns  %10.2f ns  %+7.1f %%%s\n", r.name.c_str(), entry->second,
+            r.nsMedian, change, regressed ? "  REGRESSION" : "");
+  }
+  return regressions > 0 ? 2 : 0;
+}
@@ -0,0 +1,260 @@
+/**
+ * @file hx_footprint.cpp
+ * @brief Command line tool that attributes the memory use of a firmware build to its sources.
+ * @details Parses the GNU linker map written by the ESP32 Arduino build and sums the input
+ *          sections of every object file by the output section they end up in:
+ *          - `iram`: `.iram0.*`, code and data in internal instruction RAM
+ *          - `data`: `.dram0.data`, initialized variables in internal RAM
+ *          - `bss`: `.dram0.bss` and `.noinit`, zeroed variables in internal RAM
+ *          - `rodata`: `.flash.rodata`, constants in flash
+ *          - `text`: `.flash.text`, code in flash
+ *          - `psram`: `.ext_ram.bss`, variables in PSRAM
+ *
+ *          The rows are sorted by internal RAM (`iram + data + bss`), then by flash.
+ *
+ * ### Example Usage
+ * ```sh
+ * arduino-cli compile --build-path build .
+ * hx_footprint build/heatX.ino.map            # top 40 object files
+ * hx_footprint -a build/heatX.ino.map         # summed per library archive
+ * hx_footprint -c -n 0 build/heatX.ino.map    # all object files as CSV
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Memory regions of the report.
+ */
+enum Region {
+  REGION_IRAM,
+  REGION_DATA,
+  REGION_BSS,
+  REGION_RODATA,
+  REGION_TEXT,
+  REGION_PSRAM,
+  REGION_COUNT,
+  REGION_NONE = REGION_COUNT
+};
+
+static const char *const regionNames[REGION_COUNT] = { "iram", "data", "bss", "rodata", "text", "psram" };
+
+/**
+ * @brief Bytes of one object file or archive per region.
+ */
+struct Footprint {
+  std::string name;                        ///< Object file or archive.
+  unsigned long long bytes[REGION_COUNT];  ///< Bytes per region.
+
+  unsigned long long ram() const {
+    return bytes[REGION_IRAM] + bytes[REGION_DATA] + bytes[REGION_BSS];
+  }
+
+  unsigned long long flash() const {
+    return bytes[REGION_RODATA] + bytes[REGION_TEXT];
+  }
+};
+
+static bool startsWith(const std::string &text, const char *prefix) {
+  return text.compare(0, strlen(prefix), prefix) == 0;
+}
+
+static bool isHex(const std::string &token) {
+  return startsWith(token, "0x");
+}
+
+static Region classify(const std::string &section) {
+  if (startsWith(section, ".iram0")) return REGION_IRAM;
+  if (startsWith(section, ".dram0.data")) return REGION_DATA;
+  if (startsWith(section, ".dram0.bss") || startsWith(section, ".noinit")) return REGION_BSS;
+  if (startsWith(section, ".flash.rodata")) return REGION_RODATA;
+  if (startsWith(section, ".flash.text")) return REGION_TEXT;
+  if (startsWith(section, ".ext_ram.bss")) return REGION_PSRAM;
+  return REGION_NONE;
+}
+
+// "/build/libfoo.a(bar.c.obj)" -> "libfoo.a(bar.c.obj)" or "libfoo.a", "/build/sketch/src/x.cpp.o" -> "x.cpp"
+static std::string sourceName(const std::string &path, bool archives) {
+  size_t paren = path.find('(');
+  size_t slash = path.rfind('/', paren == std::string::npos ? std::string::npos : paren);
+  std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+  if (archives) {
+    paren = name.find('(');
+    return (paren == std::string::npos) ? "(sketch)" : name.substr(0, paren);
+  }
+  if (name.size() > 2 && name.compare(name.size() - 2, 2, ".o") == 0 && name.find('(') == std::string::npos) {
+    name.resize(name.size() - 2);
+  }
+  return name;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: hx_footprint [-a] [-c] [-n rows] <firmware.map>\n"
+                  "  -a  sum per library archive instead of per object file\n"
+                  "  -c  print CSV\n"
+                  "  -n  number of rows, 0 for all (default 40)\n");
+}
+
+int main(int argc, char **argv) {
+  bool archives = false;
+  bool csv = false;
+  size_t rows = 40;
+  const char *path = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-a") == 0) {
+      archives = true;
+    } else if (strcmp(argv[i], "-c") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      rows = strtoul(argv[++i], nullptr, 10);
+    } else if (argv[i][0] != '-' && path == nullptr) {
+      path = argv[i];
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (path == nullptr) {
+    usage();
+    return 1;
+  }
+
+  std::ifstream input(path);
+  if (!input) {
+    perror(path);
+    return 1;
+  }
+
+  std::map<std::string, Footprint> footprints;
+  Region region = REGION_NONE;
+  bool inMap = false;
+  bool pending = false;  // Input section name on its own line, address and size follow
+  std::string line;
+  while (std::getline(input, line)) {
+    if (!inMap) {
+      inMap = startsWith(line, "Linker script and memory map");
+      continue;
+    }
+    if (line.empty()) {
+      continue;
+    }
+
+    std::istringstream stream(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (stream >> token) {
+      tokens.push_back(token);
+    }
+    if (tokens.empty()) {
+      continue;
+    }
+
+    // Output sections start in the first column
+    if (line[0] != ' ') {
+      region = (line[0] == '.') ? classify(tokens[0]) : REGION_NONE;
+      pending = false;
+      continue;
+    }
+
+    size_t sizeToken;
+    if (isHex(tokens[0])) {
+      // Continuation of a long input section name, or a symbol line without size
+      if (!pending || tokens.size() < 3 || !isHex(tokens[1])) {
+        continue;
+      }
+      sizeToken = 1;
+    } else if (tokens[0][0] == '.' || tokens[0] == "COMMON") {
+      if (tokens.size() == 1) {
+        pending = true;
+        continue;
+      }
+      if (tokens.size() < 4 || !isHex(tokens[1]) || !isHex(tokens[2])) {
+        pending = false;
+        continue;
+      }
+      sizeToken = 2;
+    } else {
+      pending = false;  // Patterns like *(.text) and *fill*
+      continue;
+    }
+    pending = false;
+
+    unsigned long long size = strtoull(tokens[sizeToken].c_str(), nullptr, 16);
+    if (region == REGION_NONE || size == 0) {
+      continue;
+    }
+    std::string file = tokens[sizeToken + 1];
+    for (size_t i = sizeToken + 2; i < tokens.size(); i++) {
+      file += " " + tokens[i];  // Paths with spaces
+    }
+    std::string name = sourceName(file, archives);
+    Footprint &footprint = footprints[name];
+    footprint.name = name;
+    footprint.bytes[region] += size;
+  }
+
+  if (!inMap) {
+    fprintf(stderr, "%s: no memory map found\n", path);
+    return 1;
+  }
+
+  std::vector<Footprint> sorted;
+  Footprint total = {};
+  total.name = "total";
+  for (const auto &entry : footprints) {
+    sorted.push_back(entry.second);
+    for (int r = 0; r < REGION_COUNT; r++) {
+      total.bytes[r] += entry.second.bytes[r];
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const Footprint &a, const Footprint &b) {
+    if (a.ram() != b.ram()) return a.ram() > b.ram();
+    if (a.flash() != b.flash()) return a.flash() > b.flash();
+    return a.name < b.name;
+  });
+  if (rows > 0 && sorted.size() > rows) {
+    sorted.resize(rows);
+  }
+  sorted.push_back(total);
+
+  if (csv) {
+    printf("%s", archives ? "archive" : "file");
+    for (int r = 0; r < REGION_COUNT; r++) printf(",%s", regionNames[r]);
+    printf("\n");
+    for (const Footprint &footprint : sorted) {
+      printf("%s", footprint.name.c_str());
+      for (int r = 0; r < REGION_COUNT; r++) printf(",%llu", footprint.bytes[r]);
+      printf("\n");
+    }
+  } else {
+    printf("%-40s", archives ? "archive" : "file");
+    for (int r = 0; r < REGION_COUNT; r++) printf(" %9s", regionNames[r]);
+    printf("\n");
+    for (const Footprint &footprint : sorted) {
+      printf("%-40.40s", footprint.name.c_str());
+      for (int r = 0; r < REGION_COUNT; r++) printf(" %9llu", footprint.bytes[r]);
+      printf("\n");
+    }
+  }
+  return 0;
+}
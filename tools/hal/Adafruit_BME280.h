@@ -0,0 +1,200 @@
+/**
+ * @file Adafruit_BME280.h
+ * @brief Host stand-in for the Adafruit BME280 library.
+ * @details The sensor is a register file: reads return what the host code stored with
+ *          `setRaw()` or `setRegister()`. `begin()` loads the calibration example of the Bosch
+ *          datasheet, so raw value 519888 reads as 25.08 °C, unless a calibration was set with
+ *          `setCalibration()`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Calibration and read errors settable for the replayer
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HAL_ADAFRUIT_BME280_H
+#define HAL_ADAFRUIT_BME280_H
+
+#include "Wire.h"
+
+#define BME280_REGISTER_CHIPID 0xD0
+#define BME280_REGISTER_CONTROLHUMID 0xF2
+#define BME280_REGISTER_STATUS 0xF3
+#define BME280_REGISTER_CONTROL 0xF4
+#define BME280_REGISTER_CONFIG 0xF5
+#define BME280_REGISTER_PRESSUREDATA 0xF7
+#define BME280_REGISTER_TEMPDATA 0xFA
+#define BME280_REGISTER_HUMIDDATA 0xFD
+
+/**
+ * @brief Calibration coefficients, same layout as in the library.
+ */
+typedef struct {
+  uint16_t dig_T1;
+  int16_t dig_T2;
+  int16_t dig_T3;
+  uint16_t dig_P1;
+  int16_t dig_P2;
+  int16_t dig_P3;
+  int16_t dig_P4;
+  int16_t dig_P5;
+  int16_t dig_P6;
+  int16_t dig_P7;
+  int16_t dig_P8;
+  int16_t dig_P9;
+  uint8_t dig_H1;
+  int16_t dig_H2;
+  uint8_t dig_H3;
+  int16_t dig_H4;
+  int16_t dig_H5;
+  int8_t dig_H6;
+} bme280_calib_data;
+
+/**
+ * @brief I2C device backed by a register file.
+ */
+class Adafruit_I2CDevice {
+public:
+  uint8_t registers[256] = {};  ///< Register contents.
+  bool readErrors[256] = {};    ///< Reads starting at these registers fail.
+
+  explicit Adafruit_I2CDevice(uint8_t address, TwoWire *wire = &Wire)
+    : addr(address) {}
+
+  bool write_then_read(const uint8_t *write, size_t writeLength, uint8_t *read, size_t readLength,
+                       bool stop = false) {
+    uint8_t reg = writeLength > 0 ? write[0] : 0;
+    if (readErrors[reg]) {
+      return false;
+    }
+    for (size_t i = 0; i < readLength; i++) {
+      read[i] = registers[(uint8_t)(reg + i)];
+    }
+    return true;
+  }
+
+  bool write(const uint8_t *buffer, size_t length, bool stop = true, const uint8_t *prefix = nullptr,
+             size_t prefixLength = 0) {
+    if (length >= 2) {
+      registers[buffer[0]] = buffer[1];
+    }
+    return true;
+  }
+
+  uint8_t address() {
+    return addr;
+  }
+
+private:
+  uint8_t addr;
+};
+
+/**
+ * @brief BME280 driver on top of the register file.
+ */
+class Adafruit_BME280 {
+public:
+  enum sensor_sampling { SAMPLING_NONE = 0, SAMPLING_X1, SAMPLING_X2, SAMPLING_X4, SAMPLING_X8, SAMPLING_X16 };
+  enum sensor_mode { MODE_SLEEP = 0, MODE_FORCED = 1, MODE_NORMAL = 3 };
+  enum sensor_filter { FILTER_OFF = 0, FILTER_X2, FILTER_X4, FILTER_X8, FILTER_X16 };
+  enum standby_duration {
+    STANDBY_MS_0_5 = 0,
+    STANDBY_MS_62_5 = 1,
+    STANDBY_MS_125 = 2,
+    STANDBY_MS_250 = 3,
+    STANDBY_MS_500 = 4,
+    STANDBY_MS_1000 = 5,
+    STANDBY_MS_10 = 6,
+    STANDBY_MS_20 = 7
+  };
+
+  ~Adafruit_BME280() {
+    delete i2c_dev;
+  }
+
+  bool begin(uint8_t address = 0x77, TwoWire *wire = &Wire) {
+    delete i2c_dev;
+    i2c_dev = new Adafruit_I2CDevice(address, wire);
+    i2c_dev->registers[BME280_REGISTER_CHIPID] = 0x60;
+    if (!calibrated) {
+      _bme280_calib = { 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+                        75, 362, 0, 313, 50, 30 };
+    }
+    return true;
+  }
+
+  void setSampling(sensor_mode mode = MODE_NORMAL, sensor_sampling temperature = SAMPLING_X16,
+                   sensor_sampling pressure = SAMPLING_X16, sensor_sampling humidity = SAMPLING_X16,
+                   sensor_filter filter = FILTER_OFF, standby_duration duration = STANDBY_MS_0_5) {}
+
+  uint32_t sensorID() {
+    return 0x60;
+  }
+
+  /**
+   * @brief Host only: stores raw ADC values in the data registers.
+   * @param adcT Raw temperature, 20 bit.
+   * @param adcH Raw humidity, 16 bit.
+   */
+  void setRaw(int32_t adcT, int32_t adcH) {
+    uint8_t *r = i2c_dev->registers;
+    r[BME280_REGISTER_TEMPDATA] = (adcT >> 12) & 0xFF;
+    r[BME280_REGISTER_TEMPDATA + 1] = (adcT >> 4) & 0xFF;
+    r[BME280_REGISTER_TEMPDATA + 2] = (adcT << 4) & 0xF0;
+    r[BME280_REGISTER_HUMIDDATA] = (adcH >> 8) & 0xFF;
+    r[BME280_REGISTER_HUMIDDATA + 1] = adcH & 0xFF;
+  }
+
+  /**
+   * @brief Host only: stores a register value, e.g. the status register.
+   * @param reg Register address.
+   * @param value Register value.
+   */
+  void setRegister(uint8_t reg, uint8_t value) {
+    if (i2c_dev != nullptr) i2c_dev->registers[reg] = value;
+  }
+
+  /**
+   * @brief Host only: makes burst reads starting at a register fail or succeed again.
+   * @param reg First register of the read.
+   * @param error True to fail the reads.
+   */
+  void setReadError(uint8_t reg, bool error) {
+    if (i2c_dev != nullptr) i2c_dev->readErrors[reg] = error;
+  }
+
+  /**
+   * @brief Host only: sets the calibration, also used by later calls of `begin()`.
+   * @param calibration Calibration coefficients.
+   */
+  void setCalibration(const bme280_calib_data &calibration) {
+    _bme280_calib = calibration;
+    calibrated = true;
+  }
+
+protected:
+  Adafruit_I2CDevice *i2c_dev = nullptr;
+  int32_t t_fine = 0;
+  int32_t t_fine_adjust = 0;
+  bme280_calib_data _bme280_calib = {};
+  bool calibrated = false;
+
+  uint8_t read8(uint8_t reg) {
+    return i2c_dev != nullptr ? i2c_dev->registers[reg] : 0;
+  }
+
+  void write8(uint8_t reg, uint8_t value) {
+    if (i2c_dev != nullptr) i2c_dev->registers[reg] = value;
+  }
+};
+
+
+#endif  // HAL_ADAFRUIT_BME280_H
@@ -0,0 +1,160 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Arduino core.
+ * @details Provides the subset of the Arduino API used by the firmware sources that the host
+ *          tools build, i.e. the benchmarks and the control simulation. Time is virtual: it only
+ *          advances through `delay()`, `delayMicroseconds()` and `hal::advanceMicros()`, so runs
+ *          are deterministic and a simulated hour takes milliseconds. Pin levels and PWM duties
+ *          are kept in tables that the host code reads and writes through the `hal` namespace.
+ *          Clock and tables exist once per thread, every thread simulates its own board.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Clock and pin tables per thread
+ * - **2026-10-19**: `OUTPUT_OPEN_DRAIN`
+ * - **2026-10-19**: `ledcAttachChannel()`
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HAL_ARDUINO_H
+#define HAL_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Print.h"
+
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define OUTPUT_OPEN_DRAIN 0x13
+
+#define IRAM_ATTR
+#define PROGMEM
+#define pgm_read_byte_near(address) (*(const uint8_t *)(address))
+
+#define ARDUINO 10812
+
+#define SET_LOOP_TASK_STACK_SIZE(size) \
+  size_t getArduinoLoopTaskStackSize(void) { \
+    return size; \
+  }
+
+#define HAL_PIN_COUNT 49  ///< GPIO count of the ESP32-S3
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+bool ledcAttachChannel(uint8_t pin, uint32_t freq, uint8_t resolution, uint8_t channel);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+
+uint32_t getCpuFrequencyMhz();
+
+/**
+ * @brief Serial port, writes to stdout and reads nothing.
+ */
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long baud) {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  int available() override {
+    return 0;
+  }
+  int read() override {
+    return -1;
+  }
+  size_t availableForWrite() {
+    return 256;
+  }
+  void flush() {}
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @brief Access to the virtual time, the pins and the PWM channels from host code.
+ */
+namespace hal {
+
+/**
+ * @brief Sets the virtual time.
+ * @param us Microseconds since boot.
+ */
+void setMicros(uint64_t us);
+
+/**
+ * @brief Advances the virtual time.
+ * @param us Microseconds.
+ */
+void advanceMicros(uint64_t us);
+
+/**
+ * @brief Gets the virtual time with 64 bits.
+ * @return Microseconds since boot.
+ */
+uint64_t nowMicros();
+
+/**
+ * @brief Sets the level an input pin reads.
+ * @param pin GPIO number.
+ * @param level `HIGH` or `LOW`.
+ */
+void setPin(uint8_t pin, int level);
+
+/**
+ * @brief Gets the level of a pin, as last written or set.
+ * @param pin GPIO number.
+ * @return `HIGH` or `LOW`.
+ */
+int getPin(uint8_t pin);
+
+/**
+ * @brief Sets the value an analog pin reads.
+ * @param pin GPIO number.
+ * @param value Raw 12 bit value.
+ */
+void setAnalog(uint8_t pin, uint16_t value);
+
+/**
+ * @brief Gets the PWM duty last written to a pin.
+ * @param pin GPIO number.
+ * @return Duty in counts of the configured resolution.
+ */
+uint32_t getDuty(uint8_t pin);
+
+/**
+ * @brief Restores the power-on state: time zero, pins low, duties zero.
+ */
+void reset();
+
+}  // namespace hal
+
+
+#endif  // HAL_ARDUINO_H
@@ -0,0 +1,57 @@
+/**
+ * @file Print.h
+ * @brief Host stand-in for the Arduino `Print` and `Stream` classes.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HAL_PRINT_H
+#define HAL_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Base class of all character outputs, like in the Arduino core.
+ */
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+
+  size_t write(const char *str);
+  size_t print(const char *str);
+  size_t print(char c);
+  size_t print(int value);
+  size_t print(unsigned int value);
+  size_t print(long value);
+  size_t print(unsigned long value);
+  size_t print(double value, int digits = 2);
+  size_t println();
+  size_t println(const char *str);
+  size_t println(int value);
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/**
+ * @brief Character input and output, like in the Arduino core.
+ */
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+};
+
+
+#endif  // HAL_PRINT_H
@@ -0,0 +1,95 @@
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the Arduino I2C driver.
+ * @details Transactions succeed without a device and only count the bytes, so drivers that
+ *          write to the bus can be measured on the host. Addresses marked absent with
+ *          `setPresent()` answer an address-only transaction with a NACK.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Devices can be marked absent
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HAL_WIRE_H
+#define HAL_WIRE_H
+
+#include "Arduino.h"
+
+/**
+ * @brief I2C bus that accepts every transaction.
+ */
+class TwoWire {
+public:
+  uint32_t transactions = 0;  ///< Completed write transactions.
+  uint32_t bytesWritten = 0;  ///< Bytes written in all transactions.
+
+  bool begin() {
+    return true;
+  }
+  bool begin(int sda, int scl, uint32_t frequency = 0) {
+    return true;
+  }
+  bool end() {
+    return true;
+  }
+  bool setClock(uint32_t frequency) {
+    clock = frequency;
+    return true;
+  }
+  uint32_t getClock() {
+    return clock;
+  }
+  void setTimeOut(uint16_t timeout) {}
+  void beginTransmission(uint8_t address) {
+    target = address & 0x7F;
+  }
+  uint8_t endTransmission(bool stop = true) {
+    transactions++;
+    return absent[target] ? 2 : 0;  // 2: NACK on the address
+  }
+  size_t write(uint8_t data) {
+    bytesWritten++;
+    return 1;
+  }
+  size_t write(const uint8_t *data, size_t size) {
+    bytesWritten += size;
+    return size;
+  }
+  size_t requestFrom(uint8_t address, size_t size, bool stop = true) {
+    return 0;
+  }
+  int available() {
+    return 0;
+  }
+  int read() {
+    return -1;
+  }
+
+  /**
+   * @brief Host only: connects or removes a device.
+   * @param address 7 bit address.
+   * @param present False to answer the address with a NACK.
+   */
+  void setPresent(uint8_t address, bool present) {
+    absent[address & 0x7F] = !present;
+  }
+
+private:
+  uint32_t clock = 100000;
+  uint8_t target = 0;
+  bool absent[128] = {};
+};
+
+extern TwoWire Wire;
+
+
+#endif  // HAL_WIRE_H
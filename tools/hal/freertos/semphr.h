@@ -0,0 +1,39 @@
+/**
+ * @file semphr.h
+ * @brief Host stand-in for the FreeRTOS semaphore API.
+ * @details The host runs a single task, so creation fails and callers skip the locking.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HAL_SEMPHR_H
+#define HAL_SEMPHR_H
+
+#include "queue.h"
+
+typedef void *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return nullptr;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  return pdFAIL;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  return pdFAIL;
+}
+
+
+#endif  // HAL_SEMPHR_H
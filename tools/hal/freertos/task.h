@@ -0,0 +1,42 @@
+/**
+ * @file task.h
+ * @brief Host stand-in for the FreeRTOS task API.
+ * @details There is no scheduler on the host: task creation succeeds without starting the task,
+ *          so background work like log formatting does not run.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: `taskYIELD()`
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef HAL_TASK_H
+#define HAL_TASK_H
+
+#include "FreeRTOS.h"
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stack,
+                                          void *parameter, UBaseType_t priority, TaskHandle_t *handle,
+                                          BaseType_t core) {
+  if (handle != nullptr) *handle = nullptr;
+  return pdPASS;
+}
+
+inline void vTaskDelay(TickType_t ticks) {}
+
+#define taskYIELD()
+
+inline BaseType_t xPortGetCoreID() {
+  return 1;
+}
+
+
+#endif  // HAL_TASK_H
@@ -0,0 +1,211 @@
+/**
+ * @file hal.cpp
+ * @brief Implementation of the host stand-in for the Arduino core.
+ * @details Contains the virtual clock, the pin and PWM tables and the `Print` formatting.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Clock and pin tables per thread
+ * - **2026-10-19**: `ledcAttachChannel()`
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <stdarg.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+HardwareSerial Serial;
+TwoWire Wire;
+
+// Every thread has its own clock and pins, so simulations can run in parallel
+static thread_local uint64_t clockMicros = 0;
+static thread_local uint8_t pinLevels[HAL_PIN_COUNT];
+static thread_local uint16_t analogValues[HAL_PIN_COUNT];
+static thread_local uint32_t duties[HAL_PIN_COUNT];
+
+unsigned long millis() {
+  return (unsigned long)(clockMicros / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)clockMicros;
+}
+
+void delay(uint32_t ms) {
+  clockMicros += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us) {
+  clockMicros += us;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < HAL_PIN_COUNT && mode == INPUT_PULLUP) pinLevels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < HAL_PIN_COUNT) pinLevels[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < HAL_PIN_COUNT ? pinLevels[pin] : LOW;
+}
+
+uint16_t analogRead(uint8_t pin) {
+  return pin < HAL_PIN_COUNT ? analogValues[pin] : 0;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution) {
+  return pin < HAL_PIN_COUNT;
+}
+
+bool ledcAttachChannel(uint8_t pin, uint32_t freq, uint8_t resolution, uint8_t channel) {
+  return pin < HAL_PIN_COUNT && channel < 8;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t duty) {
+  if (pin >= HAL_PIN_COUNT) return false;
+  duties[pin] = duty;
+  return true;
+}
+
+uint32_t getCpuFrequencyMhz() {
+  return 240;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+namespace hal {
+
+void setMicros(uint64_t us) {
+  clockMicros = us;
+}
+
+void advanceMicros(uint64_t us) {
+  clockMicros += us;
+}
+
+uint64_t nowMicros() {
+  return clockMicros;
+}
+
+void setPin(uint8_t pin, int level) {
+  if (pin < HAL_PIN_COUNT) pinLevels[pin] = level ? HIGH : LOW;
+}
+
+int getPin(uint8_t pin) {
+  return pin < HAL_PIN_COUNT ? pinLevels[pin] : LOW;
+}
+
+void setAnalog(uint8_t pin, uint16_t value) {
+  if (pin < HAL_PIN_COUNT) analogValues[pin] = value;
+}
+
+uint32_t getDuty(uint8_t pin) {
+  return pin < HAL_PIN_COUNT ? duties[pin] : 0;
+}
+
+void reset() {
+  clockMicros = 0;
+  memset(pinLevels, 0, sizeof(pinLevels));
+  memset(analogValues, 0, sizeof(analogValues));
+  memset(duties, 0, sizeof(duties));
+}
+
+}  // namespace hal
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t written = 0;
+  while (size--) {
+    written += write(*buffer++);
+  }
+  return written;
+}
+
+size_t Print::write(const char *str) {
+  return str != nullptr ? write((const uint8_t *)str, strlen(str)) : 0;
+}
+
+size_t Print::print(const char *str) {
+  return write(str);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(int value) {
+  return printf("%d", value);
+}
+
+size_t Print::print(unsigned int value) {
+  return printf("%u", value);
+}
+
+size_t Print::print(long value) {
+  return printf("%ld", value);
+}
+
+size_t Print::print(unsigned long value) {
+  return printf("%lu", value);
+}
+
+size_t Print::print(double value, int digits) {
+  return printf("%.*f", digits, value);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+size_t Print::println(const char *str) {
+  return print(str) + println();
+}
+
+size_t Print::println(int value) {
+  return print(value) + println();
+}
+
+size_t Print::printf(const char *format, ...) {
+  // Like the ESP32 core: format on the stack, fall back to the heap for long output
+  char buffer[64];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length < 0) {
+    return 0;
+  }
+  if ((size_t)length < sizeof(buffer)) {
+    return write((const uint8_t *)buffer, length);
+  }
+  char *heap = (char *)malloc(length + 1);
+  if (heap == nullptr) {
+    return 0;
+  }
+  va_start(args, format);
+  vsnprintf(heap, length + 1, format, args);
+  va_end(args);
+  size_t written = write((const uint8_t *)heap, length);
+  free(heap);
+  return written;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file input.cpp
+ * @brief Host implementation of the input port of the firmware.
+ * @details The inputs are read directly from the virtual board of the HAL and nothing is
+ *          recorded. The clock only advances between the loop passes of the host code, so
+ *          `loopMillis()` is the virtual `millis()`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "Arduino.h"
+#include "input_hx.h"
+
+uint32_t loopMillis() {
+  return millis();
+}
+
+int readInputPin(uint8_t pin) {
+  return digitalRead(pin);
+}
+
+uint16_t readInputAnalog(uint8_t pin) {
+  return analogRead(pin);
+}
+
+void captureI2cPresence(uint8_t address, bool present) {}
+
+void captureI2cRead(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length) {}
+
+void captureCalibration(uint8_t address, const void *calibration, size_t size) {}
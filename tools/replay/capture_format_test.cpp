@@ -0,0 +1,133 @@
+/**
+ * @file capture_format_test.cpp
+ * @brief Host test of the event encoding of the input capture.
+ * @details Encodes events with `captureEncodeEvent()` as `InputCapture` does and decodes them
+ *          with `captureDecodeEvent()` as `hx_replay` does. The test covers every event type,
+ *          the payload limits, truncated and malformed input and the CRC against its reference
+ *          value.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "../test/check.h"
+#include "capture_format_hx.h"
+
+/**
+ * @brief Builds an event.
+ * @param time Loop pass time.
+ * @param type Event type.
+ * @param channel Pin or I2C address.
+ * @param value Gap length, level, analog value or presence.
+ * @param length Bytes of payload, filled with a pattern that contains zero bytes.
+ * @return The event.
+ */
+static CaptureEvent makeEvent(uint32_t time, uint8_t type, uint8_t channel, uint32_t value, uint8_t length = 0) {
+  CaptureEvent event = {};
+  event.time = time;
+  event.type = type;
+  event.channel = channel;
+  event.reg = type == CAPTURE_I2C ? 0xF7 : 0;
+  event.value = value;
+  event.length = length;
+  for (uint8_t i = 0; i < length; i++) {
+    event.data[i] = (uint8_t)(i * 53 % 7);
+  }
+  return event;
+}
+
+static bool sameEvent(const CaptureEvent &a, const CaptureEvent &b) {
+  return a.time == b.time && a.type == b.type && a.channel == b.channel && a.reg == b.reg && a.value == b.value
+         && a.length == b.length && memcmp(a.data, b.data, a.length) == 0;
+}
+
+static void testCrc() {
+  const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  HX_CHECK(captureCrc32(check, sizeof(check)) == 0xCBF43926);  // CRC-32 check value
+  HX_CHECK(captureCrc32(check + 5, 4, captureCrc32(check, 5)) == 0xCBF43926);
+}
+
+static void testRoundTrip() {
+  // Every type, values across the varint widths, empty and full payloads
+  const CaptureEvent events[] = {
+    makeEvent(1000, CAPTURE_BOOT, 0, 0),
+    makeEvent(1000, CAPTURE_PRESENCE, 0x76, 1),
+    makeEvent(1000, CAPTURE_PRESENCE, 0x77, 0),
+    makeEvent(1000, CAPTURE_CALIBRATION, 0x76, 0, 32),
+    makeEvent(1000, CAPTURE_SETTINGS, 0, 0, sizeof(CaptureSettings)),
+    makeEvent(1001, CAPTURE_PIN, 4, 1),
+    makeEvent(1001, CAPTURE_ANALOG, 1, 4095),
+    makeEvent(1002, CAPTURE_ANALOG, 1, UINT32_MAX),
+    makeEvent(1150, CAPTURE_I2C, 0x76, 0, 8),
+    makeEvent(1150, CAPTURE_I2C, 0x77, 0, 0),  // Failed read
+    makeEvent(1300, CAPTURE_GAP, 0, 127),
+    makeEvent(1300, CAPTURE_GAP, 0, 3600000),
+    makeEvent(1300, CAPTURE_I2C, 0x76, 0, CAPTURE_DATA_MAX),
+    makeEvent(1300 + 0x1FFFFFFF, CAPTURE_PIN, 5, 0),  // Largest step the 29 bits of the time delta hold
+  };
+  const size_t count = sizeof(events) / sizeof(events[0]);
+
+  std::vector<uint8_t> block;
+  uint32_t previousTime = events[0].time;
+  for (const CaptureEvent &event : events) {
+    uint8_t out[CAPTURE_EVENT_MAX + 8];
+    size_t size = captureEncodeEvent(out, event, previousTime);
+    HX_CHECK(size > 0 && size <= CAPTURE_EVENT_MAX);
+    block.insert(block.end(), out, out + size);
+    previousTime = event.time;
+  }
+
+  const uint8_t *in = block.data();
+  const uint8_t *end = in + block.size();
+  previousTime = events[0].time;
+  for (size_t i = 0; i < count; i++) {
+    CaptureEvent event;
+    HX_CHECK(captureDecodeEvent(in, end, event, previousTime));
+    HX_CHECK(sameEvent(event, events[i]));
+    previousTime = event.time;
+  }
+  HX_CHECK(in == end);
+}
+
+static void testTruncated() {
+  // Every cut inside an event with a payload is detected
+  const CaptureEvent events[] = {
+    makeEvent(2000, CAPTURE_I2C, 0x76, 0, 8),
+    makeEvent(2000, CAPTURE_ANALOG, 1, 300000),
+    makeEvent(2000, CAPTURE_CALIBRATION, 0x77, 0, 24),
+  };
+  for (const CaptureEvent &event : events) {
+    uint8_t out[CAPTURE_EVENT_MAX];
+    size_t size = captureEncodeEvent(out, event, 1000);
+    for (size_t cut = 0; cut < size; cut++) {
+      const uint8_t *in = out;
+      CaptureEvent decoded;
+      HX_CHECK(!captureDecodeEvent(in, out + cut, decoded, 1000));
+    }
+  }
+
+  // A payload longer than an event holds is malformed
+  uint8_t overlong[2 + CAPTURE_DATA_MAX + 1] = { (0 << 3) | CAPTURE_SETTINGS, CAPTURE_DATA_MAX + 1 };
+  const uint8_t *in = overlong;
+  CaptureEvent decoded;
+  HX_CHECK(!captureDecodeEvent(in, overlong + sizeof(overlong), decoded, 1000));
+}
+
+int main() {
+  testCrc();
+  testRoundTrip();
+  testTruncated();
+  return checkResult("capture_format_test");
+}
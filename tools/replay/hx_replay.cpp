@@ -0,0 +1,458 @@
+/**
+ * @file hx_replay.cpp
+ * @brief Deterministic replay of an input capture through the firmware control code.
+ * @details Reads the segments of a capture written by `InputCapture` (see `capture_format_hx.h`)
+ *          and feeds them through the unchanged sources of the sensor supervision and fusion, the
+ *          sampling profiles, the buttons, the run timer, the heater control and the fans. The HAL
+ *          clock is set to the time of every recorded loop pass, the pins, analog values and
+ *          sensor registers are set from the events before the pass that read them. The replay
+ *          runs the same loop as `heatX.ino` without the LCD, the history, the run log and the
+ *          telemetry, which only consume the control outputs.
+ *
+ *          The segments are given in the order of their numbers and replayed as one capture. A
+ *          replay that starts with the segment of a boot is exact. A later segment starts at its
+ *          keyframe with the sensors, the settings and the run state recorded there, but with a
+ *          fresh filter and PID, so the outputs converge to the recorded run after a while. The
+ *          replay ends at the next boot.
+ *
+ *          Every change of an output is written as a CSV line:
+ *          `time_ms,duty,fan,fan_heat,running,elapsed_s,temperature,humidity,rate,profile,active`,
+ *          `duty` being the raw heater PWM value and the measurements in 0.01 units. Two replays
+ *          of the same capture give the same lines; after a change of the control code the
+ *          effect on a recorded run is shown by `--compare` with the lines of the previous
+ *          build. A digest of the lines and the speed against real time are printed to stderr.
+ *
+ *          Blocks flagged with `CAPTURE_FLAG_LOST`, missing block numbers and a torn last block
+ *          are reported; the replay continues but is no longer exact from there.
+ *
+ * ### Example Usage
+ * ```sh
+ * hx_replay capture/00000007.hxc capture/00000008.hxc --csv before.csv
+ * # ... change the control code, rebuild ...
+ * hx_replay capture/00000007.hxc capture/00000008.hxc --compare before.csv
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: PID input taken from the filter state in °C
+ * - **2026-10-19**: Segments of the capture ring, replay from a keyframe
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "capture_format_hx.h"
+#include "globals_hx.h"
+#include "gpio_hx.h"
+#include "heating_hx.h"
+#include "pid_hx.h"
+#include "sensor_hx.h"
+
+/* ============================================================================================= */
+// Firmware objects, configured like in heatX.ino
+/* ============================================================================================= */
+static ButtonActiveLow buttonStart(_PIN_START, _BUTTON_DEBOUNCE_TIME);
+static ButtonActiveLow buttonStop(_PIN_STOP, _BUTTON_DEBOUNCE_TIME);
+
+static CustomBME280 bmeSpool;
+static CustomBME280 bmeOutlet;
+static const uint8_t spoolSensorAddress[] = { _TEMPSENSOR_I2C_ADDRESS_1 };
+static const uint8_t outletSensorAddress[] = { _TEMPSENSOR_I2C_ADDRESS_2 };
+static SensorSupervisor spoolSensor(bmeSpool, spoolSensorAddress, sizeof(spoolSensorAddress));
+static SensorSupervisor outletSensor(bmeOutlet, outletSensorAddress, sizeof(outletSensorAddress));
+static SensorSupervisor *const sensorSupervisors[] = { &spoolSensor, &outletSensor };
+static const float sensorVariances[] = { _SENSOR_1_VARIANCE, _SENSOR_2_VARIANCE };
+static SensorFusion sensorFusion(sensorSupervisors, sensorVariances, 2, _KALMAN_PROCESS_NOISE);
+static SensorProfileManager sensorProfileManager(sensorFusion);
+
+static GpioOffDelay fan(_PIN_FAN, _FAN_OFFDELAY);
+static GpioOffDelay fanHeat(_PIN_FAN_HEAT, _FAN_HEAT_OFFDELAY);
+static RunTimer runTimer;
+
+static PID_heatX pidHeating(_PID_TEMP_KP_PRESET, _PID_TEMP_KI_PRESET, _PID_TEMP_KD_PRESET, 0);
+static HeatingController heatingController(pidHeating, fan, fanHeat, _PIN_HEAT);
+
+/**
+ * @brief Outputs of one loop pass, a line of the result.
+ */
+typedef struct {
+  uint32_t duty;        ///< Heater PWM value.
+  int fan;              ///< Level of the circulation fan pin.
+  int fanHeat;          ///< Level of the heater fan pin.
+  bool running;         ///< Run active.
+  uint32_t elapsed;     ///< Drying time of the run (s).
+  int32_t temperature;  ///< Fused temperature (0.01 °C).
+  int32_t humidity;     ///< Fused humidity (0.01 %).
+  int32_t rate;         ///< Temperature rate (0.01 °C/s).
+  uint8_t profile;      ///< Sampling profile.
+  bool active;          ///< Sensor data valid.
+} ReplayOutputs;
+
+static bool operator!=(const ReplayOutputs &a, const ReplayOutputs &b) {
+  return a.duty != b.duty || a.fan != b.fan || a.fanHeat != b.fanHeat || a.running != b.running
+         || a.elapsed != b.elapsed || a.temperature != b.temperature || a.humidity != b.humidity
+         || a.rate != b.rate || a.profile != b.profile || a.active != b.active;
+}
+
+static CustomBME280 *sensorAt(uint8_t address) {
+  for (uint8_t address1 : spoolSensorAddress) {
+    if (address1 == address) return &bmeSpool;
+  }
+  for (uint8_t address2 : outletSensorAddress) {
+    if (address2 == address) return &bmeOutlet;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Reads the events of one segment file.
+ * @param path Segment file.
+ * @param events Receives the events in order.
+ * @param sequence Number of the next block, set from the first block of the capture.
+ * @param boot Set to true if the capture starts with a boot, false for a keyframe.
+ * @param ended Set to true at the next boot or at a damaged block, where the replay ends.
+ * @return false if the file cannot be read or holds a malformed event.
+ */
+static bool readSegment(const char *path, std::vector<CaptureEvent> &events, uint32_t &sequence, bool &boot,
+                        bool &ended) {
+  FILE *in = fopen(path, "rb");
+  if (in == nullptr) {
+    perror(path);
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[65536];
+  size_t got;
+  while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+    data.insert(data.end(), chunk, chunk + got);
+  }
+  fclose(in);
+
+  size_t offset = 0;
+  while (offset + sizeof(CaptureBlockHeader) <= data.size()) {
+    CaptureBlockHeader header;
+    memcpy(&header, &data[offset], sizeof(header));
+    const uint8_t *payload = &data[offset] + sizeof(header);
+    if (header.magic != CAPTURE_MAGIC || header.version != CAPTURE_VERSION
+        || offset + sizeof(header) + header.length > data.size()) {
+      fprintf(stderr, "%s: torn or unknown block at offset %zu, replay ends there\n", path, offset);
+      ended = true;
+      break;
+    }
+    uint32_t crc = captureCrc32(&data[offset], offsetof(CaptureBlockHeader, crc));
+    if (captureCrc32(payload, header.length, crc) != header.crc) {
+      fprintf(stderr, "%s: CRC error in block %u, replay ends there\n", path, (unsigned)header.sequence);
+      ended = true;
+      break;
+    }
+
+    const uint8_t *read = payload;
+    uint32_t time = header.time;
+    std::vector<CaptureEvent> block;
+    for (uint16_t i = 0; i < header.count; i++) {
+      CaptureEvent event;
+      if (!captureDecodeEvent(read, payload + header.length, event, time)) {
+        fprintf(stderr, "%s: malformed event in block %u\n", path, (unsigned)header.sequence);
+        return false;
+      }
+      time = event.time;
+      block.push_back(event);
+    }
+    bool startsBoot = !block.empty() && block[0].type == CAPTURE_BOOT;
+
+    if (events.empty()) {
+      // The replay starts at the boot or at the first keyframe, the blocks before are incomplete
+      if (!startsBoot && !(header.flags & CAPTURE_FLAG_KEYFRAME)) {
+        offset += sizeof(header) + header.length;
+        continue;
+      }
+      boot = startsBoot;
+      sequence = header.sequence;
+    } else if (startsBoot) {
+      fprintf(stderr, "%s: next boot at %u ms, replay ends there\n", path, (unsigned)header.time);
+      ended = true;
+      break;
+    }
+    if (header.sequence != sequence || (header.flags & CAPTURE_FLAG_LOST)) {
+      fprintf(stderr, "%s: events lost before %u ms, the replay is not exact from there\n", path,
+              (unsigned)header.time);
+    }
+    sequence = header.sequence + 1;
+    events.insert(events.end(), block.begin(), block.end());
+    offset += sizeof(header) + header.length;
+  }
+  return true;
+}
+
+/**
+ * @brief Reads all events of a capture.
+ * @param paths Segment files in the order of their numbers.
+ * @param events Receives the events in order.
+ * @param boot Set to true if the capture starts with a boot, false for a keyframe.
+ * @return false if a file cannot be read or holds no boot or keyframe.
+ */
+static bool readCapture(const std::vector<const char *> &paths, std::vector<CaptureEvent> &events, bool &boot) {
+  uint32_t sequence = 0;
+  bool ended = false;
+  for (size_t i = 0; i < paths.size() && !ended; i++) {
+    if (!readSegment(paths[i], events, sequence, boot, ended)) {
+      return false;
+    }
+  }
+  if (events.empty()) {
+    fprintf(stderr, "%s: no capture of a boot or a keyframe\n", paths[0]);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Sets the inputs of the virtual board from an event, see `applySettings()` of the sketch.
+ * @param event Event to apply.
+ * @param first True for the first settings, which also carry the run state.
+ */
+static void applyEvent(const CaptureEvent &event, bool &first) {
+  CustomBME280 *sensor;
+  switch (event.type) {
+    case CAPTURE_PIN:
+      hal::setPin(event.channel, event.value);
+      break;
+    case CAPTURE_ANALOG:
+      hal::setAnalog(event.channel, event.value);
+      break;
+    case CAPTURE_I2C:
+      sensor = sensorAt(event.channel);
+      if (sensor == nullptr) break;
+      sensor->setReadError(event.reg, event.length == 0);
+      for (uint8_t i = 0; i < event.length; i++) {
+        sensor->setRegister(event.reg + i, event.data[i]);
+      }
+      break;
+    case CAPTURE_PRESENCE:
+      Wire.setPresent(event.channel, event.value != 0);
+      break;
+    case CAPTURE_CALIBRATION:
+      sensor = sensorAt(event.channel);
+      if (sensor != nullptr) {
+        bme280_calib_data calibration = {};
+        memcpy(&calibration, event.data, event.length < sizeof(calibration) ? event.length : sizeof(calibration));
+        sensor->setCalibration(calibration);
+      }
+      break;
+    case CAPTURE_SETTINGS: {
+      CaptureSettings settings = {};
+      memcpy(&settings, event.data, event.length < sizeof(settings) ? event.length : sizeof(settings));
+      targetHeatingValue = { settings.targetTemperature, settings.targetHumidity };
+      targetCountdown = { settings.hours, settings.minutes };
+      pidHeating.SetTunings(settings.kp, settings.ki, settings.kd);
+      if (first) {
+        runState = { settings.running != 0, settings.elapsedSeconds };
+        first = false;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Runs one loop pass, see `loop()` and `checkHeatSensorStatus()` of the sketch.
+ */
+static void runPass() {
+  buttonStart.update();
+  buttonStop.update();
+  fan.update();
+  fanHeat.update();
+
+  uint32_t targetSeconds = (targetCountdown.hours * 60UL + targetCountdown.minutes) * 60UL;
+  bool start = buttonStart.isPressed();
+  bool stop = buttonStop.isPressed();
+  runTimer.update(runState, start, stop, sensorFusion.isActive(), targetSeconds);
+
+  if (sensorFusion.update()) {
+    actualHeatingValue.temperature = sensorFusion.getData().temperature;
+    actualHeatingValue.humidity = sensorFusion.getData().humidity;
+    sensorProfileManager.update(targetHeatingValue.temperature, sensorFusion.getData().temperature);
+    heatingController.setInput(sensorFusion.getTemperature(), sensorFusion.getTemperatureRate(),
+                               targetHeatingValue.temperature);
+#ifdef _DEBUG_POTI_INPUT
+    pidHeating.SetInput(map(readInputAnalog(_PIN_DEBUG_POTI), 0, 4095, _TEMP_MIN, _TEMP_MAX));
+#endif
+    heatingController.control(runState.running && sensorFusion.isActive());
+  } else if (!sensorFusion.isActive()) {
+    heatingController.control(false);
+  }
+}
+
+static ReplayOutputs readOutputs() {
+  return {
+    hal::getDuty(_PIN_HEAT),
+    hal::getPin(_PIN_FAN),
+    hal::getPin(_PIN_FAN_HEAT),
+    runState.running,
+    runState.elapsedSeconds,
+    sensorFusion.getData().temperature,
+    sensorFusion.getData().humidity,
+    sensorFusion.getRate(),
+    (uint8_t)sensorProfileManager.getProfile(),
+    sensorFusion.isActive()
+  };
+}
+
+static size_t nextGap(const std::vector<CaptureEvent> &events, size_t from) {
+  while (from < events.size() && events[from].type != CAPTURE_GAP) from++;
+  return from;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: hx_replay segment.hxc... [--csv file] [--compare expected.csv]\n");
+}
+
+int main(int argc, char **argv) {
+  std::vector<const char *> capturePaths;
+  const char *csvPath = nullptr;
+  const char *expectedPath = nullptr;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--csv") == 0 && hasValue) {
+      csvPath = argv[++i];
+    } else if (strcmp(argv[i], "--compare") == 0 && hasValue) {
+      expectedPath = argv[++i];
+    } else if (argv[i][0] != '-') {
+      capturePaths.push_back(argv[i]);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (capturePaths.empty()) {
+    usage();
+    return 1;
+  }
+
+  std::vector<CaptureEvent> events;
+  bool boot = false;
+  if (!readCapture(capturePaths, events, boot)) {
+    return 1;
+  }
+  if (!boot) {
+    fprintf(stderr, "starting at the keyframe at %u ms with a fresh filter and PID, the replay is not exact\n",
+            (unsigned)events[0].time);
+  }
+  auto wallStart = std::chrono::steady_clock::now();
+
+  // Boot pass: the events recorded while the sensors were probed come first, see setup(); a
+  // keyframe restates the sensors and the settings in the same way
+  size_t next = 0;
+  bool firstSettings = true;
+  uint32_t time = events[0].time;
+  hal::setMicros((uint64_t)time * 1000);
+  while (next < events.size() && events[next].time <= time) applyEvent(events[next++], firstSettings);
+  sensorFusion.begin();
+  ledcAttachChannel(_PIN_HEAT, _PWM_FREQUENCY, _PWM_RESOLUTION, _PWM_CHANNEL);
+  pidHeating.SetOutputLimits(0, _PWM_MAX_VALUE);
+  pidHeating.SetSetpoint(_TEMP_PRESET);
+  pidHeating.SetSampleTime(150);
+  if (!boot) {
+    // The buttons held their recorded levels before the keyframe, so they start debounced
+    hal::setMicros((uint64_t)(time - _BUTTON_DEBOUNCE_TIME) * 1000);
+    buttonStart.update();
+    buttonStop.update();
+    hal::setMicros((uint64_t)time * 1000);
+    buttonStart.update();
+    buttonStop.update();
+  }
+
+  // A pass follows its predecessor after 1 ms unless a gap event says otherwise
+  std::vector<std::string> lines;
+  lines.push_back("time_ms,duty,fan,fan_heat,running,elapsed_s,temperature,humidity,rate,profile,active");
+  ReplayOutputs last = {};
+  bool hasLast = false;
+  uint32_t passes = 0;
+  const uint32_t end = events.back().time;
+  size_t gap = nextGap(events, next);
+  while (time < end) {
+    if (gap < events.size() && events[gap].time - events[gap].value == time) {
+      time = events[gap].time;
+      gap = nextGap(events, gap + 1);
+    } else {
+      time++;
+    }
+    hal::setMicros((uint64_t)time * 1000);
+    while (next < events.size() && events[next].time <= time) applyEvent(events[next++], firstSettings);
+    runPass();
+    passes++;
+
+    ReplayOutputs outputs = readOutputs();
+    if (!hasLast || outputs != last) {
+      char line[160];
+      snprintf(line, sizeof(line), "%u,%u,%d,%d,%d,%u,%d,%d,%d,%u,%d", (unsigned)time, (unsigned)outputs.duty,
+               outputs.fan, outputs.fanHeat, outputs.running, (unsigned)outputs.elapsed, (int)outputs.temperature,
+               (int)outputs.humidity, (int)outputs.rate, (unsigned)outputs.profile, outputs.active);
+      lines.push_back(line);
+      last = outputs;
+      hasLast = true;
+    }
+  }
+
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double replayedSeconds = (end - events[0].time) / 1000.0;
+  uint64_t digest = 1469598103934665603ULL;
+  for (const std::string &line : lines) {
+    for (char c : line) digest = (digest ^ (uint8_t)c) * 1099511628211ULL;
+    digest = (digest ^ '\n') * 1099511628211ULL;
+  }
+  fprintf(stderr, "%zu events, %u passes, %.0f s in %.3f s, %.0fx real time, digest %016llx\n", events.size(),
+          (unsigned)passes, replayedSeconds, wallSeconds, replayedSeconds / (wallSeconds > 0 ? wallSeconds : 1e-9),
+          (unsigned long long)digest);
+
+  FILE *out = csvPath != nullptr ? fopen(csvPath, "w") : stdout;
+  if (out == nullptr) {
+    perror(csvPath);
+    return 1;
+  }
+  for (const std::string &line : lines) fprintf(out, "%s\n", line.c_str());
+  if (out != stdout) fclose(out);
+
+  if (expectedPath == nullptr) {
+    return 0;
+  }
+  FILE *expected = fopen(expectedPath, "r");
+  if (expected == nullptr) {
+    perror(expectedPath);
+    return 1;
+  }
+  char buffer[256];
+  size_t index = 0;
+  while (fgets(buffer, sizeof(buffer), expected) != nullptr) {
+    buffer[strcspn(buffer, "\r\n")] = '\0';
+    if (index >= lines.size() || lines[index] != buffer) {
+      fprintf(stderr, "first difference in line %zu:\n  expected %s\n  replayed %s\n", index + 1, buffer,
+              index < lines.size() ? lines[index].c_str() : "(end)");
+      fclose(expected);
+      return 2;
+    }
+    index++;
+  }
+  fclose(expected);
+  if (index != lines.size()) {
+    fprintf(stderr, "first difference in line %zu:\n  expected (end)\n  replayed %s\n", index + 1,
+            lines[index].c_str());
+    return 2;
+  }
+  fprintf(stderr, "identical to %s\n", expectedPath);
+  return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file closed_loop.cpp
+ * @brief Implementation of the closed-loop run.
+ * @details Contains the material table of the simulation and the control loop with its KPI
+ *          evaluation.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version, moved from `hx_sim.cpp`
+ * - **2026-10-19**: Sensor samples at the period of the profile chosen like `SensorProfileManager`
+ * - **2026-10-19**: PID input taken from the filter state in °C
+ * - **2026-10-19**: Sensor read through `SensorFusion` and `SensorProfileManager` of the firmware
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "closed_loop.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "globals_hx.h"
+#include "gpio_hx.h"
+#include "heating_hx.h"
+#include "pid_hx.h"
+#include "sensor_hx.h"
+
+static const SimMaterial simMaterials[] = {
+  { "PLA", { 0.6, 30, 30, 10 }, 0.10, 55 },
+  { "PETG", { 0.5, 30, 25, 10 }, 0.08, 68 },
+  { "ASA", { 0.6, 30, 25, 10 }, 0.10, 75 },
+  { "ABS", { 0.8, 30, 25, 10 }, 0.12, 80 },
+  { "PP", { 0.1, 30, 25, 10 }, 0.02, 80 },
+  { "PA", { 4.0, 20, 12, 12 }, 0.60, 80 },
+  { "PC", { 0.5, 20, 15, 12 }, 0.08, 80 },
+  { "TPU", { 1.2, 30, 25, 10 }, 0.20, 55 },
+};
+
+const SimMaterial *findSimMaterial(const char *material) {
+  for (const SimMaterial &entry : simMaterials) {
+    if (strcmp(entry.material, material) == 0) return &entry;
+  }
+  return nullptr;
+}
+
+// Calibration that makes the compensation of CustomBME280::readFixed() linear: t_fine is
+// 8 * (adcT / 8 - 32768), 1/640 °C per step of adcT / 8, and the humidity is adcH / 256 %
+static const bme280_calib_data simCalibration = { 16384, 16384, 0, 36477, -10685, 3024, 2855, 140, -7,
+                                                  15500, -14600, 6000, 0, 256, 0, 0, 0, 0 };
+
+// Measurement time per profile, BME280 datasheet appendix B: 1 + 2 * T_os + 2 * H_os + 0.5 ms
+static const uint32_t simMeasureMillis[PROFILE_COUNT] = { 8, 66 };
+
+// Loop passes per model step, one status poll of the supervisor each
+static constexpr int simPasses = (int)(simSamplePeriod * 1000 + 0.5) / _SENSOR_POLL_INTERVAL;
+
+/**
+ * @brief Stores a sample in the data registers of the simulated sensor.
+ * @param sensor Sensor to write.
+ * @param temperature Temperature in °C.
+ * @param humidity Relative humidity in %.
+ */
+static void setSample(CustomBME280 &sensor, double temperature, double humidity) {
+  // Bit 2 is below the resolution and keeps adcT off 0x80000, the value of a disabled measurement
+  int32_t adcT = ((int32_t)std::lround(temperature * 640) + 32768) * 8 + 4;
+  int32_t adcH = (int32_t)std::lround(std::min(std::max(humidity, 0.0), 100.0) * 256);
+  sensor.setRaw(adcT, adcH);
+}
+
+uint64_t seedOf(const char *name) {
+  uint64_t hash = 1469598103934665603ULL;
+  for (; *name; name++) hash = (hash ^ (uint8_t)*name) * 1099511628211ULL;
+  return hash;
+}
+
+void writeTraceHeader(FILE *trace) {
+  fprintf(trace, "scenario,time_s,setpoint,measured,air,heater,wall,spool,humidity,duty,moisture\n");
+}
+
+Kpi runClosedLoop(const LoopCase &loopCase, const ControlGains &gains, const DryerIntegration &integration,
+                  FILE *trace) {
+  const double setpoint = loopCase.setpoint;
+  const double doorClose = loopCase.doorOpen + loopCase.doorDuration;
+  const bool hasDoor = loopCase.doorOpen >= 0;
+  const double band = (double)_PROFILE_HOLD_BAND / _CENTI;
+
+  // Firmware objects in the state after setup(), see setupHeating(), setupHeatSensor() and setupSettings()
+  hal::reset();
+  ledcAttachChannel(_PIN_HEAT, _PWM_FREQUENCY, _PWM_RESOLUTION, _PWM_CHANNEL);
+  PID_heatX pid(gains.kp, gains.ki, gains.kd, 0);
+  pid.SetOutputLimits(0, _PWM_MAX_VALUE);
+  pid.SetSampleTime(150);
+  pid.SetTunings(gains.kp, gains.ki, gains.kd);
+  GpioOffDelay fan(_PIN_FAN, _FAN_OFFDELAY);
+  GpioOffDelay fanHeat(_PIN_FAN_HEAT, _FAN_HEAT_OFFDELAY);
+  HeatingController heating(pid, fan, fanHeat, _PIN_HEAT);
+
+  const uint8_t address[] = { _TEMPSENSOR_I2C_ADDRESS_1 };
+  const float variances[] = { _SENSOR_1_VARIANCE };
+  CustomBME280 bme;
+  bme.setCalibration(simCalibration);
+  SensorSupervisor supervisor(bme, address, 1);
+  SensorSupervisor *const supervisors[] = { &supervisor };
+  SensorFusion fusion(supervisors, variances, 1, _KALMAN_PROCESS_NOISE);
+  SensorProfileManager profiles(fusion);
+  fusion.begin();
+
+  std::vector<DryerSpool> spools(loopCase.spools, { loopCase.material->model, loopCase.mass, loopCase.moisture });
+  DryerModel model(DryerParams(), integration, loopCase.ambient, loopCase.humidity, spools);
+  Noise noise(loopCase.seed);
+
+  std::vector<double> errors;
+  errors.reserve((size_t)(loopCase.duration / simSamplePeriod) + 1);
+  double t10 = -1, t90 = -1;
+  double overshoot = 0;
+  double energy = 0;
+  double dried = -1;
+  double start = model.getAirTemperature();
+  int32_t target = lround(setpoint * _CENTI);
+
+  // Measurement cycle of the sensor in normal mode, with the profile the supervisor configured
+  uint32_t cycleStart = 0;
+  enumSensorProfile cycleProfile = supervisor.getProfile();
+  bool sampled = false;
+
+  for (size_t step = 0; step * simSamplePeriod < loopCase.duration; step++) {
+    double t = step * simSamplePeriod;
+
+    // Loop passes of the firmware between two model steps, the sample comes from the model
+    // state at the start of the step
+    for (int i = 0; i < simPasses; i++) {
+      hal::advanceMicros(_SENSOR_POLL_INTERVAL * 1000);
+      uint32_t now = loopMillis();
+      if (now - cycleStart >= sensorProfiles[cycleProfile].samplePeriod) {
+        cycleStart += sensorProfiles[cycleProfile].samplePeriod;
+        cycleProfile = supervisor.getProfile();
+        sampled = false;
+      }
+      bool measuring = now - cycleStart < simMeasureMillis[cycleProfile];
+      if (!measuring && !sampled) {
+        setSample(bme, model.getAirTemperature() + loopCase.noise * noise.gaussian(), model.getHumidity());
+        sampled = true;
+      }
+      bme.setRegister(BME280_REGISTER_STATUS, measuring ? 0x08 : 0);
+
+      if (fusion.update()) {
+        profiles.update(target, fusion.getData().temperature);
+        heating.setInput(fusion.getTemperature(), fusion.getTemperatureRate(), target);
+        heating.control(true);
+      } else if (!fusion.isActive()) {
+        heating.control(false);
+      }
+      fan.update();
+      fanHeat.update();
+    }
+
+    double duty = (double)hal::getDuty(_PIN_HEAT) / _PWM_MAX_VALUE;
+    bool doorOpen = hasDoor && t >= loopCase.doorOpen && t < doorClose;
+    energy += model.advance(simSamplePeriod, { duty, hal::getPin(_PIN_FAN_HEAT) == HIGH, doorOpen });
+
+    double air = model.getAirTemperature();
+    double error = air - setpoint;
+    errors.push_back(error);
+    if (t10 < 0 && air >= start + 0.1 * (setpoint - start)) t10 = t;
+    if (t90 < 0 && air >= start + 0.9 * (setpoint - start)) t90 = t;
+    if (!(hasDoor && t >= loopCase.doorOpen)) overshoot = std::max(overshoot, error);
+    if (dried < 0 && model.getMoisture() <= loopCase.material->dry) dried = t;
+
+    if (trace != nullptr && step % (size_t)(1 / simSamplePeriod) == 0) {
+      fprintf(trace, "%s,%.0f,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f,%.2f,%.3f,%.4f\n", loopCase.name.c_str(), t,
+              setpoint, (double)supervisor.getData().temperature / _CENTI, air, model.getHeaterTemperature(),
+              model.getWallTemperature(), model.getSpoolTemperature(0), model.getHumidity(), duty,
+              model.getMoisture());
+    }
+    if (loopCase.stopWhenDry && dried >= 0) {
+      break;
+    }
+  }
+
+  // Settling ends with the last sample outside the band before the door opens
+  size_t windowEnd = hasDoor ? std::min(errors.size(), (size_t)(loopCase.doorOpen / simSamplePeriod)) : errors.size();
+  size_t settled = 0;
+  for (size_t i = 0; i < windowEnd; i++) {
+    if (std::fabs(errors[i]) > band) settled = i + 1;
+  }
+  size_t recovered = errors.size();
+  size_t disturbanceEnd = windowEnd;
+  if (hasDoor) {
+    size_t closed = std::min(errors.size(), (size_t)(doorClose / simSamplePeriod));
+    recovered = closed;
+    for (size_t i = closed; i < errors.size(); i++) {
+      if (std::fabs(errors[i]) > band) recovered = i + 1;
+    }
+    disturbanceEnd = recovered < errors.size() ? recovered : closed;
+  }
+
+  // Steady state is the second half of the run, a dryer is past its transients by then
+  double sum = 0;
+  size_t count = 0;
+  for (size_t i = errors.size() / 2; i < errors.size(); i++) {
+    if (i >= windowEnd && i < disturbanceEnd) continue;
+    sum += errors[i] * errors[i];
+    count++;
+  }
+
+  Kpi kpi;
+  kpi.name = loopCase.name;
+  kpi.riseS = (t10 >= 0 && t90 >= 0) ? t90 - t10 : -1;
+  kpi.overshootC = overshoot;
+  kpi.settlingS = settled < windowEnd ? settled * simSamplePeriod : -1;
+  kpi.recoveryS = !hasDoor ? 0 : recovered < errors.size() ? recovered * simSamplePeriod - doorClose : -1;
+  kpi.rmsC = count > 0 ? std::sqrt(sum / count) : -1;
+  kpi.energyWh = energy / 3600;
+  kpi.dryMin = dried >= 0 ? dried / 60 : -1;
+  return kpi;
+}
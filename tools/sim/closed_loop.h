@@ -0,0 +1,162 @@
+/**
+ * @file closed_loop.h
+ * @brief Closed-loop run of the firmware heater control against the dryer model.
+ * @details Shared by the KPI suite `hx_sim` and the optimizer `hx_optimize`. One run sets up
+ *          the firmware objects as `setup()` does, runs the loop passes of the sensor and heater
+ *          code and drives `DryerModel` with the heater duty and the heater fan. The host HAL
+ *          keeps its clock and pins per thread, so runs on different threads are independent;
+ *          only the bus and latency statistics of the firmware are shared and meaningless there.
+ *
+ *          The sensors are modeled as one spool sensor behind the firmware `SensorSupervisor`,
+ *          `SensorFusion` and `SensorProfileManager`. The host BME280 reads the chamber air with
+ *          white noise in normal mode: a measurement starts every sample period of the profile
+ *          the supervisor applied and sets the measuring bit for its measurement time. Its
+ *          calibration makes the compensation linear, so a sample reads with a 0.01 °C
+ *          resolution. The firmware polls the status every `_SENSOR_POLL_INTERVAL` and runs the
+ *          controller once per sample; the model advances in steps of 75 ms.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version, moved from `hx_sim.cpp`
+ * - **2026-10-19**: Hold sensor profile simulated
+ * - **2026-10-19**: Sensor read through the firmware supervisor, fusion and profile manager
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef CLOSED_LOOP_H
+#define CLOSED_LOOP_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "dryer_model.h"
+
+/** Step of the model, the sample period of the fast sensor profile in s. */
+static constexpr double simSamplePeriod = 0.075;
+
+/**
+ * @brief Simulation properties of a material preset.
+ */
+struct SimMaterial {
+  const char *material;  ///< Material name as in `materialPresets`.
+  DryerMaterial model;   ///< Sorption and diffusion in the model.
+  double dry;            ///< Mean moisture in % at which the spools count as dry.
+  double limit;          ///< Highest chamber temperature the filament tolerates in °C.
+};
+
+/**
+ * @brief Looks up the simulation properties of a material.
+ * @param material Material name, case sensitive.
+ * @return Properties, or nullptr if the material is unknown.
+ */
+const SimMaterial *findSimMaterial(const char *material);
+
+/**
+ * @brief Tuning of the temperature PID.
+ */
+struct ControlGains {
+  double kp;  ///< Proportional gain.
+  double ki;  ///< Integral gain.
+  double kd;  ///< Derivative gain.
+};
+
+/**
+ * @brief Conditions of one closed-loop run.
+ */
+struct LoopCase {
+  std::string name;             ///< Name in the trace.
+  const SimMaterial *material;  ///< Material of the spools.
+  double setpoint;              ///< Temperature setpoint in °C.
+  double duration;              ///< Longest run time in s.
+  int spools;                   ///< Number of spools.
+  double mass;                  ///< Filament mass per spool in kg.
+  double moisture;              ///< Initial moisture of the spools in %.
+  double ambient;               ///< Ambient temperature in °C.
+  double humidity;              ///< Ambient relative humidity in %.
+  double doorOpen;              ///< Time the door opens in s, negative for a closed door.
+  double doorDuration;          ///< Time the door stays open in s.
+  double noise;                 ///< Standard deviation of the sensor noise in °C.
+  uint64_t seed;                ///< Seed of the sensor noise.
+  bool stopWhenDry;             ///< End the run as soon as the spools are dry.
+};
+
+/**
+ * @brief Control performance of one run.
+ */
+struct Kpi {
+  std::string name;   ///< Scenario name.
+  double riseS;       ///< Rise time from 10 % to 90 % in s.
+  double overshootC;  ///< Overshoot in °C.
+  double settlingS;   ///< Settling time into the hold band in s.
+  double recoveryS;   ///< Recovery after the door closed in s, 0 without door.
+  double rmsC;        ///< RMS control error in the second half of the run in °C.
+  double energyWh;    ///< Heater energy in Wh.
+  double dryMin;      ///< Time to dry in minutes.
+};
+
+/**
+ * @brief Deterministic random numbers, the same on every host and standard library.
+ */
+class Noise {
+private:
+  uint64_t state; /**< Xorshift state. */
+
+public:
+  explicit Noise(uint64_t seed)
+    : state(seed ? seed : 1) {}
+
+  /**
+   * @brief Draws a uniform number.
+   * @return Number in (0, 1).
+   */
+  double uniform() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return ((state >> 11) + 0.5) / 9007199254740992.0;
+  }
+
+  /**
+   * @brief Draws a standard normal number with Box-Muller.
+   * @return Number with mean 0 and standard deviation 1.
+   */
+  double gaussian() {
+    return std::sqrt(-2 * std::log(uniform())) * std::cos(2 * M_PI * uniform());
+  }
+};
+
+/**
+ * @brief Derives a seed from a name, so adding a case does not change the others.
+ * @param name Case name.
+ * @return Seed.
+ */
+uint64_t seedOf(const char *name);
+
+/**
+ * @brief Runs the firmware control against the dryer model.
+ * @param loopCase Conditions of the run.
+ * @param gains PID tuning.
+ * @param integration Integrator of the model.
+ * @param trace CSV time series with one line per second, or nullptr.
+ * @return KPIs of the run; times that were never reached are -1.
+ */
+Kpi runClosedLoop(const LoopCase &loopCase, const ControlGains &gains, const DryerIntegration &integration,
+                  FILE *trace);
+
+/**
+ * @brief Writes the header line of the trace written by `runClosedLoop()`.
+ * @param trace Destination.
+ */
+void writeTraceHeader(FILE *trace);
+
+
+#endif  // CLOSED_LOOP_H
@@ -0,0 +1,168 @@
+/**
+ * @file cmaes.cpp
+ * @brief Implementation of the CMA-ES minimizer.
+ * @details Contains the sampling, the distribution update and the Jacobi eigen decomposition
+ *          of `Cmaes`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "cmaes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+Cmaes::Cmaes(const Vector &start, double initialSigma, const Vector &boxLower, const Vector &boxUpper,
+             size_t population, uint64_t seed)
+  : n(start.size()), lower(boxLower), upper(boxUpper), mean(start), sigma(initialSigma), random(seed),
+    generation(0) {
+  lambda = population > 0 ? population : 4 + (size_t)std::floor(3 * std::log((double)n));
+  mu = lambda / 2;
+  for (size_t i = 0; i < mu; i++) weights.push_back(std::log(mu + 0.5) - std::log(i + 1.0));
+  double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  double squares = 0;
+  for (double &weight : weights) {
+    weight /= sum;
+    squares += weight * weight;
+  }
+  muEff = 1 / squares;
+
+  double dimensions = (double)n;
+  cc = (4 + muEff / dimensions) / (dimensions + 4 + 2 * muEff / dimensions);
+  cs = (muEff + 2) / (dimensions + muEff + 5);
+  c1 = 2 / ((dimensions + 1.3) * (dimensions + 1.3) + muEff);
+  cmu = std::min(1 - c1, 2 * (muEff - 2 + 1 / muEff) / ((dimensions + 2) * (dimensions + 2) + muEff));
+  damps = 1 + 2 * std::max(0.0, std::sqrt((muEff - 1) / (dimensions + 1)) - 1) + cs;
+  chiN = std::sqrt(dimensions) * (1 - 1 / (4 * dimensions) + 1 / (21 * dimensions * dimensions));
+
+  C.assign(n, Vector(n, 0));
+  B.assign(n, Vector(n, 0));
+  for (size_t i = 0; i < n; i++) C[i][i] = B[i][i] = 1;
+  D.assign(n, 1);
+  pc.assign(n, 0);
+  ps.assign(n, 0);
+  candidates.assign(lambda, Vector(n));
+  steps.assign(lambda, Vector(n));
+}
+
+const Cmaes::Matrix &Cmaes::ask() {
+  Vector z(n);
+  for (size_t k = 0; k < lambda; k++) {
+    for (size_t i = 0; i < n; i++) z[i] = D[i] * random.gaussian();
+    for (size_t i = 0; i < n; i++) {
+      double y = 0;
+      for (size_t j = 0; j < n; j++) y += B[i][j] * z[j];
+      steps[k][i] = y;
+      candidates[k][i] = std::min(upper[i], std::max(lower[i], mean[i] + sigma * y));
+    }
+  }
+  return candidates;
+}
+
+void Cmaes::tell(const Vector &fitness) {
+  std::vector<size_t> order(lambda);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return fitness[a] < fitness[b]; });
+
+  // Weighted mean of the best steps
+  Vector yw(n, 0);
+  for (size_t k = 0; k < mu; k++) {
+    for (size_t i = 0; i < n; i++) yw[i] += weights[k] * steps[order[k]][i];
+  }
+  for (size_t i = 0; i < n; i++) {
+    mean[i] = std::min(upper[i], std::max(lower[i], mean[i] + sigma * yw[i]));
+  }
+
+  // C^-1/2 * yw = B * D^-1 * B^T * yw
+  Vector projected(n, 0);
+  for (size_t j = 0; j < n; j++) {
+    double dot = 0;
+    for (size_t i = 0; i < n; i++) dot += B[i][j] * yw[i];
+    for (size_t i = 0; i < n; i++) projected[i] += B[i][j] * dot / D[j];
+  }
+
+  double psNorm = 0;
+  for (size_t i = 0; i < n; i++) {
+    ps[i] = (1 - cs) * ps[i] + std::sqrt(cs * (2 - cs) * muEff) * projected[i];
+    psNorm += ps[i] * ps[i];
+  }
+  psNorm = std::sqrt(psNorm);
+  generation++;
+  bool hsig = psNorm / std::sqrt(1 - std::pow(1 - cs, 2.0 * generation)) / chiN < 1.4 + 2 / (n + 1.0);
+  for (size_t i = 0; i < n; i++) {
+    pc[i] = (1 - cc) * pc[i] + (hsig ? std::sqrt(cc * (2 - cc) * muEff) : 0) * yw[i];
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j <= i; j++) {
+      double rankMu = 0;
+      for (size_t k = 0; k < mu; k++) rankMu += weights[k] * steps[order[k]][i] * steps[order[k]][j];
+      double rankOne = pc[i] * pc[j] + (hsig ? 0 : cc * (2 - cc) * C[i][j]);
+      C[i][j] = C[j][i] = (1 - c1 - cmu) * C[i][j] + c1 * rankOne + cmu * rankMu;
+    }
+  }
+
+  sigma *= std::exp(cs / damps * (psNorm / chiN - 1));
+  decompose();
+}
+
+void Cmaes::decompose() {
+  // Cyclic Jacobi rotations on a copy of C, the rotations accumulate in B
+  Matrix a = C;
+  for (size_t i = 0; i < n; i++) {
+    std::fill(B[i].begin(), B[i].end(), 0);
+    B[i][i] = 1;
+  }
+  for (int sweep = 0; sweep < 50; sweep++) {
+    double off = 0;
+    for (size_t p = 0; p < n; p++) {
+      for (size_t q = p + 1; q < n; q++) off += a[p][q] * a[p][q];
+    }
+    if (off < 1e-30) {
+      break;
+    }
+    for (size_t p = 0; p < n; p++) {
+      for (size_t q = p + 1; q < n; q++) {
+        if (std::fabs(a[p][q]) < 1e-300) continue;
+        double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+        double t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+        double c = 1 / std::sqrt(t * t + 1);
+        double s = t * c;
+        for (size_t k = 0; k < n; k++) {
+          double akp = a[k][p];
+          double akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (size_t k = 0; k < n; k++) {
+          double apk = a[p][k];
+          double aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (size_t k = 0; k < n; k++) {
+          double bkp = B[k][p];
+          double bkq = B[k][q];
+          B[k][p] = c * bkp - s * bkq;
+          B[k][q] = s * bkp + c * bkq;
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < n; i++) D[i] = std::sqrt(std::max(a[i][i], 1e-20));
+}
+
+Cmaes::Vector Cmaes::getMean() const {
+  return mean;
+}
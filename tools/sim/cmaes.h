@@ -0,0 +1,112 @@
+/**
+ * @file cmaes.h
+ * @brief Covariance matrix adaptation evolution strategy for small search spaces.
+ * @details Implements the (mu/mu_w, lambda)-CMA-ES with cumulative step-size adaptation and
+ *          rank-one plus rank-mu covariance updates, following Hansen's tutorial "The CMA
+ *          Evolution Strategy". The covariance matrix is decomposed with Jacobi rotations, which
+ *          is exact and cheap for the few dimensions of a controller tuning. Candidates are
+ *          clamped to a box; the fitness is minimized.
+ *
+ * ### Example Usage
+ * ```cpp
+ * Cmaes search({ 0.3, 0.7, 0 }, 0.5, { -1, -2, -2 }, { 3.5, 2.5, 3.5 }, 8, seed);
+ * for (int generation = 0; generation < 20; generation++) {
+ *   std::vector<std::vector<double>> candidates = search.ask();
+ *   std::vector<double> fitness = evaluate(candidates);
+ *   search.tell(fitness);
+ * }
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef CMAES_H
+#define CMAES_H
+
+#include <cstdint>
+#include <vector>
+
+#include "closed_loop.h"
+
+/**
+ * @brief CMA-ES minimizer.
+ */
+class Cmaes {
+private:
+  typedef std::vector<double> Vector;
+  typedef std::vector<Vector> Matrix;
+
+  size_t n;                  /**< Dimensions. */
+  size_t lambda;             /**< Candidates per generation. */
+  size_t mu;                 /**< Parents of the recombination. */
+  Vector weights;            /**< Recombination weights of the parents. */
+  double muEff;              /**< Variance effective selection mass. */
+  double cc, cs, c1, cmu;    /**< Learning rates of the paths and the covariance. */
+  double damps;              /**< Damping of the step size. */
+  double chiN;               /**< Expected length of a standard normal vector. */
+  Vector lower, upper;       /**< Search box. */
+  Vector mean;               /**< Distribution mean. */
+  double sigma;              /**< Step size. */
+  Matrix C;                  /**< Covariance matrix. */
+  Matrix B;                  /**< Eigenvectors of `C`, one per column. */
+  Vector D;                  /**< Square roots of the eigenvalues of `C`. */
+  Vector pc, ps;             /**< Evolution paths of the covariance and the step size. */
+  Matrix candidates;         /**< Candidates of the current generation, clamped. */
+  Matrix steps;              /**< Unclamped steps `B * D * z` of the candidates. */
+  Noise random;              /**< Source of the samples. */
+  uint32_t generation;       /**< Completed generations. */
+
+  void decompose();
+
+public:
+  /**
+   * @brief Constructor: starts with an isotropic distribution.
+   * @param start Initial mean.
+   * @param initialSigma Initial step size, about a quarter of the search box.
+   * @param boxLower Lower bounds.
+   * @param boxUpper Upper bounds.
+   * @param population Candidates per generation, 0 for the default `4 + 3 ln(n)`.
+   * @param seed Seed of the samples.
+   */
+  Cmaes(const Vector &start, double initialSigma, const Vector &boxLower, const Vector &boxUpper,
+        size_t population, uint64_t seed);
+
+  /**
+   * @brief Samples the candidates of the next generation.
+   * @return `lambda` candidates inside the box.
+   */
+  const Matrix &ask();
+
+  /**
+   * @brief Updates the distribution with the fitness of the candidates from `ask()`.
+   * @param fitness Fitness per candidate, lower is better.
+   */
+  void tell(const Vector &fitness);
+
+  /**
+   * @brief Gets the distribution mean, the current estimate of the optimum.
+   * @return Mean inside the box.
+   */
+  Vector getMean() const;
+
+  /**
+   * @brief Gets the step size.
+   * @return Step size.
+   */
+  double getSigma() const {
+    return sigma;
+  }
+};
+
+
+#endif  // CMAES_H
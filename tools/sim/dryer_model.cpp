@@ -0,0 +1,215 @@
+/**
+ * @file dryer_model.cpp
+ * @brief Implementation of the dryer model.
+ * @details Contains the derivatives of the model and the fixed and adaptive Runge-Kutta
+ *          integrators of `DryerModel`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "dryer_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr double airHeatPerVolume = 1.2 * 1005;  // Density times heat capacity of air in J/(m³ K)
+static constexpr double latentHeat = 2400;              // Evaporation heat of water in J/g
+static constexpr double referenceTemperature = 60;      // Temperature of the material exchange rates in °C
+
+DryerModel::DryerModel(const DryerParams &dryerParams, const DryerIntegration &dryerIntegration,
+                       double ambientTemperature, double ambientHumidity,
+                       const std::vector<DryerSpool> &spools)
+  : params(dryerParams), integration(dryerIntegration), ambient(ambientTemperature),
+    ambientVapor(saturationVapor(ambientTemperature) * ambientHumidity / 100), count(spools.size()),
+    layers((size_t)std::max(1, dryerParams.layers)), step(dryerIntegration.fixedStep), haveSlope(false),
+    slopeInputs(), steps(0), evaluations(0) {
+  for (const DryerSpool &spool : spools) {
+    // The surface of a spool grows with its mass to the power of 2/3
+    capacity.push_back(params.spoolCapacity + params.filamentCapacity * spool.mass);
+    conductance.push_back(params.airToSpool * std::cbrt(spool.mass * spool.mass));
+    layerMass.push_back(spool.mass * 1000 / layers);
+    saturation.push_back(spool.material.saturation);
+    surfaceRate.push_back(spool.material.surfaceExchange / 3600);
+    layerRate.push_back(spool.material.layerExchange / 3600);
+    inverseDoubling.push_back(1 / spool.material.doubling);
+  }
+  scale.resize(count);
+
+  state.assign(STATE_SPOOLS + count * (1 + layers), ambient);
+  state[STATE_VAPOR] = ambientVapor;
+  for (size_t layer = 0; layer < layers; layer++) {
+    for (size_t s = 0; s < count; s++) {
+      state[STATE_SPOOLS + count + layer * count + s] = spools[s].moisture;
+    }
+  }
+
+  size_t size = state.size();
+  k1.resize(size);
+  k2.resize(size);
+  k3.resize(size);
+  k4.resize(size);
+  stage.resize(size);
+  next.resize(size);
+}
+
+double DryerModel::saturationVapor(double temperature) {
+  // Magnus formula for the vapor pressure, ideal gas law for the density
+  double pressure = 611.2 * std::exp(17.62 * temperature / (243.12 + temperature));
+  return pressure / (461.5 * (temperature + 273.15)) * 1000;
+}
+
+double DryerModel::getHumidity() const {
+  return std::min(100.0, state[STATE_VAPOR] / saturationVapor(state[STATE_AIR]) * 100);
+}
+
+double DryerModel::getSpoolMoisture(size_t spool) const {
+  const double *moisture = state.data() + STATE_SPOOLS + count;
+  double sum = 0;
+  for (size_t layer = 0; layer < layers; layer++) sum += moisture[layer * count + spool];
+  return sum / layers;
+}
+
+double DryerModel::getMoisture() const {
+  double water = 0;
+  double mass = 0;
+  for (size_t s = 0; s < count; s++) {
+    water += getSpoolMoisture(s) * layerMass[s];
+    mass += layerMass[s];
+  }
+  return mass > 0 ? water / mass : 0;
+}
+
+void DryerModel::derivatives(const double *y, double *dydt, const DryerInputs &inputs) {
+  evaluations++;
+  const size_t n = count;
+  const double *spoolTemperature = y + STATE_SPOOLS;
+  const double *moisture = spoolTemperature + n;
+  double *spoolSlope = dydt + STATE_SPOOLS;
+  double *moistureSlope = spoolSlope + n;
+
+  double heater = y[STATE_HEATER];
+  double air = y[STATE_AIR];
+  double wall = y[STATE_WALL];
+  double vapor = y[STATE_VAPOR];
+  double humidity = std::min(1.0, vapor / saturationVapor(air));
+  double flow = params.ventFlow + (inputs.doorOpen ? params.doorFlow : 0);
+
+  // Spools: heat from the air, evaporation from the outer layer
+  double airToSpools = 0;
+  double evaporation = 0;  // g/s
+  for (size_t s = 0; s < n; s++) {
+    scale[s] = std::exp2((spoolTemperature[s] - referenceTemperature) * inverseDoubling[s]);
+    double heat = conductance[s] * (air - spoolTemperature[s]);
+    double surface = surfaceRate[s] * scale[s] * (moisture[s] - saturation[s] * humidity);
+    double water = surface * layerMass[s] / 100;
+    airToSpools += heat;
+    evaporation += water;
+    spoolSlope[s] = (heat - water * latentHeat) / capacity[s];
+    moistureSlope[s] = -surface;
+  }
+
+  // Diffusion between neighboring layers, layer 0 is the outer one
+  for (size_t layer = 0; layer < layers; layer++) {
+    const double *current = moisture + layer * n;
+    double *slope = moistureSlope + layer * n;
+    if (layer > 0) {
+      const double *outer = current - n;
+      for (size_t s = 0; s < n; s++) slope[s] = layerRate[s] * scale[s] * (outer[s] - current[s]);
+    }
+    if (layer + 1 < layers) {
+      const double *inner = current + n;
+      for (size_t s = 0; s < n; s++) slope[s] += layerRate[s] * scale[s] * (inner[s] - current[s]);
+    }
+  }
+
+  double heaterToAir = (inputs.heaterFan ? params.heaterToAirFan : params.heaterToAirStill) * (heater - air);
+  double airToWall = params.airToWall * (air - wall);
+  double vent = flow * airHeatPerVolume * (air - ambient);
+  dydt[STATE_HEATER] = (params.heaterPower * inputs.duty - heaterToAir) / params.heaterCapacity;
+  dydt[STATE_AIR] = (heaterToAir - airToWall - vent - airToSpools) / params.airCapacity;
+  dydt[STATE_WALL] = (airToWall - params.wallToAmbient * (wall - ambient)) / params.wallCapacity;
+  dydt[STATE_VAPOR] = (evaporation - flow * (vapor - ambientVapor)) / params.airVolume;
+}
+
+void DryerModel::stepFixed(double dt, const DryerInputs &inputs) {
+  const size_t size = state.size();
+  double *y = state.data();
+
+  derivatives(y, k1.data(), inputs);
+  for (size_t i = 0; i < size; i++) stage[i] = y[i] + dt / 2 * k1[i];
+  derivatives(stage.data(), k2.data(), inputs);
+  for (size_t i = 0; i < size; i++) stage[i] = y[i] + dt / 2 * k2[i];
+  derivatives(stage.data(), k3.data(), inputs);
+  for (size_t i = 0; i < size; i++) stage[i] = y[i] + dt * k3[i];
+  derivatives(stage.data(), k4.data(), inputs);
+  for (size_t i = 0; i < size; i++) y[i] += dt / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+  steps++;
+}
+
+void DryerModel::advanceAdaptive(double duration, const DryerInputs &inputs) {
+  const size_t size = state.size();
+  const double tolerance = integration.tolerance;
+  bool sameInputs = slopeInputs.duty == inputs.duty && slopeInputs.heaterFan == inputs.heaterFan
+                    && slopeInputs.doorOpen == inputs.doorOpen;
+  if (!haveSlope || !sameInputs) {
+    derivatives(state.data(), k1.data(), inputs);
+    slopeInputs = inputs;
+    haveSlope = true;
+  }
+
+  double remaining = duration;
+  while (remaining > 1e-12) {
+    double h = std::min(step, remaining);
+    const double *y = state.data();
+
+    for (size_t i = 0; i < size; i++) stage[i] = y[i] + h / 2 * k1[i];
+    derivatives(stage.data(), k2.data(), inputs);
+    for (size_t i = 0; i < size; i++) stage[i] = y[i] + h * 3 / 4 * k2[i];
+    derivatives(stage.data(), k3.data(), inputs);
+    for (size_t i = 0; i < size; i++) next[i] = y[i] + h * (2.0 / 9 * k1[i] + 1.0 / 3 * k2[i] + 4.0 / 9 * k3[i]);
+    derivatives(next.data(), k4.data(), inputs);
+
+    // Difference to the embedded second order solution, scaled per component
+    double error = 0;
+    for (size_t i = 0; i < size; i++) {
+      double difference = h * (-5.0 / 72 * k1[i] + 1.0 / 12 * k2[i] + 1.0 / 9 * k3[i] - 1.0 / 8 * k4[i]);
+      error = std::max(error, std::fabs(difference) / (tolerance * (1 + std::fabs(y[i]))));
+    }
+
+    double factor = error > 0 ? 0.9 * std::cbrt(1 / error) : 5;
+    if (error <= 1) {
+      state.swap(next);
+      k1.swap(k4);  // First same as last
+      remaining -= h;
+      steps++;
+      // A step cut short by the end of the interval does not change the step size
+      if (h == step) step = std::min(integration.maxStep, h * std::min(5.0, factor));
+    } else {
+      step = h * std::max(0.2, factor);
+    }
+  }
+}
+
+double DryerModel::advance(double duration, const DryerInputs &inputs) {
+  if (duration <= 0) {
+    return 0;
+  }
+  if (integration.method == INTEGRATOR_FIXED) {
+    size_t fixedSteps = (size_t)std::ceil(duration / integration.fixedStep - 1e-9);
+    for (size_t i = 0; i < fixedSteps; i++) stepFixed(duration / fixedSteps, inputs);
+    haveSlope = false;
+  } else {
+    advanceAdaptive(duration, inputs);
+  }
+  return params.heaterPower * inputs.duty * duration;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file dryer_model.h
+ * @brief Lumped-parameter thermal and moisture model of the dryer for the host simulation.
+ * @details This file contains the `DryerModel` class with these nodes:
+ *          - **heater**: heater plate, receives the electrical power
+ *          - **air**: chamber air with the fans and the sensor board, the node the sensors read
+ *          - **walls**: box walls between the chamber air and the ambient
+ *          - **vapor**: water vapor density of the chamber air
+ *          - **spools**: one temperature per spool and the moisture of its winding layers
+ *
+ *          The heater gives its heat to the air mainly through the heater fan. The air loses
+ *          heat to the walls and with the vent air, much more while the door is open. Moisture
+ *          diffuses from layer to layer towards the outer winding layer, which exchanges it
+ *          with the chamber air; the evaporation heat is taken from the spool. The vent air
+ *          carries the vapor out and brings ambient air in.
+ *
+ *          The state is kept as structure of arrays in one vector: the four scalar nodes, the
+ *          spool temperatures, then the moisture layer by layer with all spools of a layer next
+ *          to each other. The inner loops run over the spools of a layer without branches, so
+ *          the compiler can vectorize them.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef DRYER_MODEL_H
+#define DRYER_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Parameters of the dryer hardware.
+ */
+struct DryerParams {
+  double heaterPower = 250;        ///< Heater power at full duty in W.
+  double heaterCapacity = 150;     ///< Heat capacity of the heater plate in J/K.
+  double heaterToAirFan = 8;       ///< Heater to air conductance with the heater fan on in W/K.
+  double heaterToAirStill = 1;     ///< Heater to air conductance with the heater fan off in W/K.
+  double airCapacity = 200;        ///< Heat capacity of the air, the fans and the sensor board in J/K.
+  double airVolume = 0.04;         ///< Free air volume of the chamber in m³.
+  double airToWall = 6;            ///< Air to wall conductance in W/K.
+  double wallCapacity = 1500;      ///< Heat capacity of the walls in J/K.
+  double wallToAmbient = 2;        ///< Wall to ambient conductance in W/K.
+  double ventFlow = 0.0002;        ///< Vent air flow with the door closed in m³/s.
+  double doorFlow = 0.01;          ///< Additional air flow with the door open in m³/s.
+  double airToSpool = 2.5;         ///< Air to spool conductance of a 1 kg spool in W/K.
+  double spoolCapacity = 300;      ///< Heat capacity of an empty spool in J/K.
+  double filamentCapacity = 1500;  ///< Specific heat capacity of the filament in J/(kg K).
+  int layers = 6;                  ///< Winding layers per spool for the moisture diffusion.
+};
+
+/**
+ * @brief Moisture properties of a filament material.
+ */
+struct DryerMaterial {
+  double saturation;       ///< Equilibrium moisture at 100 % relative humidity in %.
+  double surfaceExchange;  ///< Exchange rate of the outer layer with the air at 60 °C in 1/h.
+  double layerExchange;    ///< Exchange rate between neighboring layers at 60 °C in 1/h.
+  double doubling;         ///< Temperature step in K that doubles the exchange rates.
+};
+
+/**
+ * @brief Spool in the chamber.
+ */
+struct DryerSpool {
+  DryerMaterial material;  ///< Filament material.
+  double mass;             ///< Filament mass in kg.
+  double moisture;         ///< Initial moisture, equal in all layers, in %.
+};
+
+/**
+ * @brief Inputs that stay constant during one `advance()` call.
+ */
+struct DryerInputs {
+  double duty;     ///< Heater duty from 0 to 1.
+  bool heaterFan;  ///< True if the heater fan runs.
+  bool doorOpen;   ///< True while the door is open.
+};
+
+/**
+ * @brief Integration method.
+ */
+enum enumDryerIntegrator {
+  INTEGRATOR_FIXED,    ///< Classic Runge-Kutta 4 with a fixed step.
+  INTEGRATOR_ADAPTIVE  ///< Bogacki-Shampine 3(2) with error control.
+};
+
+/**
+ * @brief Settings of the integrator.
+ */
+struct DryerIntegration {
+  enumDryerIntegrator method = INTEGRATOR_ADAPTIVE;  ///< Integration method.
+  double fixedStep = 0.5;                            ///< Step of the fixed method in s.
+  double maxStep = 60;                               ///< Largest step of the adaptive method in s.
+  double tolerance = 1e-4;                           ///< Absolute and relative error per step.
+};
+
+/**
+ * @brief Lumped-parameter model of the dryer with spools.
+ * @details `advance()` integrates the model over an interval with constant inputs. The
+ *          adaptive method keeps its step size between calls, so a closed loop that calls
+ *          `advance()` every control period takes one step per call while the steps are
+ *          short, and open-loop phases run with steps of up to `maxStep`.
+ *
+ * ### Example Usage
+ * ```cpp
+ * DryerModel model(DryerParams(), DryerIntegration(), 22, 50, { { pla, 1.0, 0.6 } });
+ * double energy = model.advance(0.075, { duty, true, false });
+ * double temperature = model.getAirTemperature();
+ * ```
+ */
+class DryerModel {
+private:
+  enum { STATE_HEATER, STATE_AIR, STATE_WALL, STATE_VAPOR, STATE_SPOOLS };
+
+  DryerParams params;                              /**< Hardware parameters. */
+  DryerIntegration integration;                    /**< Integrator settings. */
+  double ambient;                                  /**< Ambient temperature in °C. */
+  double ambientVapor;                             /**< Vapor density of the ambient air in g/m³. */
+  size_t count;                                    /**< Number of spools. */
+  size_t layers;                                   /**< Layers per spool. */
+  std::vector<double> capacity;                    /**< Heat capacity per spool in J/K. */
+  std::vector<double> conductance;                 /**< Air to spool conductance per spool in W/K. */
+  std::vector<double> layerMass;                   /**< Filament mass of one layer per spool in g. */
+  std::vector<double> saturation;                  /**< Equilibrium moisture at 100 % per spool in %. */
+  std::vector<double> surfaceRate;                 /**< Surface exchange at 60 °C per spool in 1/s. */
+  std::vector<double> layerRate;                   /**< Layer exchange at 60 °C per spool in 1/s. */
+  std::vector<double> inverseDoubling;             /**< Inverse doubling step per spool in 1/K. */
+  std::vector<double> scale;                       /**< Scratch: temperature factor of the exchange rates. */
+  std::vector<double> state;                       /**< Model state, see the class description. */
+  std::vector<double> k1, k2, k3, k4, stage, next; /**< Scratch vectors of the integrators. */
+  double step;                                     /**< Current step of the adaptive method in s. */
+  bool haveSlope;                                  /**< True if `k1` holds the slope at `state` (FSAL). */
+  DryerInputs slopeInputs;                         /**< Inputs `k1` was computed with. */
+  uint64_t steps;                                  /**< Accepted steps. */
+  uint64_t evaluations;                            /**< Evaluations of the derivatives. */
+
+  void derivatives(const double *y, double *dydt, const DryerInputs &inputs);
+  void stepFixed(double dt, const DryerInputs &inputs);
+  void advanceAdaptive(double duration, const DryerInputs &inputs);
+
+public:
+  /**
+   * @brief Constructor: all nodes start at the ambient temperature, the chamber air at the
+   *        ambient humidity.
+   * @param dryerParams Hardware parameters.
+   * @param dryerIntegration Integrator settings.
+   * @param ambientTemperature Ambient temperature in °C.
+   * @param ambientHumidity Ambient relative humidity in %.
+   * @param spools Spools in the chamber.
+   */
+  DryerModel(const DryerParams &dryerParams, const DryerIntegration &dryerIntegration,
+             double ambientTemperature, double ambientHumidity, const std::vector<DryerSpool> &spools);
+
+  /**
+   * @brief Integrates the model over an interval with constant inputs.
+   * @param duration Interval in s.
+   * @param inputs Heater duty, heater fan and door.
+   * @return Electrical energy of the heater in J.
+   */
+  double advance(double duration, const DryerInputs &inputs);
+
+  /**
+   * @brief Gets the temperature of the heater plate.
+   * @return Temperature in °C.
+   */
+  double getHeaterTemperature() const {
+    return state[STATE_HEATER];
+  }
+
+  /**
+   * @brief Gets the temperature of the chamber air.
+   * @return Temperature in °C.
+   */
+  double getAirTemperature() const {
+    return state[STATE_AIR];
+  }
+
+  /**
+   * @brief Gets the temperature of the walls.
+   * @return Temperature in °C.
+   */
+  double getWallTemperature() const {
+    return state[STATE_WALL];
+  }
+
+  /**
+   * @brief Gets the relative humidity of the chamber air.
+   * @return Relative humidity in %.
+   */
+  double getHumidity() const;
+
+  /**
+   * @brief Gets the temperature of a spool.
+   * @param spool Spool index.
+   * @return Temperature in °C.
+   */
+  double getSpoolTemperature(size_t spool) const {
+    return state[STATE_SPOOLS + spool];
+  }
+
+  /**
+   * @brief Gets the moisture of a spool, averaged over its layers.
+   * @param spool Spool index.
+   * @return Moisture in %.
+   */
+  double getSpoolMoisture(size_t spool) const;
+
+  /**
+   * @brief Gets the moisture of all spools, weighted by their mass.
+   * @return Moisture in %.
+   */
+  double getMoisture() const;
+
+  /**
+   * @brief Gets the number of spools.
+   * @return Number of spools.
+   */
+  size_t getSpoolCount() const {
+    return count;
+  }
+
+  /**
+   * @brief Gets the number of accepted integration steps.
+   * @return Steps since construction.
+   */
+  uint64_t getSteps() const {
+    return steps;
+  }
+
+  /**
+   * @brief Gets the number of evaluations of the derivatives.
+   * @return Evaluations since construction.
+   */
+  uint64_t getEvaluations() const {
+    return evaluations;
+  }
+
+  /**
+   * @brief Gets the saturation vapor density of air.
+   * @param temperature Temperature in °C.
+   * @return Vapor density in g/m³.
+   */
+  static double saturationVapor(double temperature);
+};
+
+
+#endif  // DRYER_MODEL_H
@@ -0,0 +1,506 @@
+/**
+ * @file hx_optimize.cpp
+ * @brief Monte-Carlo optimizer of the temperature PID gains and the material presets.
+ * @details Searches the controller tuning on thousands of closed-loop runs of `closed_loop.h`
+ *          with randomized loads, ambients and sensor noise. Every run is one task of a
+ *          `WorkStealingPool`; the HAL keeps its clock and pins per thread, so the runs are
+ *          independent and the throughput scales with the number of cores.
+ *
+ *          The optimization has two stages:
+ *          1. Gains: CMA-ES over `log10` of Kp, Ki and Kd for several weightings of the three
+ *             objectives time to dry, overshoot and heater energy. Each objective is normalized
+ *             by the result of the current `_PID_TEMP_*_PRESET` gains. Every generation draws
+ *             new random cases that all candidates share, so the candidates are compared on the
+ *             same loads. The best candidate of every generation is re-evaluated on a fixed
+ *             validation set, and the non-dominated ones form the Pareto front. The knee of the
+ *             front, the point closest to the best value of every objective, becomes the new
+ *             tuning.
+ *          2. Presets: with the chosen gains, CMA-ES per material over the setpoint between 10 °C
+ *             below the current preset and the temperature limit of the filament. Setpoints
+ *             whose overshoot passes the limit are penalized. The drying time is the 90th
+ *             percentile time to dry on the validation set, rounded up to full hours.
+ *
+ *          The random numbers only depend on the seed and the case, never on the thread that
+ *          runs it, so the result is the same for every `--threads`. Progress and throughput go
+ *          to stderr; the front is written as CSV and the presets as a fragment of
+ *          `globals_hx.h` that can replace the PID and material preset definitions. Humidity
+ *          and drying profile of the materials are kept from the current table.
+ *
+ * ### Example Usage
+ * ```sh
+ * hx_optimize --front front.csv --presets presets.h
+ * hx_optimize --threads 4 --generations 10 --samples 8 --validation 16   # quick look
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "closed_loop.h"
+#include "cmaes.h"
+#include "thread_pool.h"
+
+#include "globals_hx.h"
+
+/**
+ * @brief Averaged objectives of a set of runs.
+ */
+struct Objectives {
+  double dryMin;      ///< Mean time to dry in minutes, runs that never dried count double.
+  double overshootC;  ///< Mean overshoot in °C.
+  double energyWh;    ///< Mean heater energy in Wh.
+  double p90DryMin;   ///< 90th percentile of the time to dry in minutes.
+  double maxPeakC;    ///< Highest setpoint plus overshoot in °C.
+};
+
+/**
+ * @brief Tuning on the Pareto front.
+ */
+struct FrontPoint {
+  ControlGains gains;     ///< PID tuning.
+  Objectives objectives;  ///< Result on the validation set.
+  std::string source;     ///< Weighting that found the tuning.
+};
+
+/**
+ * @brief Options of the command line.
+ */
+struct Options {
+  size_t threads = 0;                 ///< Worker threads, 0 for all cores.
+  int generations = 30;               ///< CMA-ES generations per search.
+  size_t population = 0;              ///< Candidates per generation, 0 for the CMA-ES default.
+  int samples = 16;                   ///< Random cases per candidate and generation.
+  int validation = 48;                ///< Cases of the validation set.
+  uint64_t seed = 1;                  ///< Seed of all random numbers.
+  const char *frontPath = nullptr;    ///< Pareto front CSV, stdout if not set.
+  const char *presetsPath = nullptr;  ///< Preset fragment, stdout if not set.
+};
+
+/** Weightings of time to dry, overshoot and energy in the gain search. */
+static const double objectiveWeights[][3] = {
+  { 0.34, 0.33, 0.33 },
+  { 0.6, 0.2, 0.2 },
+  { 0.2, 0.6, 0.2 },
+  { 0.2, 0.2, 0.6 },
+  { 0.45, 0.45, 0.1 },
+};
+
+/** Overshoot that the normalization treats as small, so a nearly perfect reference does not dominate. */
+static constexpr double overshootFloor = 0.5;
+
+static std::atomic<uint64_t> runCount(0);
+
+static double between(Noise &random, double low, double high) {
+  return low + (high - low) * random.uniform();
+}
+
+// Seeds of different searches and cases must not overlap, splitmix64 spreads them
+static uint64_t mixSeed(uint64_t seed, uint64_t a, uint64_t b) {
+  uint64_t x = seed ^ (a * 0x9E3779B97F4A7C15ULL) ^ (b * 0xC2B2AE3D27D4EB4FULL);
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @brief Draws a random load and environment.
+ * @param seed Seed of the case.
+ * @param material Material of the spools, nullptr for a random material at its preset.
+ * @param setpoint Setpoint in °C, ignored for a random material.
+ * @param duration Longest run time in s, ignored for a random material.
+ */
+static LoopCase randomCase(uint64_t seed, const SimMaterial *material, double setpoint, double duration) {
+  Noise random(seed);
+  if (material == nullptr) {
+    const MaterialPreset &preset = materialPresets[(size_t)(random.uniform() * _MATERIAL_COUNT)];
+    material = findSimMaterial(preset.name);
+    setpoint = preset.temperature;
+    duration = preset.hours * 3600.0 * 1.5;
+  }
+  LoopCase loopCase;
+  loopCase.name = material->material;
+  loopCase.material = material;
+  loopCase.setpoint = setpoint;
+  loopCase.duration = duration;
+  loopCase.spools = 1 + (int)(random.uniform() * 2);
+  loopCase.mass = between(random, 0.25, 1.0);
+  loopCase.moisture = material->dry * between(random, 2, 5);
+  loopCase.ambient = between(random, 10, 32);
+  loopCase.humidity = between(random, 30, 85);
+  bool door = random.uniform() < 0.3;
+  loopCase.doorOpen = door ? between(random, 1800, 5400) : -1;
+  loopCase.doorDuration = between(random, 30, 120);
+  loopCase.noise = between(random, 0.01, 0.15);
+  loopCase.seed = mixSeed(seed, 1, 0);
+  loopCase.stopWhenDry = true;
+  return loopCase;
+}
+
+/**
+ * @brief Runs every tuning on every case in the pool.
+ * @return KPIs, the runs of `gains[g]` start at `g * cases.size()`.
+ */
+static std::vector<Kpi> runBatch(WorkStealingPool &pool, const std::vector<ControlGains> &gains,
+                                 const std::vector<LoopCase> &cases) {
+  std::vector<Kpi> results(gains.size() * cases.size());
+  DryerIntegration integration;
+  for (size_t g = 0; g < gains.size(); g++) {
+    for (size_t c = 0; c < cases.size(); c++) {
+      pool.submit([&, g, c] {
+        results[g * cases.size() + c] = runClosedLoop(cases[c], gains[g], integration, nullptr);
+      });
+    }
+  }
+  pool.wait();
+  runCount += results.size();
+  return results;
+}
+
+static Objectives summarize(const Kpi *kpis, const LoopCase *cases, size_t count) {
+  Objectives objectives = {};
+  std::vector<double> dry;
+  for (size_t i = 0; i < count; i++) {
+    double minutes = kpis[i].dryMin >= 0 ? kpis[i].dryMin : 2 * cases[i].duration / 60;
+    dry.push_back(minutes);
+    objectives.dryMin += minutes / count;
+    objectives.overshootC += kpis[i].overshootC / count;
+    objectives.energyWh += kpis[i].energyWh / count;
+    objectives.maxPeakC = std::max(objectives.maxPeakC, cases[i].setpoint + kpis[i].overshootC);
+  }
+  std::sort(dry.begin(), dry.end());
+  objectives.p90DryMin = dry[std::min(dry.size() - 1, (size_t)std::ceil(0.9 * dry.size()) - 1)];
+  return objectives;
+}
+
+static std::vector<Objectives> evaluate(WorkStealingPool &pool, const std::vector<ControlGains> &gains,
+                                        const std::vector<LoopCase> &cases) {
+  std::vector<Kpi> kpis = runBatch(pool, gains, cases);
+  std::vector<Objectives> objectives;
+  for (size_t g = 0; g < gains.size(); g++) {
+    objectives.push_back(summarize(&kpis[g * cases.size()], cases.data(), cases.size()));
+  }
+  return objectives;
+}
+
+static ControlGains toGains(const std::vector<double> &logGains) {
+  return { std::pow(10, logGains[0]), std::pow(10, logGains[1]), std::pow(10, logGains[2]) };
+}
+
+static bool dominates(const Objectives &a, const Objectives &b) {
+  bool noWorse = a.dryMin <= b.dryMin && a.overshootC <= b.overshootC && a.energyWh <= b.energyWh;
+  bool better = a.dryMin < b.dryMin || a.overshootC < b.overshootC || a.energyWh < b.energyWh;
+  return noWorse && better;
+}
+
+/**
+ * @brief Stage 1: searches the PID gains and builds the Pareto front.
+ * @return Front, the knee first.
+ */
+static std::vector<FrontPoint> optimizeGains(WorkStealingPool &pool, const Options &options,
+                                             const std::vector<LoopCase> &validation) {
+  const ControlGains preset = { _PID_TEMP_KP_PRESET, _PID_TEMP_KI_PRESET, _PID_TEMP_KD_PRESET };
+  Objectives reference = evaluate(pool, { preset }, validation)[0];
+  reference.overshootC = std::max(reference.overshootC, overshootFloor);
+  fprintf(stderr, "preset gains: dry %.1f min, overshoot %.2f C, energy %.1f Wh\n", reference.dryMin,
+          reference.overshootC, reference.energyWh);
+
+  std::vector<ControlGains> elites = { preset };
+  std::vector<std::string> sources = { "preset" };
+  const size_t weightCount = sizeof(objectiveWeights) / sizeof(objectiveWeights[0]);
+  for (size_t w = 0; w < weightCount; w++) {
+    const double *weight = objectiveWeights[w];
+    Cmaes search({ std::log10(preset.kp), std::log10(preset.ki), std::log10(preset.kd) }, 0.6, { -1, -2, -2 },
+                 { 3.5, 2.5, 3.5 }, options.population, mixSeed(options.seed, 2, w));
+    for (int generation = 0; generation < options.generations; generation++) {
+      // Common random numbers: all candidates of a generation see the same cases
+      std::vector<LoopCase> cases;
+      for (int s = 0; s < options.samples; s++) {
+        cases.push_back(randomCase(mixSeed(options.seed, 3, (w << 40) | ((uint64_t)generation << 20) | s), nullptr,
+                                   0, 0));
+      }
+      std::vector<ControlGains> candidates;
+      for (const std::vector<double> &candidate : search.ask()) candidates.push_back(toGains(candidate));
+      std::vector<Objectives> results = evaluate(pool, candidates, cases);
+
+      std::vector<double> fitness;
+      for (const Objectives &result : results) {
+        fitness.push_back(weight[0] * result.dryMin / reference.dryMin +
+                          weight[1] * std::max(result.overshootC, overshootFloor) / reference.overshootC +
+                          weight[2] * result.energyWh / reference.energyWh);
+      }
+      size_t best = std::min_element(fitness.begin(), fitness.end()) - fitness.begin();
+      elites.push_back(candidates[best]);
+      sources.push_back("w" + std::to_string(w));
+      search.tell(fitness);
+      fprintf(stderr, "gains w%zu gen %2d: best %.4f kp %.3g ki %.3g kd %.3g sigma %.3f\n", w, generation,
+              fitness[best], candidates[best].kp, candidates[best].ki, candidates[best].kd, search.getSigma());
+    }
+    elites.push_back(toGains(search.getMean()));
+    sources.push_back("w" + std::to_string(w));
+  }
+
+  // The generations saw different cases, only the validation set makes the elites comparable
+  std::vector<Objectives> validated = evaluate(pool, elites, validation);
+  std::vector<FrontPoint> front;
+  for (size_t i = 0; i < elites.size(); i++) {
+    bool dominated = false;
+    for (size_t j = 0; j < elites.size() && !dominated; j++) dominated = dominates(validated[j], validated[i]);
+    if (!dominated) front.push_back({ elites[i], validated[i], sources[i] });
+  }
+
+  Objectives low = front[0].objectives, high = front[0].objectives;
+  for (const FrontPoint &point : front) {
+    low.dryMin = std::min(low.dryMin, point.objectives.dryMin);
+    low.overshootC = std::min(low.overshootC, point.objectives.overshootC);
+    low.energyWh = std::min(low.energyWh, point.objectives.energyWh);
+    high.dryMin = std::max(high.dryMin, point.objectives.dryMin);
+    high.overshootC = std::max(high.overshootC, point.objectives.overshootC);
+    high.energyWh = std::max(high.energyWh, point.objectives.energyWh);
+  }
+  auto distance = [&](const FrontPoint &point) {
+    double dry = (point.objectives.dryMin - low.dryMin) / std::max(high.dryMin - low.dryMin, 1e-9);
+    double overshoot = (point.objectives.overshootC - low.overshootC) / std::max(high.overshootC - low.overshootC, 1e-9);
+    double energy = (point.objectives.energyWh - low.energyWh) / std::max(high.energyWh - low.energyWh, 1e-9);
+    return dry * dry + overshoot * overshoot + energy * energy;
+  };
+  std::stable_sort(front.begin(), front.end(),
+                   [&](const FrontPoint &a, const FrontPoint &b) { return distance(a) < distance(b); });
+  return front;
+}
+
+/**
+ * @brief Result of the preset search for one material.
+ */
+struct PresetResult {
+  int temperature;        ///< Setpoint in °C.
+  int hours;              ///< Drying time in hours.
+  Objectives objectives;  ///< Result on the validation set.
+};
+
+static std::vector<LoopCase> materialCases(const Options &options, const SimMaterial *material, double setpoint,
+                                           double duration, uint64_t stream, uint64_t index, int count) {
+  std::vector<LoopCase> cases;
+  for (int s = 0; s < count; s++) {
+    cases.push_back(randomCase(mixSeed(options.seed, stream, (index << 20) | s), material, setpoint, duration));
+  }
+  return cases;
+}
+
+static void setSetpoint(std::vector<LoopCase> &cases, double setpoint) {
+  for (LoopCase &loopCase : cases) loopCase.setpoint = setpoint;
+}
+
+/**
+ * @brief Stage 2: searches the setpoint and drying time of one material with the chosen gains.
+ */
+static PresetResult optimizePreset(WorkStealingPool &pool, const Options &options, size_t index,
+                                   const ControlGains &gains) {
+  const MaterialPreset &preset = materialPresets[index];
+  const SimMaterial *material = findSimMaterial(preset.name);
+  // Lower setpoints dry slower, the runs end as soon as the spools are dry
+  const double duration = preset.hours * 3600.0 * 2;
+  const double lowest = preset.temperature - 10;
+  const double highest = material->limit;
+
+  std::vector<LoopCase> validation =
+    materialCases(options, material, preset.temperature, duration, 4, index, options.validation);
+  Objectives reference = evaluate(pool, { gains }, validation)[0];
+
+  Cmaes search({ std::min((double)preset.temperature, highest) }, (highest - lowest) / 4, { lowest }, { highest },
+               options.population, mixSeed(options.seed, 5, index));
+  for (int generation = 0; generation < options.generations; generation++) {
+    std::vector<LoopCase> base =
+      materialCases(options, material, 0, duration, 6, (index << 20) | generation, options.samples);
+    const std::vector<std::vector<double>> &candidates = search.ask();
+    // One batch for the whole generation, so the pool is busy even with few samples
+    std::vector<LoopCase> cases;
+    for (const std::vector<double> &candidate : candidates) {
+      setSetpoint(base, candidate[0]);
+      cases.insert(cases.end(), base.begin(), base.end());
+    }
+    std::vector<Kpi> kpis = runBatch(pool, { gains }, cases);
+    std::vector<double> fitness;
+    for (size_t c = 0; c < candidates.size(); c++) {
+      Objectives result = summarize(&kpis[c * base.size()], &cases[c * base.size()], base.size());
+      double penalty = 10 * std::max(0.0, result.maxPeakC - material->limit);
+      fitness.push_back(result.dryMin / reference.dryMin + 0.5 * result.energyWh / reference.energyWh + penalty);
+    }
+    search.tell(fitness);
+  }
+
+  // Whole degrees as in the table, lowered until the peak stays below the limit
+  PresetResult result;
+  result.temperature = (int)std::lround(search.getMean()[0]);
+  for (;;) {
+    setSetpoint(validation, result.temperature);
+    result.objectives = evaluate(pool, { gains }, validation)[0];
+    if (result.objectives.maxPeakC <= material->limit || result.temperature <= lowest) break;
+    result.temperature--;
+  }
+  result.hours = std::max(1, (int)std::ceil(result.objectives.p90DryMin / 60));
+  if (result.hours > duration / 3600) {
+    fprintf(stderr, "%s: 10 %% of the loads do not dry within %.0f h\n", preset.name, duration / 3600);
+    result.hours = (int)(duration / 3600);
+  }
+  fprintf(stderr, "%-5s %3d C -> %3d C, p90 dry %6.1f -> %6.1f min, energy %6.1f -> %6.1f Wh, peak %.1f C\n",
+          preset.name, preset.temperature, result.temperature, reference.p90DryMin, result.objectives.p90DryMin,
+          reference.energyWh, result.objectives.energyWh, result.objectives.maxPeakC);
+  return result;
+}
+
+static void writeFront(FILE *out, const std::vector<FrontPoint> &front) {
+  fprintf(out, "source,kp,ki,kd,dry_min,overshoot_c,energy_wh,p90_dry_min,knee\n");
+  for (size_t i = 0; i < front.size(); i++) {
+    const FrontPoint &point = front[i];
+    fprintf(out, "%s,%.4g,%.4g,%.4g,%.2f,%.3f,%.2f,%.2f,%d\n", point.source.c_str(), point.gains.kp, point.gains.ki,
+            point.gains.kd, point.objectives.dryMin, point.objectives.overshootC, point.objectives.energyWh,
+            point.objectives.p90DryMin, i == 0);
+  }
+}
+
+static const char *profileName(enumDryingProfile profile) {
+  switch (profile) {
+    case DRYING_GENTLE: return "DRYING_GENTLE";
+    case DRYING_HYGROSCOPIC: return "DRYING_HYGROSCOPIC";
+    default: return "DRYING_STANDARD";
+  }
+}
+
+// Same layout as globals_hx.h, so the fragment can be pasted over the definitions
+static void writePresets(FILE *out, const Options &options, const ControlGains &gains,
+                         const std::vector<PresetResult> &presets) {
+  fprintf(out, "// Generated by hx_optimize: %d generations, %d samples, %d validation cases, seed %llu\n",
+          options.generations, options.samples, options.validation, (unsigned long long)options.seed);
+  const double values[] = { gains.kp, gains.ki, gains.kd };
+  const char *const names[] = { "KP", "KI", "KD" };
+  const char *const comments[] = { "Proportional", "Integral", "Derivative" };
+  std::vector<std::string> gainDefines;
+  size_t gainWidth = 0;
+  for (size_t i = 0; i < 3; i++) {
+    char line[64];
+    snprintf(line, sizeof(line), "#define _PID_TEMP_%s_PRESET %.3g", names[i], values[i]);
+    gainDefines.push_back(line);
+    gainWidth = std::max(gainWidth, gainDefines[i].size());
+  }
+  for (size_t i = 0; i < 3; i++) {
+    fprintf(out, "%-*s  ///< %s gain for temperature control\n", (int)gainWidth, gainDefines[i].c_str(), comments[i]);
+  }
+  fprintf(out, "\n");
+
+  std::vector<std::string> defines, rows;
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    char line[128];
+    snprintf(line, sizeof(line), "#define _%s_PRESET %d", materialPresets[i].name, presets[i].temperature);
+    defines.push_back(line);
+    snprintf(line, sizeof(line), "  { \"%s\", _%s_PRESET, %d, %d, %s }%s", materialPresets[i].name,
+             materialPresets[i].name, materialPresets[i].humidity, presets[i].hours,
+             profileName(materialPresets[i].profile), i + 1 < _MATERIAL_COUNT ? "," : "");
+    rows.push_back(line);
+  }
+  size_t defineWidth = 0, rowWidth = 0;
+  for (const std::string &define : defines) defineWidth = std::max(defineWidth, define.size());
+  for (const std::string &row : rows) rowWidth = std::max(rowWidth, row.size());
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    fprintf(out, "%-*s  ///< Preset temperature for %s (°C)\n", (int)defineWidth, defines[i].c_str(),
+            materialPresets[i].name);
+  }
+  fprintf(out, "\ninline constexpr MaterialPreset materialPresets[] = {\n");
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) {
+    fprintf(out, "%-*s /**< Index %zu: %s preset. */\n", (int)rowWidth, rows[i].c_str(), i, materialPresets[i].name);
+  }
+  fprintf(out, "};\n");
+}
+
+static FILE *openOutput(const char *path) {
+  if (path == nullptr) return stdout;
+  FILE *out = fopen(path, "w");
+  if (out == nullptr) perror(path);
+  return out;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: hx_optimize [--threads n] [--generations n] [--population n] [--samples n]\n"
+                  "                   [--validation n] [--seed n] [--front file] [--presets file]\n");
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+      options.threads = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--generations") == 0 && hasValue) {
+      options.generations = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--population") == 0 && hasValue) {
+      options.population = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--samples") == 0 && hasValue) {
+      options.samples = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--validation") == 0 && hasValue) {
+      options.validation = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+      options.seed = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--front") == 0 && hasValue) {
+      options.frontPath = argv[++i];
+    } else if (strcmp(argv[i], "--presets") == 0 && hasValue) {
+      options.presetsPath = argv[++i];
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  if (options.generations < 1 || options.samples < 1 || options.validation < 1) {
+    usage();
+    return 1;
+  }
+
+  WorkStealingPool pool(options.threads);
+  auto wallStart = std::chrono::steady_clock::now();
+
+  std::vector<LoopCase> validation;
+  for (int s = 0; s < options.validation; s++) {
+    validation.push_back(randomCase(mixSeed(options.seed, 7, s), nullptr, 0, 0));
+  }
+  std::vector<FrontPoint> front = optimizeGains(pool, options, validation);
+  const ControlGains &knee = front[0].gains;
+  fprintf(stderr, "knee: kp %.3g ki %.3g kd %.3g, dry %.1f min, overshoot %.2f C, energy %.1f Wh\n", knee.kp,
+          knee.ki, knee.kd, front[0].objectives.dryMin, front[0].objectives.overshootC, front[0].objectives.energyWh);
+
+  std::vector<PresetResult> presets;
+  for (size_t i = 0; i < _MATERIAL_COUNT; i++) presets.push_back(optimizePreset(pool, options, i, knee));
+
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  fprintf(stderr, "%llu runs in %.1f s on %zu threads: %.1f runs/s, %.1f runs/s per thread, %llu steals\n",
+          (unsigned long long)runCount.load(), wallSeconds, pool.size(), runCount / wallSeconds,
+          runCount / wallSeconds / pool.size(), (unsigned long long)pool.getSteals());
+
+  FILE *frontOut = openOutput(options.frontPath);
+  FILE *presetsOut = openOutput(options.presetsPath);
+  if (frontOut == nullptr || presetsOut == nullptr) {
+    return 1;
+  }
+  writeFront(frontOut, front);
+  if (frontOut == stdout && presetsOut == stdout) fprintf(stdout, "\n");
+  writePresets(presetsOut, options, knee, presets);
+  if (frontOut != stdout) fclose(frontOut);
+  if (presetsOut != stdout) fclose(presetsOut);
+  return 0;
+}
@@ -0,0 +1,275 @@
+/**
+ * @file hx_sim.cpp
+ * @brief Closed-loop simulation of the heater control with KPI regression checks.
+ * @details Runs the firmware `HeatingController` with the real PID, the fan off-delays and the
+ *          Kalman filter of the sensor fusion against the dryer model in `dryer_model.h`.
+ *          Every scenario pairs a material preset with one or more spools, an ambient
+ *          temperature and humidity, an optional door opening and sensor noise, and runs for
+ *          the drying time of the preset. The control is measured by these KPIs:
+ *          - `rise_s`: time from 10 % to 90 % of the step to the setpoint
+ *          - `overshoot_c`: largest temperature above the setpoint before the door opens
+ *          - `settling_s`: time until the temperature stays inside the hold band
+ *          - `recovery_s`: time after the door closed until the temperature is back in the band
+ *          - `rms_c`: RMS control error in the second half of the run, without the door disturbance
+ *          - `energy_wh`: electrical energy of the heater
+ *          - `dry_min`: time until the mean moisture of the spools is down to the dry moisture
+ *            of the material
+ *
+ *          A time that is never reached is reported as -1. The hold band is the one of the
+ *          sensor profile manager, `_PROFILE_HOLD_BAND`. With `--compare` every KPI is checked
+ *          against a previous result file; a KPI regresses if it is worse than the baseline by
+ *          more than the tolerance in percent plus a small absolute slack, and the exit code is
+ *          then 2. A scenario or KPI missing from the baseline counts as a regression, an
+ *          unreadable or empty baseline file ends the check with exit code 1.
+ *
+ *          The closed loop itself is in `closed_loop.h`. The model is integrated with the
+ *          adaptive method unless `--integrator fixed` is given; the speed against real time is
+ *          printed to stderr.
+ *
+ * ### Example Usage
+ * ```sh
+ * hx_sim --csv baseline.csv
+ * # ... change the tuning or the firmware, rebuild ...
+ * hx_sim --compare baseline.csv --tolerance 5
+ * hx_sim --filter door --trace door.csv   # time series for plotting
+ * hx_sim --integrator fixed               # cross-check of the adaptive integrator
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Multi-node dryer model with spools, moisture diffusion and vent air
+ * - **2026-10-19**: Closed loop moved to `closed_loop.cpp`, shared with `hx_optimize`
+ * - **2026-10-19**: Unreadable baselines and missing KPIs fail the comparison
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "closed_loop.h"
+
+#include "globals_hx.h"
+
+/**
+ * @brief Closed-loop test case.
+ */
+struct Scenario {
+  const char *name;      ///< Scenario name.
+  const char *material;  ///< Material preset that sets the setpoint and the duration.
+  int spools;            ///< Number of spools.
+  double mass;           ///< Filament mass per spool in kg.
+  double moisture;       ///< Initial moisture of the spools in %.
+  double ambient;        ///< Ambient temperature in °C.
+  double humidity;       ///< Ambient relative humidity in %.
+  double doorOpen;       ///< Time the door opens in s, negative for a closed door.
+  double doorDuration;   ///< Time the door stays open in s.
+  double noise;          ///< Standard deviation of the sensor noise in °C.
+};
+
+static const Scenario scenarios[] = {
+  { "pla_1kg", "PLA", 1, 1.0, 0.4, 22, 50, -1, 0, 0.02 },
+  { "petg_1kg", "PETG", 1, 1.0, 0.35, 22, 50, -1, 0, 0.02 },
+  { "petg_4x1kg_humid", "PETG", 4, 1.0, 0.45, 25, 80, -1, 0, 0.02 },
+  { "abs_2kg_cold", "ABS", 1, 2.0, 0.5, 10, 50, -1, 0, 0.02 },
+  { "pa_1kg_wet", "PA", 1, 1.0, 2.5, 22, 60, -1, 0, 0.02 },
+  { "pc_1kg_warm", "PC", 1, 1.0, 0.3, 32, 40, -1, 0, 0.02 },
+  { "tpu_half", "TPU", 1, 0.5, 0.8, 22, 50, -1, 0, 0.02 },
+  { "petg_door", "PETG", 1, 1.0, 0.35, 22, 50, 3600, 60, 0.02 },
+  { "pla_noisy", "PLA", 1, 1.0, 0.4, 22, 50, -1, 0, 0.15 },
+};
+
+/**
+ * @brief KPI column of the result file.
+ */
+struct KpiColumn {
+  const char *name;    ///< Column name.
+  double Kpi::*value;  ///< KPI field.
+  double slack;        ///< Absolute change that always passes, in the unit of the KPI.
+};
+
+static const KpiColumn kpiColumns[] = {
+  { "rise_s", &Kpi::riseS, 5 },
+  { "overshoot_c", &Kpi::overshootC, 0.1 },
+  { "settling_s", &Kpi::settlingS, 10 },
+  { "recovery_s", &Kpi::recoveryS, 10 },
+  { "rms_c", &Kpi::rmsC, 0.01 },
+  { "energy_wh", &Kpi::energyWh, 0.5 },
+  { "dry_min", &Kpi::dryMin, 1 },
+};
+
+static Kpi runScenario(const Scenario &scenario, const DryerIntegration &integration, FILE *trace) {
+  const MaterialPreset &preset = materialPresets[findMaterialPreset(scenario.material)];
+  LoopCase loopCase = { scenario.name, findSimMaterial(scenario.material), (double)preset.temperature,
+                        preset.hours * 3600.0, scenario.spools, scenario.mass, scenario.moisture,
+                        scenario.ambient, scenario.humidity, scenario.doorOpen, scenario.doorDuration,
+                        scenario.noise, seedOf(scenario.name), false };
+  ControlGains gains = { _PID_TEMP_KP_PRESET, _PID_TEMP_KI_PRESET, _PID_TEMP_KD_PRESET };
+
+  auto wallStart = std::chrono::steady_clock::now();
+  Kpi kpi = runClosedLoop(loopCase, gains, integration, trace);
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  fprintf(stderr, "%-18s %6.0f s in %6.3f s, %8.0fx real time\n", scenario.name, loopCase.duration, wallSeconds,
+          loopCase.duration / wallSeconds);
+  return kpi;
+}
+
+static void writeCsv(FILE *out, const std::vector<Kpi> &results) {
+  fprintf(out, "scenario");
+  for (const KpiColumn &column : kpiColumns) fprintf(out, ",%s", column.name);
+  fprintf(out, "\n");
+  for (const Kpi &kpi : results) {
+    fprintf(out, "%s", kpi.name.c_str());
+    for (const KpiColumn &column : kpiColumns) fprintf(out, ",%.3f", kpi.*column.value);
+    fprintf(out, "\n");
+  }
+}
+
+// Reads a file written by writeCsv(), the columns are matched by name; false if unreadable
+static bool readCsv(const char *path, std::map<std::string, std::map<std::string, double>> &rows) {
+  FILE *in = fopen(path, "r");
+  if (in == nullptr) {
+    perror(path);
+    return false;
+  }
+  std::vector<std::string> header;
+  char line[512];
+  while (fgets(line, sizeof(line), in) != nullptr) {
+    line[strcspn(line, "\r\n")] = '\0';
+    std::vector<std::string> fields;
+    for (char *field = strtok(line, ","); field != nullptr; field = strtok(nullptr, ",")) {
+      fields.push_back(field);
+    }
+    if (header.empty()) {
+      header = fields;
+      continue;
+    }
+    for (size_t i = 1; i < fields.size() && i < header.size(); i++) {
+      rows[fields[0]][header[i]] = atof(fields[i].c_str());
+    }
+  }
+  fclose(in);
+  if (rows.empty()) {
+    fprintf(stderr, "%s: no results\n", path);
+    return false;
+  }
+  return true;
+}
+
+// A time of -1 was never reached and is worse than every reached time
+static bool regressed(double baseline, double value, double tolerance, double slack) {
+  if (baseline < 0) return false;
+  if (value < 0) return true;
+  return value > baseline * (1 + tolerance / 100) + slack;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: hx_sim [--filter text] [--csv file] [--trace file] [--integrator fixed|adaptive]\n"
+                  "              [--compare baseline.csv] [--tolerance percent]\n");
+}
+
+int main(int argc, char **argv) {
+  const char *filter = nullptr;
+  const char *csvPath = nullptr;
+  const char *tracePath = nullptr;
+  const char *baselinePath = nullptr;
+  double tolerance = 5;
+  DryerIntegration integration;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--csv") == 0 && hasValue) {
+      csvPath = argv[++i];
+    } else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+      tracePath = argv[++i];
+    } else if (strcmp(argv[i], "--compare") == 0 && hasValue) {
+      baselinePath = argv[++i];
+    } else if (strcmp(argv[i], "--tolerance") == 0 && hasValue) {
+      tolerance = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--integrator") == 0 && hasValue) {
+      // The fixed method steps once per sensor sample
+      integration.method = strcmp(argv[++i], "fixed") == 0 ? INTEGRATOR_FIXED : INTEGRATOR_ADAPTIVE;
+      integration.fixedStep = simSamplePeriod;
+    } else {
+      usage();
+      return 1;
+    }
+  }
+
+  FILE *trace = nullptr;
+  if (tracePath != nullptr) {
+    trace = fopen(tracePath, "w");
+    if (trace == nullptr) {
+      perror(tracePath);
+      return 1;
+    }
+    writeTraceHeader(trace);
+  }
+
+  std::vector<Kpi> results;
+  for (const Scenario &scenario : scenarios) {
+    if (filter == nullptr || strstr(scenario.name, filter) != nullptr) {
+      results.push_back(runScenario(scenario, integration, trace));
+    }
+  }
+  if (trace != nullptr) {
+    fclose(trace);
+  }
+
+  writeCsv(stdout, results);
+  if (csvPath != nullptr) {
+    FILE *out = fopen(csvPath, "w");
+    if (out == nullptr) {
+      perror(csvPath);
+      return 1;
+    }
+    writeCsv(out, results);
+    fclose(out);
+  }
+
+  if (baselinePath == nullptr) {
+    return 0;
+  }
+  std::map<std::string, std::map<std::string, double>> baseline;
+  if (!readCsv(baselinePath, baseline)) {
+    return 1;
+  }
+  // A scenario or KPI without a baseline is not checked, so it fails the gate until the baseline is updated
+  int regressions = 0;
+  for (const Kpi &kpi : results) {
+    auto row = baseline.find(kpi.name);
+    if (row == baseline.end()) {
+      fprintf(stderr, "%-18s (no baseline)  REGRESSION\n", kpi.name.c_str());
+      regressions++;
+      continue;
+    }
+    for (const KpiColumn &column : kpiColumns) {
+      auto entry = row->second.find(column.name);
+      if (entry == row->second.end()) {
+        fprintf(stderr, "%-18s %-12s (no baseline)  REGRESSION\n", kpi.name.c_str(), column.name);
+        regressions++;
+        continue;
+      }
+      double value = kpi.*column.value;
+      bool worse = regressed(entry->second, value, tolerance, column.slack);
+      regressions += worse;
+      fprintf(stderr, "%-18s %-12s %10.3f %10.3f%s\n", kpi.name.c_str(), column.name, entry->second,
+              value, worse ? "  REGRESSION" : "");
+    }
+  }
+  return regressions > 0 ? 2 : 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool for the host tools.
+ * @details Every worker has its own task deque. Submitted tasks are spread round-robin over
+ *          the deques; a worker takes the newest task of its own deque and, when that is empty,
+ *          steals the oldest task of another worker. Long and short tasks therefore balance out
+ *          without a shared queue that all threads contend for.
+ *
+ * ### Example Usage
+ * ```cpp
+ * WorkStealingPool pool;
+ * std::vector<Kpi> results(runs);
+ * for (size_t i = 0; i < runs; i++) {
+ *   pool.submit([&, i] { results[i] = runClosedLoop(cases[i], gains, integration, nullptr); });
+ * }
+ * pool.wait();
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread pool with one task deque per worker and stealing between them.
+ */
+class WorkStealingPool {
+private:
+  typedef std::function<void()> Task;
+
+  /**
+   * @brief Task deque of one worker.
+   */
+  struct Worker {
+    std::mutex mutex;        ///< Guards `tasks`.
+    std::deque<Task> tasks;  ///< Own tasks, newest at the back.
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers; /**< Deques, one per thread. */
+  std::vector<std::thread> threads;             /**< Worker threads. */
+  std::mutex stateMutex;                        /**< Guards sleeping and waking. */
+  std::condition_variable wake;                 /**< Signals new tasks or the shutdown. */
+  std::condition_variable idle;                 /**< Signals that all tasks are done. */
+  std::atomic<long> queued;                     /**< Tasks in the deques, -1 while a push races a take. */
+  std::atomic<size_t> pending;                  /**< Tasks submitted and not finished. */
+  std::atomic<size_t> nextWorker;               /**< Round-robin index of `submit()`. */
+  std::atomic<uint64_t> steals;                 /**< Tasks taken from another worker. */
+  bool stopping;                                /**< True while the pool shuts down. */
+
+  bool take(size_t self, Task &task) {
+    {
+      std::lock_guard<std::mutex> lock(workers[self]->mutex);
+      if (!workers[self]->tasks.empty()) {
+        task = std::move(workers[self]->tasks.back());
+        workers[self]->tasks.pop_back();
+        queued--;
+        return true;
+      }
+    }
+    for (size_t i = 1; i < workers.size(); i++) {
+      Worker &victim = *workers[(self + i) % workers.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued--;
+        steals++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(size_t self) {
+    for (;;) {
+      Task task;
+      if (take(self, task)) {
+        task();
+        if (--pending == 0) {
+          std::lock_guard<std::mutex> lock(stateMutex);
+          idle.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(stateMutex);
+      wake.wait(lock, [this] { return stopping || queued > 0; });
+      if (stopping && queued == 0) {
+        return;
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Constructor: starts the workers.
+   * @param threadCount Number of threads, 0 for one per hardware thread.
+   */
+  explicit WorkStealingPool(size_t threadCount = 0)
+    : queued(0), pending(0), nextWorker(0), steals(0), stopping(false) {
+    if (threadCount == 0) {
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+      workers.emplace_back(new Worker());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+      threads.emplace_back(&WorkStealingPool::run, this, i);
+    }
+  }
+
+  /**
+   * @brief Destructor: finishes the queued tasks and joins the workers.
+   */
+  ~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &thread : threads) thread.join();
+  }
+
+  /**
+   * @brief Queues a task.
+   * @param task Function to run on a worker.
+   */
+  void submit(Task task) {
+    pending++;
+    Worker &worker = *workers[nextWorker++ % workers.size()];
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.tasks.push_back(std::move(task));
+    }
+    std::lock_guard<std::mutex> lock(stateMutex);
+    queued++;
+    wake.notify_one();
+  }
+
+  /**
+   * @brief Blocks until all submitted tasks are finished.
+   */
+  void wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    idle.wait(lock, [this] { return pending == 0; });
+  }
+
+  /**
+   * @brief Gets the number of worker threads.
+   * @return Number of threads.
+   */
+  size_t size() const {
+    return threads.size();
+  }
+
+  /**
+   * @brief Gets the number of tasks a worker took from another worker.
+   * @return Steals since construction.
+   */
+  uint64_t getSteals() const {
+    return steals;
+  }
+};
+
+
+#endif  // THREAD_POOL_H
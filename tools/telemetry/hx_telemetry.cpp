@@ -0,0 +1,92 @@
+/**
+ * @file hx_telemetry.cpp
+ * @brief Command line tool that converts the heatX telemetry stream to CSV.
+ * @details Reads the binary stream from a file, a serial device or stdin and prints one CSV
+ *          line per control message. Latency and I2C messages and, at the end, the counters of
+ *          the decoder are printed to stderr.
+ *
+ * ### Example Usage
+ * ```sh
+ * stty -F /dev/ttyACM0 115200 raw
+ * hx_telemetry /dev/ttyACM0 > run.csv
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Latency messages printed to stderr
+ * - **2026-10-19**: I2C error counters printed to stderr
+ * - **2026-10-19**: Reconnects of the board counted
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <cstdio>
+
+#include "telemetry_decoder.h"
+
+int main(int argc, char **argv) {
+  FILE *input = stdin;
+  if (argc > 1) {
+    input = fopen(argv[1], "rb");
+    if (input == nullptr) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+
+  printf("time_ms,sequence,setpoint,temperature,rate,humidity,duty,running,heating,fan,sensor,profile\n");
+  TelemetryDecoder decoder([](const TelemetryHeader &header, const uint8_t *message, size_t length) {
+    TelemetryLatency statistics;
+    if (TelemetryDecoder::parse(header, message, length, TELEMETRY_LATENCY, statistics)) {
+      static const char *const channels[] = { "loop", "pid", "output", "i2c" };
+      fprintf(stderr, "latency %s: count %u, p50 %u us, p99 %u us, max %u us, deadline misses %u\n",
+              statistics.channel < 4 ? channels[statistics.channel] : "unknown", statistics.count,
+              statistics.p50, statistics.p99, statistics.max, statistics.deadlineMisses);
+      return;
+    }
+
+    TelemetryI2c bus;
+    if (TelemetryDecoder::parse(header, message, length, TELEMETRY_I2C, bus)) {
+      fprintf(stderr, "i2c 0x%02X%s: %u transactions, nack address %u, nack data %u, bus %u, timeout %u, "
+              "read %u, skipped %u, length %u; %u bus recoveries\n",
+              bus.address, bus.faulted ? " (bus faulted)" : "", bus.transactions, bus.errors[1], bus.errors[2],
+              bus.errors[3], bus.errors[4], bus.errors[5], bus.errors[6], bus.errors[0], bus.recoveries);
+      return;
+    }
+
+    TelemetryControl control;
+    if (!TelemetryDecoder::parse(header, message, length, TELEMETRY_CONTROL, control)) {
+      return;
+    }
+    printf("%u,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d,%d,%d,%u\n",
+           control.time, header.sequence,
+           control.setpoint / 100.0, control.temperature / 100.0, control.rate / 100.0,
+           control.humidity / 100.0, control.duty / 100.0,
+           (control.flags & TELEMETRY_FLAG_RUNNING) != 0, (control.flags & TELEMETRY_FLAG_HEATING) != 0,
+           (control.flags & TELEMETRY_FLAG_FAN) != 0, (control.flags & TELEMETRY_FLAG_SENSOR) != 0,
+           control.profile);
+  });
+
+  uint8_t buffer[4096];
+  size_t count;
+  while ((count = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+    decoder.feed(buffer, count);
+  }
+
+  const TelemetryStats &stats = decoder.stats();
+  fprintf(stderr, "frames %llu, lost %llu, reconnects %llu, crc errors %llu, malformed %llu, unknown version %llu\n",
+          (unsigned long long)stats.frames, (unsigned long long)stats.lost, (unsigned long long)stats.resets,
+          (unsigned long long)stats.crcErrors, (unsigned long long)stats.malformed,
+          (unsigned long long)stats.versionErrors);
+  if (input != stdin) {
+    fclose(input);
+  }
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file telemetry_decoder.cpp
+ * @brief Implementation of the host-side telemetry decoder.
+ * @details Contains the frame splitting, the CRC check and the loss detection of
+ *          `TelemetryDecoder`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: Frames decoded in place
+ * - **2026-10-19**: Reconnect detection
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include "telemetry_decoder.h"
+
+#include <cstring>
+
+TelemetryDecoder::TelemetryDecoder(Handler handler)
+  : handler(std::move(handler)), overflow(false), synced(false), nextSequence(0) {
+  frame.reserve(TELEMETRY_FRAME_MAX);
+}
+
+void TelemetryDecoder::feed(const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    if (data[i] != 0) {
+      if (frame.size() < TELEMETRY_FRAME_MAX) {
+        frame.push_back(data[i]);
+      } else {
+        overflow = true;
+      }
+      continue;
+    }
+
+    if (overflow) {
+      counters.malformed++;
+    } else {
+      decodeFrame(frame.data(), frame.size());
+    }
+    frame.clear();
+    overflow = false;
+  }
+}
+
+void TelemetryDecoder::decodeFrame(const uint8_t *encoded, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  if (length > TELEMETRY_FRAME_MAX) {
+    counters.malformed++;
+    return;
+  }
+  uint8_t payload[TELEMETRY_FRAME_MAX];
+  size_t size = cobsDecode(encoded, length, payload, sizeof(payload));
+  if (size < sizeof(TelemetryHeader) + sizeof(uint16_t)) {
+    counters.malformed++;
+    return;
+  }
+
+  size -= sizeof(uint16_t);
+  uint16_t crc = payload[size] | (payload[size + 1] << 8);
+  if (telemetryCrc16(payload, size) != crc) {
+    counters.crcErrors++;
+    return;
+  }
+
+  TelemetryHeader header;
+  memcpy(&header, payload, sizeof(header));
+  if (header.version != TELEMETRY_VERSION) {
+    counters.versionErrors++;
+    return;
+  }
+
+  if (synced) {
+    uint16_t gap = header.sequence - nextSequence;
+    // The serial line does not reorder frames, a step back or a jump to the start is a reboot
+    if (gap >= 0x8000 || (header.sequence < resetWindow && gap >= resetWindow)) {
+      counters.resets++;
+    } else {
+      counters.lost += gap;
+    }
+  }
+  synced = true;
+  nextSequence = header.sequence + 1;
+  counters.frames++;
+
+  handler(header, payload + sizeof(header), size - sizeof(header));
+}
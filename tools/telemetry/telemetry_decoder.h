@@ -0,0 +1,135 @@
+/**
+ * @file telemetry_decoder.h
+ * @brief Host-side decoder of the heatX telemetry stream.
+ * @details This file contains the `TelemetryDecoder` class, which splits a byte stream into
+ *          frames, checks them and passes the messages to a handler. The wire format is
+ *          defined in `src/telemetry_protocol_hx.h`.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: `decodeFrame()` for frames split by the caller
+ * - **2026-10-19**: Sequence restarts counted as reconnects instead of lost frames
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef TELEMETRY_DECODER_H
+#define TELEMETRY_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "telemetry_protocol_hx.h"
+
+/**
+ * @brief Counters of the decoder.
+ */
+struct TelemetryStats {
+  uint64_t frames = 0;         ///< Valid frames.
+  uint64_t crcErrors = 0;      ///< Frames with a wrong CRC.
+  uint64_t malformed = 0;      ///< Frames with invalid COBS coding or size, e.g. text between frames.
+  uint64_t versionErrors = 0;  ///< Frames of an unknown schema version.
+  uint64_t lost = 0;           ///< Frames missing according to the sequence numbers.
+  uint64_t resets = 0;         ///< Restarts of the sequence numbers, e.g. a reboot of the board.
+};
+
+/**
+ * @brief Streaming decoder of telemetry frames.
+ * @details Bytes can be fed in chunks of any size. A frame ends at a zero byte; empty frames
+ *          are skipped. Valid messages are passed to the handler with their header. The
+ *          decoder assumes a little-endian host, like the firmware.
+ *
+ *          The board starts the sequence numbers at 0 on every boot. A frame that goes back in
+ *          the sequence, or jumps to a number below `resetWindow` from far away, is counted as a
+ *          reconnect and starts a new sequence instead of adding some 65000 lost frames.
+ *
+ * ### Example Usage
+ * ```cpp
+ * TelemetryDecoder decoder([](const TelemetryHeader &header, const uint8_t *message, size_t length) {
+ *   TelemetryControl control;
+ *   if (TelemetryDecoder::parse(header, message, length, TELEMETRY_CONTROL, control)) {
+ *     printf("%.2f\n", control.temperature / 100.0);
+ *   }
+ * });
+ * decoder.feed(bytes, count);
+ * ```
+ */
+class TelemetryDecoder {
+public:
+  /**
+   * @brief Handler of a decoded message.
+   */
+  using Handler = std::function<void(const TelemetryHeader &header, const uint8_t *message, size_t length)>;
+
+  /**
+   * @brief Constructor: Initializes the decoder.
+   * @param handler Called for every valid message.
+   */
+  explicit TelemetryDecoder(Handler handler);
+
+  /**
+   * @brief Decodes a chunk of the stream.
+   * @param data Received bytes.
+   * @param length Number of bytes.
+   */
+  void feed(const uint8_t *data, size_t length);
+
+  /**
+   * @brief Decodes one frame that the caller has split from the stream, e.g. a memory-mapped file.
+   * @details Same as feeding the frame with its closing delimiter, without copying it.
+   * @param encoded Encoded bytes between two zero bytes.
+   * @param length Number of encoded bytes, 0 is ignored.
+   */
+  void decodeFrame(const uint8_t *encoded, size_t length);
+
+  /**
+   * @brief Gets the counters.
+   * @return Counters since construction.
+   */
+  const TelemetryStats &stats() const {
+    return counters;
+  }
+
+  /**
+   * @brief Copies a message into its struct if the type and size match.
+   * @param header Header passed to the handler.
+   * @param message Message bytes passed to the handler.
+   * @param length Message size passed to the handler.
+   * @param type Expected message type.
+   * @param out Destination struct.
+   * @return true if the message has the expected type and size.
+   */
+  template<typename T>
+  static bool parse(const TelemetryHeader &header, const uint8_t *message, size_t length,
+                    enumTelemetryType type, T &out) {
+    if (header.type != type || length != sizeof(T)) {
+      return false;
+    }
+    memcpy(&out, message, sizeof(T));
+    return true;
+  }
+
+  /** Sequence numbers below this after a jump mark a reboot of the board. */
+  static constexpr uint16_t resetWindow = 256;
+
+private:
+  Handler handler;             /**< Message handler. */
+  std::vector<uint8_t> frame;  /**< Encoded bytes of the current frame. */
+  bool overflow;               /**< True if the current frame is too long. */
+  bool synced;                 /**< True after the first valid frame. */
+  uint16_t nextSequence;       /**< Expected sequence number. */
+  TelemetryStats counters;     /**< Counters. */
+};
+
+
+#endif  // TELEMETRY_DECODER_H
@@ -0,0 +1,203 @@
+/**
+ * @file telemetry_test.cpp
+ * @brief Host test of the telemetry framing and of `TelemetryDecoder`.
+ * @details Frames are built like `Telemetry::send()` builds them: header, message and CRC-16,
+ *          COBS encoded between zero bytes. The test checks the CRC against its reference
+ *          value, the COBS round trip at the block boundaries, the decoding of a stream fed in
+ *          odd chunks, corrupted and malformed frames and the loss and reconnect counting of
+ *          the sequence numbers.
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "../test/check.h"
+#include "telemetry_decoder.h"
+
+/**
+ * @brief Builds one delimited frame like `Telemetry::send()`.
+ * @param sequence Sequence number of the frame.
+ * @param control Message of the frame.
+ * @return Zero byte, encoded frame, zero byte.
+ */
+static std::vector<uint8_t> buildFrame(uint16_t sequence, const TelemetryControl &control) {
+  uint8_t payload[TELEMETRY_PAYLOAD_MAX];
+  TelemetryHeader header = { TELEMETRY_VERSION, TELEMETRY_CONTROL, sequence };
+  memcpy(payload, &header, sizeof(header));
+  memcpy(payload + sizeof(header), &control, sizeof(control));
+  size_t size = sizeof(header) + sizeof(control);
+  uint16_t crc = telemetryCrc16(payload, size);
+  payload[size++] = crc & 0xFF;
+  payload[size++] = crc >> 8;
+
+  std::vector<uint8_t> frame(TELEMETRY_FRAME_MAX + 2);
+  frame[0] = 0;
+  size_t length = cobsEncode(payload, size, &frame[1]) + 1;
+  frame[length++] = 0;
+  frame.resize(length);
+  return frame;
+}
+
+static TelemetryControl makeControl(uint32_t time) {
+  TelemetryControl control = {};
+  control.time = time;
+  control.temperature = 5000 + (int32_t)(time % 7) - 3;  // Zero bytes in the message on purpose
+  control.flags = TELEMETRY_FLAG_RUNNING;
+  return control;
+}
+
+static void testCrc() {
+  const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  HX_CHECK(telemetryCrc16(check, sizeof(check)) == 0x29B1);  // CRC-16/CCITT-FALSE check value
+  HX_CHECK(telemetryCrc16(check + 4, 5, telemetryCrc16(check, 4)) == 0x29B1);
+}
+
+static void testCobs() {
+  // Lengths around the 254-byte block of COBS, with and without zero bytes
+  const size_t lengths[] = { 0, 1, 2, 253, 254, 255, 256, 508, 509, 600 };
+  for (size_t length : lengths) {
+    for (int pattern = 0; pattern < 3; pattern++) {
+      std::vector<uint8_t> input(length);
+      for (size_t i = 0; i < length; i++) {
+        input[i] = pattern == 0 ? 0 : pattern == 1 ? (uint8_t)(i % 255 + 1) : (uint8_t)(i * 37 % 5);
+      }
+      std::vector<uint8_t> encoded(length + length / 254 + 1);
+      size_t size = cobsEncode(input.data(), length, encoded.data());
+      HX_CHECK(size <= encoded.size());
+      HX_CHECK(memchr(encoded.data(), 0, size) == nullptr);
+
+      std::vector<uint8_t> decoded(length + 1);
+      size_t got = cobsDecode(encoded.data(), size, decoded.data(), decoded.size());
+      HX_CHECK(got == length);
+      HX_CHECK(memcmp(decoded.data(), input.data(), length) == 0);
+    }
+  }
+
+  // A code byte pointing past the end and an output that does not fit are rejected
+  const uint8_t truncated[] = { 0x05, 0x11, 0x22 };
+  uint8_t output[16];
+  HX_CHECK(cobsDecode(truncated, sizeof(truncated), output, sizeof(output)) == 0);
+  const uint8_t valid[] = { 0x04, 0x11, 0x22, 0x33 };
+  HX_CHECK(cobsDecode(valid, sizeof(valid), output, 2) == 0);
+}
+
+static void testStream() {
+  std::vector<TelemetryControl> received;
+  std::vector<uint16_t> sequences;
+  TelemetryDecoder decoder([&](const TelemetryHeader &header, const uint8_t *message, size_t length) {
+    TelemetryControl control;
+    if (TelemetryDecoder::parse(header, message, length, TELEMETRY_CONTROL, control)) {
+      received.push_back(control);
+      sequences.push_back(header.sequence);
+    }
+  });
+
+  std::vector<uint8_t> stream;
+  for (uint16_t i = 0; i < 20; i++) {
+    std::vector<uint8_t> frame = buildFrame(i, makeControl(i * 20));
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+  // Chunks of 1 to 7 bytes cut the frames at every position
+  for (size_t offset = 0, chunk = 1; offset < stream.size(); offset += chunk, chunk = chunk % 7 + 1) {
+    decoder.feed(&stream[offset], std::min(chunk, stream.size() - offset));
+  }
+  HX_CHECK(received.size() == 20);
+  HX_CHECK(decoder.stats().frames == 20);
+  HX_CHECK(decoder.stats().lost == 0);
+  HX_CHECK(decoder.stats().crcErrors == 0);
+  for (size_t i = 0; i < received.size(); i++) {
+    TelemetryControl expected = makeControl(i * 20);
+    HX_CHECK(memcmp(&received[i], &expected, sizeof(expected)) == 0);
+    HX_CHECK(sequences[i] == i);
+  }
+}
+
+static void testCorruption() {
+  size_t messages = 0;
+  TelemetryDecoder decoder([&](const TelemetryHeader &, const uint8_t *, size_t) { messages++; });
+
+  std::vector<uint8_t> good = buildFrame(0, makeControl(0));
+  decoder.feed(good.data(), good.size());
+
+  // A flipped bit fails the CRC; the frame is dropped and counted as lost after the next one
+  std::vector<uint8_t> corrupted = buildFrame(1, makeControl(20));
+  corrupted[corrupted.size() / 2] ^= 0x10;
+  if (corrupted[corrupted.size() / 2] == 0) corrupted[corrupted.size() / 2] = 0x10;
+  decoder.feed(corrupted.data(), corrupted.size());
+  HX_CHECK(decoder.stats().crcErrors + decoder.stats().malformed == 1);
+  HX_CHECK(messages == 1);
+
+  // Text of the boot messages between frames is malformed, the next frame decodes
+  const char text[] = "Terminal on\n";
+  decoder.feed((const uint8_t *)text, sizeof(text));
+  HX_CHECK(decoder.stats().malformed + decoder.stats().crcErrors == 2);
+
+  std::vector<uint8_t> next = buildFrame(2, makeControl(40));
+  decoder.feed(next.data(), next.size());
+  HX_CHECK(messages == 2);
+  HX_CHECK(decoder.stats().frames == 2);
+  HX_CHECK(decoder.stats().lost == 1);
+
+  // A frame longer than the maximum is dropped without reaching the handler
+  std::vector<uint8_t> overlong(TELEMETRY_FRAME_MAX + 10, 0x01);
+  overlong.push_back(0);
+  decoder.feed(overlong.data(), overlong.size());
+  HX_CHECK(messages == 2);
+}
+
+/**
+ * @brief Decodes frames with the given sequence numbers.
+ * @param sequences Sequence numbers in the order of the stream.
+ * @return Counters of the decoder.
+ */
+static TelemetryStats decodeSequence(const std::vector<uint16_t> &sequences) {
+  TelemetryDecoder decoder([](const TelemetryHeader &, const uint8_t *, size_t) {});
+  for (uint16_t sequence : sequences) {
+    std::vector<uint8_t> frame = buildFrame(sequence, makeControl(sequence));
+    decoder.feed(frame.data(), frame.size());
+  }
+  return decoder.stats();
+}
+
+static void testSequence() {
+  // 101 to 103 lost
+  TelemetryStats stats = decodeSequence({ 100, 104, 105 });
+  HX_CHECK(stats.lost == 3 && stats.resets == 0);
+
+  // The counter wraps: 65535 and 0 are lost, no reconnect
+  stats = decodeSequence({ 65533, 65534, 1, 2 });
+  HX_CHECK(stats.lost == 2 && stats.resets == 0);
+
+  // A reboot far into the sequence starts again at 0 or shortly after
+  stats = decodeSequence({ 40000, 40001, 0, 1 });
+  HX_CHECK(stats.lost == 0 && stats.resets == 1);
+  stats = decodeSequence({ 40000, 40001, 3, 4 });
+  HX_CHECK(stats.lost == 0 && stats.resets == 1);
+
+  // A reboot shortly after the previous one steps back
+  stats = decodeSequence({ 0, 1, 30, 0, 1 });
+  HX_CHECK(stats.lost == 28 && stats.resets == 1);
+  HX_CHECK(stats.frames == 5);
+}
+
+int main() {
+  testCrc();
+  testCobs();
+  testStream();
+  testCorruption();
+  testSequence();
+  return checkResult("telemetry_test");
+}
@@ -0,0 +1,81 @@
+/**
+ * @file check.h
+ * @brief Minimal assertion harness for the host tests of the tools.
+ * @details `HX_CHECK` reports a failed condition with its location and continues, so one run
+ *          lists every failure. `checkResult()` prints the summary and gives the exit code that
+ *          `ctest` expects.
+ *
+ * ### Example Usage
+ * ```cpp
+ * int main() {
+ *   HX_CHECK(cobsDecode(encoded, length, decoded, sizeof(decoded)) == sizeof(payload));
+ *   return checkResult("telemetry");
+ * }
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+
+/**
+ * @brief Counters of the checks of one test program.
+ */
+struct CheckCounters {
+  unsigned passed = 0;  ///< Conditions that held.
+  unsigned failed = 0;  ///< Conditions that failed.
+};
+
+/**
+ * @brief Gets the counters of the test program.
+ * @return Counters shared by all checks.
+ */
+inline CheckCounters &checkCounters() {
+  static CheckCounters counters;
+  return counters;
+}
+
+/**
+ * @brief Records the outcome of a check and reports a failure.
+ * @param ok Outcome of the condition.
+ * @param condition Source text of the condition.
+ * @param file Source file.
+ * @param line Source line.
+ */
+inline void checkRecord(bool ok, const char *condition, const char *file, int line) {
+  if (ok) {
+    checkCounters().passed++;
+    return;
+  }
+  checkCounters().failed++;
+  fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+}
+
+/**
+ * @brief Prints the summary of the test program.
+ * @param name Name of the test program.
+ * @return Exit code, 0 if every check held.
+ */
+inline int checkResult(const char *name) {
+  const CheckCounters &counters = checkCounters();
+  fprintf(stderr, "%s: %u checks passed, %u failed\n", name, counters.passed, counters.failed);
+  return counters.failed == 0 ? 0 : 1;
+}
+
+#define HX_CHECK(condition) checkRecord((condition), #condition, __FILE__, __LINE__)  ///< Checks a condition
+
+
+#endif  // CHECK_H
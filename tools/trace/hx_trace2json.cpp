@@ -0,0 +1,128 @@
+/**
+ * @file hx_trace2json.cpp
+ * @brief Command line tool that converts a heatX trace dump to Chrome trace JSON.
+ * @details Reads the output of the `trace` console command from a file or stdin and writes a
+ *          JSON file for Perfetto (ui.perfetto.dev) or `chrome://tracing`. Lines outside a dump,
+ *          e.g. log output, are ignored. Each dump becomes one process and each recording task
+ *          one thread named after the task, so the begin and end of a span are matched within
+ *          the task that recorded them. Dumps of version 1 have no task numbers; their events
+ *          are grouped by core.
+ *
+ *          The 32 bit cycle counters are unwrapped per core and converted to microseconds
+ *          with the CPU frequency from the dump header. The counters of the two cores are not
+ *          synchronized, so both timelines start at zero.
+ *
+ * ### Example Usage
+ * ```sh
+ * hx_trace2json capture.txt > trace.json
+ * ```
+ *
+ * ### Changelog
+ * - **2026-10-19**: Initial version
+ * - **2026-10-19**: One thread per task for dumps of version 2
+ *
+ * @version 0.0.1
+ * @date 2026-10-19
+ * @author Kevin Hinrichs
+ *
+ * @copyright
+ * Copyright (c) 2024 Kevin Hinrichs, Laurens Vaigt.
+ * Licensed under the MIT License. See the
+ * <a href="LICENSE" target="_blank">LICENSE</a> file for details.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Unwrapping state of one core.
+ */
+struct CoreClock {
+  bool started;     ///< True after the first event.
+  uint32_t last;    ///< Last raw counter value.
+  uint64_t cycles;  ///< Unwrapped cycles since the first event.
+};
+
+int main(int argc, char **argv) {
+  FILE *input = stdin;
+  if (argc > 1) {
+    input = fopen(argv[1], "r");
+    if (input == nullptr) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+
+  char line[256];
+  bool inDump = false;
+  unsigned version = 0;
+  unsigned dump = 0;
+  unsigned cpuMhz = 240;
+  CoreClock clocks[2];
+  unsigned long events = 0;
+  bool first = true;
+
+  printf("{\"traceEvents\":[\n");
+  while (fgets(line, sizeof(line), input) != nullptr) {
+    unsigned mhz;
+    if (sscanf(line, "# heatX trace v%u cpu_mhz=%u", &version, &mhz) == 2 && (version == 1 || version == 2)) {
+      inDump = true;
+      dump++;
+      cpuMhz = mhz > 0 ? mhz : 240;
+      memset(clocks, 0, sizeof(clocks));
+      printf("%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"dump %u\"}}",
+             first ? "" : ",\n", dump, dump);
+      first = false;
+      for (unsigned core = 0; version == 1 && core < 2; core++) {
+        printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"core %u\"}}",
+               dump, core, core);
+      }
+      continue;
+    }
+    if (strncmp(line, "# end", 5) == 0) {
+      inDump = false;
+      continue;
+    }
+
+    unsigned task;
+    char name[64];
+    if (inDump && version == 2 && sscanf(line, "# task %u %63s", &task, name) == 2) {
+      printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+             dump, task, name);
+      continue;
+    }
+
+    unsigned core;
+    unsigned cycles;
+    char phase;
+    int fields = version == 2 ? sscanf(line, "T %u %u %u %c %63s", &core, &task, &cycles, &phase, name)
+                              : sscanf(line, "T %u %u %c %63s", &core, &cycles, &phase, name) + 1;
+    if (!inDump || fields != 5 || core > 1 || (phase != 'B' && phase != 'E')) {
+      continue;
+    }
+    if (version == 1) {
+      task = core;
+    }
+
+    // Consecutive events of a core are assumed to be less than one counter wrap apart
+    CoreClock &clock = clocks[core];
+    if (clock.started) {
+      clock.cycles += (uint32_t)(cycles - clock.last);
+    }
+    clock.started = true;
+    clock.last = cycles;
+
+    printf("%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u}",
+           first ? "" : ",\n", name, phase, (double)clock.cycles / cpuMhz, dump, task);
+    first = false;
+    events++;
+  }
+  printf("\n],\"displayTimeUnit\":\"ns\"}\n");
+
+  fprintf(stderr, "%u dumps, %lu events\n", dump, events);
+  if (input != stdin) {
+    fclose(input);
+  }
+  return 0;
+}